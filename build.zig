@@ -41,13 +41,26 @@ pub fn build(b: *std.Build) void {
         .optimize = optimize,
         .name = "con-deserialize",
         .root = "src/deserialize",
-        .sources = &.{ "deserialize.c", "reader.c" },
-        .headers = &.{ "con_deserialize.h", "con_reader.h" },
+        .sources = &.{ "deserialize.c", "reader.c", "index.c", "query.c", "push.c" },
+        .headers = &.{ "con_deserialize.h", "con_reader.h", "con_index.h", "con_query.h", "con_push.h" },
     });
     serialize.linkLibrary(utils);
     deserialize.addIncludePath(gci.path("src/interface"));
     deserialize.installHeader(b.path("src/con_common.h"), "con_common.h");
 
+    const value = buildCLib(b, allocator, .{
+        .target = target,
+        .optimize = optimize,
+        .name = "con-value",
+        .root = "src/value",
+        .sources = &.{"value.c"},
+        .headers = &.{"con_value.h"},
+    });
+    value.linkLibrary(serialize);
+    value.linkLibrary(deserialize);
+    value.addIncludePath(gci.path("src/interface"));
+    value.installHeader(b.path("src/con_common.h"), "con_common.h");
+
     const con = b.addModule("con", .{
         .root_source_file = b.path("src/con.zig"),
         .target = target,
@@ -61,6 +74,7 @@ pub fn build(b: *std.Build) void {
     con.addIncludePath(gci.path("src/implementation"));
     con.linkLibrary(serialize);
     con.linkLibrary(deserialize);
+    con.linkLibrary(value);
 
     const unit_tests = b.addTest(.{
         .root_source_file = b.path("src/con.zig"),
@@ -71,17 +85,44 @@ pub fn build(b: *std.Build) void {
     unit_tests.addIncludePath(b.path("src"));
     unit_tests.addIncludePath(b.path("src/serialize"));
     unit_tests.addIncludePath(b.path("src/deserialize"));
+    unit_tests.addIncludePath(b.path("src/value"));
     unit_tests.addIncludePath(gci.path("src"));
     unit_tests.addIncludePath(gci.path("src/interface"));
     unit_tests.addIncludePath(gci.path("src/implementation"));
     unit_tests.linkLibrary(serialize);
     unit_tests.linkLibrary(deserialize);
+    unit_tests.linkLibrary(value);
     unit_tests.root_module.addImport("gci", gci.module("gci"));
 
     const run_unit_tests = b.addRunArtifact(unit_tests);
 
     const test_step = b.step("test", "Run unit tests");
     test_step.dependOn(&run_unit_tests.step);
+
+    const bench = b.addExecutable(.{
+        .name = "con-bench",
+        .root_source_file = b.path("src/bench.zig"),
+        .target = target,
+        .optimize = optimize,
+        .link_libc = true,
+    });
+    bench.addIncludePath(b.path("src"));
+    bench.addIncludePath(b.path("src/serialize"));
+    bench.addIncludePath(b.path("src/deserialize"));
+    bench.addIncludePath(b.path("src/value"));
+    bench.addIncludePath(gci.path("src"));
+    bench.addIncludePath(gci.path("src/interface"));
+    bench.addIncludePath(gci.path("src/implementation"));
+    bench.linkLibrary(utils);
+    bench.linkLibrary(serialize);
+    bench.linkLibrary(deserialize);
+    bench.linkLibrary(value);
+    bench.root_module.addImport("gci", gci.module("gci"));
+
+    const run_bench = b.addRunArtifact(bench);
+
+    const bench_step = b.step("bench", "Run benchmarks, use with -Doptimize=ReleaseFast");
+    bench_step.dependOn(&run_bench.step);
 }
 
 const CLibConfig = struct {
@@ -106,6 +147,7 @@ fn buildCLib(b: *std.Build, allocator: std.mem.Allocator, config: CLibConfig) *s
     lib.addIncludePath(b.path("src"));
     lib.addIncludePath(b.path("src/serialize"));
     lib.addIncludePath(b.path("src/deserialize"));
+    lib.addIncludePath(b.path("src/value"));
     b.installArtifact(lib);
 
     lib.addCSourceFiles(.{
@@ -0,0 +1,17 @@
+const std = @import("std");
+const serialize = @import("bench/bench_serialize.zig");
+const deserialize = @import("bench/bench_deserialize.zig");
+const value = @import("bench/bench_value.zig");
+const parallel = @import("bench/bench_parallel.zig");
+
+pub fn main() !void {
+    var gpa = std.heap.GeneralPurposeAllocator(.{}){};
+    defer _ = gpa.deinit();
+    const allocator = gpa.allocator();
+
+    const stdout = std.io.getStdOut().writer();
+    try serialize.run(allocator, stdout);
+    try deserialize.run(allocator, stdout);
+    try value.run(allocator, stdout);
+    try parallel.run(allocator, stdout);
+}
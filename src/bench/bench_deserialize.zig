@@ -0,0 +1,832 @@
+const std = @import("std");
+const common = @import("common.zig");
+const lib = @import("../internal.zig").lib;
+const utils = @cImport({
+    @cInclude("utils.h");
+});
+
+const records = 20_000;
+
+// Pretty-printed document where roughly 40% of the bytes are whitespace.
+fn generate(allocator: std.mem.Allocator) ![]u8 {
+    var data = std.ArrayList(u8).init(allocator);
+    errdefer data.deinit();
+
+    const writer = data.writer();
+    try writer.writeAll("[\n");
+    for (0..records) |i| {
+        if (i > 0) {
+            try writer.writeAll(",\n");
+        }
+        try writer.print(
+            \\    {{
+            \\        "id": {d},
+            \\        "name": "record {d}",
+            \\        "active": {s},
+            \\        "parent": null,
+            \\        "values": [
+            \\            {d},
+            \\            -{d}.5,
+            \\            {d}e3
+            \\        ]
+            \\    }}
+        , .{ i, i, if (i % 2 == 0) "true" else "false", i, i, i });
+    }
+    try writer.writeAll("\n]\n");
+
+    return data.toOwnedSlice();
+}
+
+// Newline delimited records, as in log streams.
+fn generateLines(allocator: std.mem.Allocator) ![]u8 {
+    var data = std.ArrayList(u8).init(allocator);
+    errdefer data.deinit();
+
+    const writer = data.writer();
+    for (0..records * 4) |i| {
+        try writer.print(
+            "{{\"id\":{d},\"level\":\"{s}\",\"message\":\"request {d} done\",\"ms\":{d}}}\n",
+            .{ i, if (i % 8 == 0) "warn" else "info", i, i % 97 },
+        );
+    }
+
+    return data.toOwnedSlice();
+}
+
+// Flat array of mixed integers and decimals, as in numeric payloads.
+fn generateNumbers(allocator: std.mem.Allocator) ![]u8 {
+    var data = std.ArrayList(u8).init(allocator);
+    errdefer data.deinit();
+
+    var random = std.Random.DefaultPrng.init(0);
+    const writer = data.writer();
+    try writer.writeAll("[");
+    for (0..records * 8) |i| {
+        if (i > 0) {
+            try writer.writeAll(",");
+        }
+        const value = random.random().float(f64) * 2e6 - 1e6;
+        if (i % 2 == 0) {
+            try writer.print("{d}", .{@as(i64, @intFromFloat(value))});
+        } else {
+            try writer.print("{d}", .{value});
+        }
+    }
+    try writer.writeAll("]");
+
+    return data.toOwnedSlice();
+}
+
+// Containers, keys and literals only, so that the time is mostly spent
+// tracking the state and depth around each token.
+fn generateStructural(allocator: std.mem.Allocator) ![]u8 {
+    var data = std.ArrayList(u8).init(allocator);
+    errdefer data.deinit();
+
+    const writer = data.writer();
+    try writer.writeAll("[");
+    for (0..records * 10) |i| {
+        if (i > 0) {
+            try writer.writeAll(",");
+        }
+        try writer.writeAll("{\"a\":null,\"b\":[true,false]}");
+    }
+    try writer.writeAll("]");
+
+    return data.toOwnedSlice();
+}
+
+fn walk(context: *lib.ConDeserialize) !usize {
+    var scratch: [64]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    var tokens: usize = 0;
+
+    while (true) {
+        var token: lib.ConDeserializeType = undefined;
+        if (lib.con_deserialize_next(context, &token) != lib.CON_ERROR_OK) {
+            return error.Next;
+        }
+
+        _ = lib.gci_writer_string_init(&writer, &scratch, scratch.len);
+        const interface = lib.gci_writer_string_interface(&writer);
+
+        var value: bool = undefined;
+        const err = switch (token) {
+            lib.CON_DESERIALIZE_TYPE_NUMBER => lib.con_deserialize_number(context, interface),
+            lib.CON_DESERIALIZE_TYPE_STRING => lib.con_deserialize_string(context, interface),
+            lib.CON_DESERIALIZE_TYPE_DICT_KEY => lib.con_deserialize_dict_key(context, interface),
+            lib.CON_DESERIALIZE_TYPE_BOOL => lib.con_deserialize_bool(context, &value),
+            lib.CON_DESERIALIZE_TYPE_NULL => lib.con_deserialize_null(context),
+            lib.CON_DESERIALIZE_TYPE_ARRAY_OPEN => lib.con_deserialize_array_open(context),
+            lib.CON_DESERIALIZE_TYPE_ARRAY_CLOSE => lib.con_deserialize_array_close(context),
+            lib.CON_DESERIALIZE_TYPE_DICT_OPEN => lib.con_deserialize_dict_open(context),
+            lib.CON_DESERIALIZE_TYPE_DICT_CLOSE => lib.con_deserialize_dict_close(context),
+            else => return error.Unknown,
+        };
+        if (err != lib.CON_ERROR_OK) {
+            return error.Token;
+        }
+
+        tokens += 1;
+        if (context.depth == 0) {
+            return tokens;
+        }
+    }
+}
+
+fn parseSingle(data: []const u8) !usize {
+    var reader: lib.GciReaderString = undefined;
+    _ = lib.gci_reader_string_init(&reader, data.ptr, data.len);
+
+    var depth: [8]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const err = lib.con_deserialize_init(
+        &context,
+        lib.gci_reader_string_interface(&reader),
+        &depth,
+        depth.len,
+    );
+    if (err != lib.CON_ERROR_OK) {
+        return error.Init;
+    }
+
+    return walk(&context);
+}
+
+fn parseStructural(data: []const u8) !usize {
+    var depth: [3]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    try initMemory(&context, &depth, data);
+    return walk(&context);
+}
+
+fn parseBuffer(data: []const u8) !usize {
+    var reader: lib.GciReaderString = undefined;
+    _ = lib.gci_reader_string_init(&reader, data.ptr, data.len);
+
+    var depth: [8]lib.ConContainer = undefined;
+    var read_buffer: [64 * 1024]u8 = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const err = lib.con_deserialize_init_buffer(
+        &context,
+        lib.gci_reader_string_interface(&reader),
+        &depth,
+        depth.len,
+        &read_buffer,
+        read_buffer.len,
+    );
+    if (err != lib.CON_ERROR_OK) {
+        return error.Init;
+    }
+
+    return walk(&context);
+}
+
+// Reads the document from `chunk` byte chunks as a socket would deliver it.
+fn parsePush(data: []const u8, chunk: usize) !usize {
+    var scratch: [64]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    _ = lib.gci_writer_string_init(&writer, &scratch, scratch.len);
+
+    var depth: [8]lib.ConContainer = undefined;
+    var context: lib.ConPush = undefined;
+    const err = lib.con_push_init(
+        &context,
+        lib.gci_writer_string_interface(&writer),
+        &depth,
+        depth.len,
+    );
+    if (err != lib.CON_ERROR_OK) {
+        return error.Init;
+    }
+
+    var tokens: usize = 0;
+    var position: usize = 0;
+    while (true) {
+        var token: lib.ConDeserializeType = undefined;
+        switch (lib.con_push_next(&context, &token)) {
+            lib.CON_ERROR_OK => {},
+            lib.CON_ERROR_COMPLETE => return tokens,
+            lib.CON_ERROR_NEED_INPUT => {
+                if (position == data.len) {
+                    _ = lib.con_push_finish(&context);
+                    continue;
+                }
+
+                const end = @min(position + chunk, data.len);
+                if (lib.con_push_feed(&context, data.ptr + position, end - position) != lib.CON_ERROR_OK) {
+                    return error.Feed;
+                }
+                position = end;
+                continue;
+            },
+            else => return error.Next,
+        }
+
+        _ = lib.gci_writer_string_init(&writer, &scratch, scratch.len);
+        tokens += 1;
+    }
+}
+
+fn fileRead(context: ?*const anyopaque, buffer: [*c]u8, buffer_size: usize) callconv(.C) usize {
+    const file: *const std.fs.File = @ptrCast(@alignCast(context.?));
+    return file.read(buffer[0..buffer_size]) catch 0;
+}
+
+fn parseFile(dir: std.fs.Dir, name: []const u8) !usize {
+    const file = try dir.openFile(name, .{});
+    defer file.close();
+
+    var depth: [8]lib.ConContainer = undefined;
+    var read_buffer: [64 * 1024]u8 = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const err = lib.con_deserialize_init_buffer(
+        &context,
+        .{ .context = &file, .read = fileRead },
+        &depth,
+        depth.len,
+        &read_buffer,
+        read_buffer.len,
+    );
+    if (err != lib.CON_ERROR_OK) {
+        return error.Init;
+    }
+
+    return walk(&context);
+}
+
+fn parseMap(dir: std.fs.Dir, name: []const u8) !usize {
+    var map: lib.ConReaderMap = undefined;
+    {
+        const file = try dir.openFile(name, .{});
+        defer file.close();
+
+        if (lib.con_reader_map_init(&map, file.handle) != lib.CON_ERROR_OK) {
+            return error.Map;
+        }
+    }
+    defer _ = lib.con_reader_map_deinit(&map);
+
+    var depth: [8]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const err = lib.con_deserialize_init(&context, lib.con_reader_map_interface(&map), &depth, depth.len);
+    if (err != lib.CON_ERROR_OK) {
+        return error.Init;
+    }
+
+    return walk(&context);
+}
+
+// Initializes a new context for every line, as needed without
+// `con_deserialize_record`.
+fn linesInit(data: []const u8) !usize {
+    var tokens: usize = 0;
+    var lines = std.mem.splitScalar(u8, data, '\n');
+    while (lines.next()) |line| {
+        if (line.len == 0) {
+            continue;
+        }
+
+        var depth: [8]lib.ConContainer = undefined;
+        var context: lib.ConDeserialize = undefined;
+        if (lib.con_deserialize_init_memory(&context, line.ptr, line.len, &depth, depth.len) != lib.CON_ERROR_OK) {
+            return error.Init;
+        }
+        tokens += try walk(&context);
+    }
+    return tokens;
+}
+
+fn linesRecord(data: []const u8) !usize {
+    var depth: [8]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    if (lib.con_deserialize_init_memory(&context, data.ptr, data.len, &depth, depth.len) != lib.CON_ERROR_OK) {
+        return error.Init;
+    }
+
+    var tokens: usize = 0;
+    while (true) {
+        var found: bool = undefined;
+        if (lib.con_deserialize_record(&context, &found) != lib.CON_ERROR_OK) {
+            return error.Record;
+        }
+        if (!found) {
+            return tokens;
+        }
+        tokens += try walk(&context);
+    }
+}
+
+fn initMemory(context: *lib.ConDeserialize, depth: []lib.ConContainer, data: []const u8) !void {
+    const err = lib.con_deserialize_init_memory(context, data.ptr, data.len, depth.ptr, @intCast(depth.len));
+    if (err != lib.CON_ERROR_OK or lib.con_deserialize_array_open(context) != lib.CON_ERROR_OK) {
+        return error.Init;
+    }
+}
+
+fn numbersText(data: []const u8) !f64 {
+    var depth: [1]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    try initMemory(&context, &depth, data);
+
+    var scratch: [64]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    var sum: f64 = 0;
+    while (context.depth > 0) {
+        var token: lib.ConDeserializeType = undefined;
+        if (lib.con_deserialize_next(&context, &token) != lib.CON_ERROR_OK) {
+            return error.Next;
+        }
+        if (token == lib.CON_DESERIALIZE_TYPE_ARRAY_CLOSE) {
+            _ = lib.con_deserialize_array_close(&context);
+            break;
+        }
+
+        _ = lib.gci_writer_string_init(&writer, &scratch, scratch.len);
+        if (lib.con_deserialize_number(&context, lib.gci_writer_string_interface(&writer)) != lib.CON_ERROR_OK) {
+            return error.Token;
+        }
+        sum += try std.fmt.parseFloat(f64, scratch[0..writer.current]);
+    }
+    return sum;
+}
+
+fn numbersDouble(data: []const u8) !f64 {
+    var depth: [1]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    try initMemory(&context, &depth, data);
+
+    var sum: f64 = 0;
+    while (context.depth > 0) {
+        var token: lib.ConDeserializeType = undefined;
+        if (lib.con_deserialize_next(&context, &token) != lib.CON_ERROR_OK) {
+            return error.Next;
+        }
+        if (token == lib.CON_DESERIALIZE_TYPE_ARRAY_CLOSE) {
+            _ = lib.con_deserialize_array_close(&context);
+            break;
+        }
+
+        var value: f64 = undefined;
+        if (lib.con_deserialize_double(&context, &value) != lib.CON_ERROR_OK) {
+            return error.Token;
+        }
+        sum += value;
+    }
+    return sum;
+}
+
+// Consumes the next value token by token, as done without `con_deserialize_skip`.
+fn consumeValue(context: *lib.ConDeserialize) !void {
+    var scratch: [64]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    var nested: usize = 0;
+
+    while (true) {
+        var token: lib.ConDeserializeType = undefined;
+        if (lib.con_deserialize_next(context, &token) != lib.CON_ERROR_OK) {
+            return error.Next;
+        }
+
+        _ = lib.gci_writer_string_init(&writer, &scratch, scratch.len);
+        const interface = lib.gci_writer_string_interface(&writer);
+
+        var value: bool = undefined;
+        const err = switch (token) {
+            lib.CON_DESERIALIZE_TYPE_NUMBER => lib.con_deserialize_number(context, interface),
+            lib.CON_DESERIALIZE_TYPE_STRING => lib.con_deserialize_string(context, interface),
+            lib.CON_DESERIALIZE_TYPE_DICT_KEY => lib.con_deserialize_dict_key(context, interface),
+            lib.CON_DESERIALIZE_TYPE_BOOL => lib.con_deserialize_bool(context, &value),
+            lib.CON_DESERIALIZE_TYPE_NULL => lib.con_deserialize_null(context),
+            lib.CON_DESERIALIZE_TYPE_ARRAY_OPEN => lib.con_deserialize_array_open(context),
+            lib.CON_DESERIALIZE_TYPE_ARRAY_CLOSE => lib.con_deserialize_array_close(context),
+            lib.CON_DESERIALIZE_TYPE_DICT_OPEN => lib.con_deserialize_dict_open(context),
+            lib.CON_DESERIALIZE_TYPE_DICT_CLOSE => lib.con_deserialize_dict_close(context),
+            else => return error.Unknown,
+        };
+        if (err != lib.CON_ERROR_OK) {
+            return error.Token;
+        }
+
+        switch (token) {
+            lib.CON_DESERIALIZE_TYPE_ARRAY_OPEN, lib.CON_DESERIALIZE_TYPE_DICT_OPEN => nested += 1,
+            lib.CON_DESERIALIZE_TYPE_ARRAY_CLOSE, lib.CON_DESERIALIZE_TYPE_DICT_CLOSE => nested -= 1,
+            lib.CON_DESERIALIZE_TYPE_DICT_KEY => continue,
+            else => {},
+        }
+        if (nested == 0) {
+            return;
+        }
+    }
+}
+
+// Sums the `id` field of every record and discards the other fields.
+fn select(data: []const u8, comptime skip: bool) !u64 {
+    var depth: [8]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    try initMemory(&context, &depth, data);
+
+    var scratch: [0]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    _ = lib.gci_writer_string_init(&writer, &scratch, scratch.len);
+    const interface = lib.gci_writer_string_interface(&writer);
+
+    var sum: u64 = 0;
+    while (true) {
+        var token: lib.ConDeserializeType = undefined;
+        if (lib.con_deserialize_next(&context, &token) != lib.CON_ERROR_OK) {
+            return error.Next;
+        }
+        if (token == lib.CON_DESERIALIZE_TYPE_ARRAY_CLOSE) {
+            _ = lib.con_deserialize_array_close(&context);
+            return sum;
+        }
+
+        if (lib.con_deserialize_dict_open(&context) != lib.CON_ERROR_OK) {
+            return error.Token;
+        }
+        while (true) {
+            if (lib.con_deserialize_next(&context, &token) != lib.CON_ERROR_OK) {
+                return error.Next;
+            }
+            if (token == lib.CON_DESERIALIZE_TYPE_DICT_CLOSE) {
+                _ = lib.con_deserialize_dict_close(&context);
+                break;
+            }
+
+            var key: [*c]const u8 = undefined;
+            var key_size: usize = undefined;
+            if (lib.con_deserialize_dict_key_view(&context, &key, &key_size, interface) != lib.CON_ERROR_OK) {
+                return error.Token;
+            }
+
+            if (std.mem.eql(u8, key[0..key_size], "id")) {
+                var value: u64 = undefined;
+                if (lib.con_deserialize_uint64(&context, &value) != lib.CON_ERROR_OK) {
+                    return error.Token;
+                }
+                sum += value;
+            } else if (skip) {
+                if (lib.con_deserialize_skip(&context) != lib.CON_ERROR_OK) {
+                    return error.Token;
+                }
+            } else {
+                try consumeValue(&context);
+            }
+        }
+    }
+}
+
+fn selectWalk(data: []const u8) !u64 {
+    return select(data, false);
+}
+
+fn selectSkip(data: []const u8) !u64 {
+    return select(data, true);
+}
+
+fn selectQuery(data: []const u8) !u64 {
+    var depth: [8]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    if (lib.con_deserialize_init_memory(&context, data.ptr, data.len, &depth, depth.len) != lib.CON_ERROR_OK) {
+        return error.Init;
+    }
+
+    const pointer = "/*/id";
+    var segments: [2]lib.ConQuerySegment = undefined;
+    var query: lib.ConQuery = undefined;
+    if (lib.con_query_init(&query, pointer, pointer.len, &segments, segments.len) != lib.CON_ERROR_OK) {
+        return error.Init;
+    }
+
+    var sum: u64 = 0;
+    while (true) {
+        var found: bool = undefined;
+        if (lib.con_query_next(&query, &context, &found) != lib.CON_ERROR_OK) {
+            return error.Query;
+        }
+        if (!found) {
+            return sum;
+        }
+
+        var value: u64 = undefined;
+        if (lib.con_deserialize_uint64(&context, &value) != lib.CON_ERROR_OK) {
+            return error.Token;
+        }
+        sum += value;
+    }
+}
+
+const fields = [_][*c]const u8{ "id", "name", "active", "parent", "values" };
+
+// Identifies each key by copying it and comparing it to every field in turn.
+fn dispatchCompare(data: []const u8) !u64 {
+    var depth: [8]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    try initMemory(&context, &depth, data);
+
+    var sum: u64 = 0;
+    while (true) {
+        var token: lib.ConDeserializeType = undefined;
+        if (lib.con_deserialize_next(&context, &token) != lib.CON_ERROR_OK) {
+            return error.Next;
+        }
+        if (token == lib.CON_DESERIALIZE_TYPE_ARRAY_CLOSE) {
+            _ = lib.con_deserialize_array_close(&context);
+            return sum;
+        }
+
+        if (lib.con_deserialize_dict_open(&context) != lib.CON_ERROR_OK) {
+            return error.Token;
+        }
+        while (true) {
+            if (lib.con_deserialize_next(&context, &token) != lib.CON_ERROR_OK) {
+                return error.Next;
+            }
+            if (token == lib.CON_DESERIALIZE_TYPE_DICT_CLOSE) {
+                _ = lib.con_deserialize_dict_close(&context);
+                break;
+            }
+
+            var scratch: [16]u8 = undefined;
+            var writer: lib.GciWriterString = undefined;
+            _ = lib.gci_writer_string_init(&writer, &scratch, scratch.len);
+            if (lib.con_deserialize_dict_key(&context, lib.gci_writer_string_interface(&writer)) != lib.CON_ERROR_OK) {
+                return error.Token;
+            }
+
+            var index: usize = fields.len;
+            for (fields, 0..) |field, i| {
+                if (std.mem.eql(u8, scratch[0..writer.current], std.mem.span(field))) {
+                    index = i;
+                    break;
+                }
+            }
+
+            if (index == 0) {
+                var value: u64 = undefined;
+                if (lib.con_deserialize_uint64(&context, &value) != lib.CON_ERROR_OK) {
+                    return error.Token;
+                }
+                sum += value;
+            } else if (lib.con_deserialize_skip(&context) != lib.CON_ERROR_OK) {
+                return error.Token;
+            }
+        }
+    }
+}
+
+fn dispatchMatch(data: []const u8, keys: *const lib.ConDeserializeKeys) !u64 {
+    var depth: [8]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    try initMemory(&context, &depth, data);
+
+    var sum: u64 = 0;
+    while (true) {
+        var token: lib.ConDeserializeType = undefined;
+        if (lib.con_deserialize_next(&context, &token) != lib.CON_ERROR_OK) {
+            return error.Next;
+        }
+        if (token == lib.CON_DESERIALIZE_TYPE_ARRAY_CLOSE) {
+            _ = lib.con_deserialize_array_close(&context);
+            return sum;
+        }
+
+        if (lib.con_deserialize_dict_open(&context) != lib.CON_ERROR_OK) {
+            return error.Token;
+        }
+        while (true) {
+            if (lib.con_deserialize_next(&context, &token) != lib.CON_ERROR_OK) {
+                return error.Next;
+            }
+            if (token == lib.CON_DESERIALIZE_TYPE_DICT_CLOSE) {
+                _ = lib.con_deserialize_dict_close(&context);
+                break;
+            }
+
+            var index: usize = undefined;
+            if (lib.con_deserialize_dict_key_match(&context, keys, &index) != lib.CON_ERROR_OK) {
+                return error.Token;
+            }
+
+            if (index == 0) {
+                var value: u64 = undefined;
+                if (lib.con_deserialize_uint64(&context, &value) != lib.CON_ERROR_OK) {
+                    return error.Token;
+                }
+                sum += value;
+            } else if (index != std.math.maxInt(usize)) {
+                if (lib.con_deserialize_skip(&context) != lib.CON_ERROR_OK) {
+                    return error.Token;
+                }
+            }
+        }
+    }
+}
+
+const queries = 200;
+
+// Reads the `id` of the record at `position` by skipping the records before it.
+fn lookupStream(data: []const u8) !u64 {
+    var sum: u64 = 0;
+    for (0..queries) |query| {
+        const position = query * (records / queries);
+
+        var depth: [8]lib.ConContainer = undefined;
+        var context: lib.ConDeserialize = undefined;
+        try initMemory(&context, &depth, data);
+        for (0..position) |_| {
+            if (lib.con_deserialize_skip(&context) != lib.CON_ERROR_OK) {
+                return error.Token;
+            }
+        }
+
+        if (lib.con_deserialize_dict_open(&context) != lib.CON_ERROR_OK) {
+            return error.Token;
+        }
+        var key: [*c]const u8 = undefined;
+        var key_size: usize = undefined;
+        var scratch: [0]u8 = undefined;
+        var writer: lib.GciWriterString = undefined;
+        _ = lib.gci_writer_string_init(&writer, &scratch, scratch.len);
+        if (lib.con_deserialize_dict_key_view(&context, &key, &key_size, lib.gci_writer_string_interface(&writer)) != lib.CON_ERROR_OK) {
+            return error.Token;
+        }
+        if (!std.mem.eql(u8, key[0..key_size], "id")) {
+            return error.Key;
+        }
+
+        var value: u64 = undefined;
+        if (lib.con_deserialize_uint64(&context, &value) != lib.CON_ERROR_OK) {
+            return error.Token;
+        }
+        sum += value;
+    }
+    return sum;
+}
+
+fn indexBuild(index: *lib.ConIndex, data: []const u8, tape: []lib.ConIndexEntry) !usize {
+    var depth: [8]usize = undefined;
+    if (lib.con_index_init(index, data.ptr, data.len, tape.ptr, tape.len, &depth, depth.len) != lib.CON_ERROR_OK) {
+        return error.Index;
+    }
+    return index.tape_length;
+}
+
+// Reads the `id` of the record at `position` through an index built once.
+fn lookupIndex(index: *const lib.ConIndex) !u64 {
+    var sum: u64 = 0;
+    for (0..queries) |query| {
+        const position = query * (records / queries);
+
+        var record: usize = undefined;
+        if (lib.con_index_array_get(index, 0, position, &record) != lib.CON_ERROR_OK) {
+            return error.Index;
+        }
+        var entry: usize = undefined;
+        if (lib.con_index_dict_get(index, record, "id", 2, &entry) != lib.CON_ERROR_OK) {
+            return error.Index;
+        }
+
+        var depth: [1]lib.ConContainer = undefined;
+        var context: lib.ConDeserialize = undefined;
+        if (lib.con_index_deserialize(index, entry, &context, &depth, depth.len) != lib.CON_ERROR_OK) {
+            return error.Index;
+        }
+
+        var value: u64 = undefined;
+        if (lib.con_deserialize_uint64(&context, &value) != lib.CON_ERROR_OK) {
+            return error.Token;
+        }
+        sum += value;
+    }
+    return sum;
+}
+
+fn skipScalar(data: []const u8) !usize {
+    var skipped: usize = 0;
+    var index: usize = 0;
+    while (index < data.len) {
+        const start = index;
+        while (index < data.len and std.ascii.isWhitespace(data[index])) {
+            index += 1;
+        }
+        skipped += index - start;
+        index += 1;
+    }
+    return skipped;
+}
+
+fn skipVector(data: []const u8) !usize {
+    var skipped: usize = 0;
+    var index: usize = 0;
+    while (index < data.len) {
+        const length = utils.con_utils_whitespace_skip(data.ptr + index, data.len - index);
+        skipped += length;
+        index += length + 1;
+    }
+    return skipped;
+}
+
+pub fn run(allocator: std.mem.Allocator, out: anytype) !void {
+    const data = try generate(allocator);
+    defer allocator.free(data);
+
+    try out.print("deserialize: {d} bytes of pretty-printed JSON\n", .{data.len});
+
+    const single = try common.measure(parseSingle, .{data});
+    try common.report(out, "  per-byte reads (con_deserialize_init)", data.len, single);
+
+    const buffer = try common.measure(parseBuffer, .{data});
+    try common.report(out, "  buffered reads (con_deserialize_init_buffer)", data.len, buffer);
+
+    const mtu = try common.measure(parsePush, .{ data, 1500 });
+    try common.report(out, "  con_push, 1500 byte chunks", data.len, mtu);
+
+    const large = try common.measure(parsePush, .{ data, 64 * 1024 });
+    try common.report(out, "  con_push, 64 KiB chunks", data.len, large);
+
+    const name = "con-bench-deserialize.json";
+    const dir = std.fs.cwd();
+    try dir.writeFile(.{ .sub_path = name, .data = data });
+    defer dir.deleteFile(name) catch {};
+
+    const file = try common.measure(parseFile, .{ dir, name });
+    try common.report(out, "  file, read() into con_deserialize_init_buffer", data.len, file);
+
+    const map = try common.measure(parseMap, .{ dir, name });
+    try common.report(out, "  file, con_reader_map_init", data.len, map);
+
+    const scalar = try common.measure(skipScalar, .{data});
+    try common.report(out, "  whitespace skip, scalar", data.len, scalar);
+
+    const vector = try common.measure(skipVector, .{data});
+    try common.report(out, "  whitespace skip, con_utils_whitespace_skip", data.len, vector);
+
+    const walked = try common.measure(selectWalk, .{data});
+    try common.report(out, "  select `id`, typed calls for other fields", data.len, walked);
+
+    const skipped = try common.measure(selectSkip, .{data});
+    try common.report(out, "  select `id`, con_deserialize_skip for other fields", data.len, skipped);
+
+    const queried = try common.measure(selectQuery, .{data});
+    try common.report(out, "  select `id`, con_query `/*/id`", data.len, queried);
+
+    var order: [fields.len]usize = undefined;
+    var keys: lib.ConDeserializeKeys = undefined;
+    if (lib.con_deserialize_keys_init(&keys, &fields, &order, fields.len) != lib.CON_ERROR_OK) {
+        return error.Init;
+    }
+
+    const compared = try common.measure(dispatchCompare, .{data});
+    try common.report(out, "  dispatch keys, copy and compare", data.len, compared);
+
+    const matched = try common.measure(dispatchMatch, .{ data, &keys });
+    try common.report(out, "  dispatch keys, con_deserialize_dict_key_match", data.len, matched);
+
+    const tape = try allocator.alloc(lib.ConIndexEntry, records * 32);
+    defer allocator.free(tape);
+
+    var index: lib.ConIndex = undefined;
+    const built = try common.measure(indexBuild, .{ &index, data, tape });
+    try common.report(out, "  con_index_init", data.len, built);
+
+    try out.print("deserialize: {d} lookups by position\n", .{queries});
+
+    const streamed = try common.measure(lookupStream, .{data});
+    try common.report(out, "  con_deserialize_skip to each record", data.len, streamed);
+
+    const indexed = try common.measure(lookupIndex, .{&index});
+    try common.report(out, "  con_index_array_get + con_index_dict_get", data.len, indexed);
+
+    const lines = try generateLines(allocator);
+    defer allocator.free(lines);
+
+    try out.print("deserialize: {d} bytes of newline delimited JSON\n", .{lines.len});
+
+    const reinit = try common.measure(linesInit, .{lines});
+    try common.report(out, "  split lines, con_deserialize_init_memory per line", lines.len, reinit);
+
+    const record = try common.measure(linesRecord, .{lines});
+    try common.report(out, "  con_deserialize_record", lines.len, record);
+
+    const structural = try generateStructural(allocator);
+    defer allocator.free(structural);
+
+    const tokens = try parseStructural(structural);
+    try out.print("deserialize: {d} containers, keys and literals\n", .{tokens});
+
+    const structural_time = try common.measure(parseStructural, .{structural});
+    try common.reportTokens(out, "  per token", tokens, structural_time);
+
+    const numbers = try generateNumbers(allocator);
+    defer allocator.free(numbers);
+
+    try out.print("deserialize: {d} bytes of numbers\n", .{numbers.len});
+
+    const text = try common.measure(numbersText, .{numbers});
+    try common.report(out, "  con_deserialize_number + parseFloat", numbers.len, text);
+
+    const double = try common.measure(numbersDouble, .{numbers});
+    try common.report(out, "  con_deserialize_double", numbers.len, double);
+}
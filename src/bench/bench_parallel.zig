@@ -0,0 +1,73 @@
+const std = @import("std");
+const common = @import("common.zig");
+const parallel = @import("../deserialize/parallel.zig");
+const Deserialize = @import("../deserialize/deserialize.zig").Deserialize;
+
+const records = 400_000;
+
+// Chunks per thread, more than one lets idle threads take over remaining work.
+const chunks_per_thread = 8;
+
+fn generate(allocator: std.mem.Allocator) ![]u8 {
+    var data = std.ArrayList(u8).init(allocator);
+    errdefer data.deinit();
+
+    const writer = data.writer();
+    for (0..records) |i| {
+        try writer.print(
+            "{{\"id\":{d},\"level\":\"{s}\",\"message\":\"request {d} done\",\"ms\":{d}.5,\"tags\":[\"a\",\"b\"]}}\n",
+            .{ i, if (i % 8 == 0) "warn" else "info", i, i % 97 },
+        );
+    }
+
+    return data.toOwnedSlice();
+}
+
+const Counts = struct {
+    counts: []u64,
+
+    fn count(self: *const Counts, chunk: usize, deserialize: *Deserialize) anyerror!void {
+        try deserialize.skip();
+        self.counts[chunk] += 1;
+    }
+};
+
+fn deserializeLines(pool: *std.Thread.Pool, data: []const u8, counts: []u64) !u64 {
+    @memset(counts, 0);
+    const context = Counts{ .counts = counts };
+    try parallel.deserializeLines(std.heap.page_allocator, pool, data, counts.len, 8, &context, Counts.count);
+
+    var total: u64 = 0;
+    for (counts) |c| {
+        total += c;
+    }
+    if (total != records) {
+        return error.Count;
+    }
+    return total;
+}
+
+pub fn run(allocator: std.mem.Allocator, out: anytype) !void {
+    const data = try generate(allocator);
+    defer allocator.free(data);
+
+    try out.print("parallel: {d} bytes of newline delimited JSON\n", .{data.len});
+
+    const cpus = std.Thread.getCpuCount() catch 1;
+    // Powers of two, followed by all cpus if their count is not a power of two.
+    var threads: usize = 1;
+    while (threads <= cpus) : (threads = if (threads < cpus and threads * 2 > cpus) cpus else threads * 2) {
+        var pool: std.Thread.Pool = undefined;
+        try pool.init(.{ .allocator = allocator, .n_jobs = @intCast(threads) });
+        defer pool.deinit();
+
+        const counts = try allocator.alloc(u64, threads * chunks_per_thread);
+        defer allocator.free(counts);
+
+        var name_buffer: [64]u8 = undefined;
+        const name = try std.fmt.bufPrint(&name_buffer, "  deserializeLines, {d} pool threads", .{threads});
+
+        const ns = try common.measure(deserializeLines, .{ &pool, data, counts });
+        try common.report(out, name, data.len, ns);
+    }
+}
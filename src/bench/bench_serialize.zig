@@ -0,0 +1,285 @@
+const std = @import("std");
+const common = @import("common.zig");
+const lib = @import("../internal.zig").lib;
+
+const count = 200_000;
+
+fn begin(context: *lib.ConSerialize, writer: *lib.GciWriterString, depth: []lib.ConContainer, output: []u8) !void {
+    _ = lib.gci_writer_string_init(writer, output.ptr, output.len);
+    const err = lib.con_serialize_init(context, lib.gci_writer_string_interface(writer), depth.ptr, @intCast(depth.len));
+    if (err != lib.CON_ERROR_OK or lib.con_serialize_array_open(context) != lib.CON_ERROR_OK) {
+        return error.Init;
+    }
+}
+
+fn end(context: *lib.ConSerialize, writer: *lib.GciWriterString) !usize {
+    if (lib.con_serialize_array_close(context) != lib.CON_ERROR_OK) {
+        return error.Close;
+    }
+    return writer.current;
+}
+
+fn intsText(values: []const i64, output: []u8) !usize {
+    var depth: [1]lib.ConContainer = undefined;
+    var writer: lib.GciWriterString = undefined;
+    var context: lib.ConSerialize = undefined;
+    try begin(&context, &writer, &depth, output);
+
+    var scratch: [32]u8 = undefined;
+    for (values) |value| {
+        const text = try std.fmt.bufPrint(&scratch, "{d}", .{value});
+        if (lib.con_serialize_number(&context, text.ptr, text.len) != lib.CON_ERROR_OK) {
+            return error.Number;
+        }
+    }
+    return end(&context, &writer);
+}
+
+fn intsDirect(values: []const i64, output: []u8) !usize {
+    var depth: [1]lib.ConContainer = undefined;
+    var writer: lib.GciWriterString = undefined;
+    var context: lib.ConSerialize = undefined;
+    try begin(&context, &writer, &depth, output);
+
+    for (values) |value| {
+        if (lib.con_serialize_int64(&context, value) != lib.CON_ERROR_OK) {
+            return error.Number;
+        }
+    }
+    return end(&context, &writer);
+}
+
+fn doublesText(values: []const f64, output: []u8) !usize {
+    var depth: [1]lib.ConContainer = undefined;
+    var writer: lib.GciWriterString = undefined;
+    var context: lib.ConSerialize = undefined;
+    try begin(&context, &writer, &depth, output);
+
+    var scratch: [32]u8 = undefined;
+    for (values) |value| {
+        const text = try std.fmt.bufPrint(&scratch, "{e}", .{value});
+        if (lib.con_serialize_number(&context, text.ptr, text.len) != lib.CON_ERROR_OK) {
+            return error.Number;
+        }
+    }
+    return end(&context, &writer);
+}
+
+fn doublesDirect(values: []const f64, output: []u8) !usize {
+    var depth: [1]lib.ConContainer = undefined;
+    var writer: lib.GciWriterString = undefined;
+    var context: lib.ConSerialize = undefined;
+    try begin(&context, &writer, &depth, output);
+
+    for (values) |value| {
+        if (lib.con_serialize_double(&context, value) != lib.CON_ERROR_OK) {
+            return error.Number;
+        }
+    }
+    return end(&context, &writer);
+}
+
+// Containers, keys and literals only, so that the time is mostly spent
+// tracking the state and depth around each token. Returns the amount of tokens.
+fn structural(output: []u8) !usize {
+    var depth: [3]lib.ConContainer = undefined;
+    var writer: lib.GciWriterString = undefined;
+    var context: lib.ConSerialize = undefined;
+    try begin(&context, &writer, &depth, output);
+
+    for (0..count) |_| {
+        const errors = [_]lib.ConError{
+            lib.con_serialize_dict_open(&context),
+            lib.con_serialize_dict_key(&context, "a", 1),
+            lib.con_serialize_null(&context),
+            lib.con_serialize_dict_key(&context, "b", 1),
+            lib.con_serialize_array_open(&context),
+            lib.con_serialize_bool(&context, true),
+            lib.con_serialize_bool(&context, false),
+            lib.con_serialize_array_close(&context),
+            lib.con_serialize_dict_close(&context),
+        };
+        for (errors) |err| {
+            if (err != lib.CON_ERROR_OK) {
+                return error.Token;
+            }
+        }
+    }
+    _ = try end(&context, &writer);
+    return 2 + 9 * count;
+}
+
+// Strings as a caller without an escaping serializer would prepare them: one
+// pass into a second buffer, then con_serialize_string validates it again.
+fn escapeScalar(str: []const u8, out: []u8) []const u8 {
+    const hex = "0123456789abcdef";
+    var length: usize = 0;
+    for (str) |c| {
+        switch (c) {
+            '"', '\\' => {
+                out[length] = '\\';
+                out[length + 1] = c;
+                length += 2;
+            },
+            '\n' => {
+                @memcpy(out[length .. length + 2], "\\n");
+                length += 2;
+            },
+            '\t' => {
+                @memcpy(out[length .. length + 2], "\\t");
+                length += 2;
+            },
+            0...8, 11...31 => {
+                @memcpy(out[length .. length + 4], "\\u00");
+                out[length + 4] = hex[c >> 4];
+                out[length + 5] = hex[c & 0xF];
+                length += 6;
+            },
+            else => {
+                out[length] = c;
+                length += 1;
+            },
+        }
+    }
+    return out[0..length];
+}
+
+fn stringsPrepared(strings: []const []const u8, output: []u8) !usize {
+    var depth: [1]lib.ConContainer = undefined;
+    var writer: lib.GciWriterString = undefined;
+    var context: lib.ConSerialize = undefined;
+    try begin(&context, &writer, &depth, output);
+
+    var scratch: [6 * 256]u8 = undefined;
+    for (strings) |str| {
+        const escaped = escapeScalar(str, &scratch);
+        if (lib.con_serialize_string(&context, escaped.ptr, escaped.len) != lib.CON_ERROR_OK) {
+            return error.String;
+        }
+    }
+    return end(&context, &writer);
+}
+
+fn stringsEscape(strings: []const []const u8, output: []u8) !usize {
+    var depth: [1]lib.ConContainer = undefined;
+    var writer: lib.GciWriterString = undefined;
+    var context: lib.ConSerialize = undefined;
+    try begin(&context, &writer, &depth, output);
+
+    for (strings) |str| {
+        if (lib.con_serialize_string_escape(&context, str.ptr, str.len) != lib.CON_ERROR_OK) {
+            return error.String;
+        }
+    }
+    return end(&context, &writer);
+}
+
+fn checkStrings(strings: []const []const u8) !usize {
+    var valid: usize = 0;
+    for (strings) |str| {
+        var first_error: usize = undefined;
+        if (lib.con_serialize_check_string(str.ptr, str.len, &first_error) == lib.CON_ERROR_OK) {
+            valid += 1;
+        }
+    }
+    return valid;
+}
+
+// Strings of up to 256 bytes where roughly one byte in `escape_every` needs
+// escaping.
+fn generateStrings(allocator: std.mem.Allocator, random: std.Random, escape_every: u32) ![][]u8 {
+    const specials = "\"\\\n\t\x01";
+    const strings = try allocator.alloc([]u8, count / 10);
+    for (strings) |*str| {
+        str.* = try allocator.alloc(u8, random.intRangeAtMost(usize, 16, 256));
+        for (str.*) |*c| {
+            if (random.uintLessThan(u32, escape_every) == 0) {
+                c.* = specials[random.uintLessThan(usize, specials.len)];
+            } else {
+                c.* = random.intRangeAtMost(u8, ' ', '~');
+                if (c.* == '"' or c.* == '\\') {
+                    c.* = ' ';
+                }
+            }
+        }
+    }
+    return strings;
+}
+
+fn freeStrings(allocator: std.mem.Allocator, strings: [][]u8) void {
+    for (strings) |str| {
+        allocator.free(str);
+    }
+    allocator.free(strings);
+}
+
+pub fn run(allocator: std.mem.Allocator, out: anytype) !void {
+    var random = std.Random.DefaultPrng.init(0);
+
+    const ints = try allocator.alloc(i64, count);
+    defer allocator.free(ints);
+    for (ints) |*value| {
+        value.* = random.random().int(i64) >> random.random().int(u6);
+    }
+
+    const doubles = try allocator.alloc(f64, count);
+    defer allocator.free(doubles);
+    for (doubles) |*value| {
+        value.* = (random.random().float(f64) - 0.5) * std.math.pow(f64, 10, @floatFromInt(random.random().intRangeAtMost(i32, -20, 20)));
+    }
+
+    const output = try allocator.alloc(u8, count * 32);
+    defer allocator.free(output);
+
+    try out.print("serialize: {d} integers\n", .{count});
+
+    const ints_size = try intsDirect(ints, output);
+    const ints_text = try common.measure(intsText, .{ ints, output });
+    try common.report(out, "  bufPrint + con_serialize_number", ints_size, ints_text);
+
+    const ints_direct = try common.measure(intsDirect, .{ ints, output });
+    try common.report(out, "  con_serialize_int64", ints_size, ints_direct);
+
+    try out.print("serialize: {d} doubles\n", .{count});
+
+    const doubles_size = try doublesDirect(doubles, output);
+    const doubles_text = try common.measure(doublesText, .{ doubles, output });
+    try common.report(out, "  bufPrint + con_serialize_number", doubles_size, doubles_text);
+
+    const doubles_direct = try common.measure(doublesDirect, .{ doubles, output });
+    try common.report(out, "  con_serialize_double", doubles_size, doubles_direct);
+
+    const tokens = try structural(output);
+    try out.print("serialize: {d} containers, keys and literals\n", .{tokens});
+
+    const structural_time = try common.measure(structural, .{output});
+    try common.reportTokens(out, "  per token", tokens, structural_time);
+
+    const corpora = [_]struct { name: []const u8, escape_every: u32 }{
+        .{ .name = "ASCII-heavy", .escape_every = 200 },
+        .{ .name = "escape-heavy", .escape_every = 4 },
+    };
+    for (corpora) |corpus| {
+        const strings = try generateStrings(allocator, random.random(), corpus.escape_every);
+        defer freeStrings(allocator, strings);
+
+        const strings_output = try allocator.alloc(u8, strings.len * (6 * 256 + 3));
+        defer allocator.free(strings_output);
+
+        try out.print("serialize: {d} {s} strings\n", .{ strings.len, corpus.name });
+
+        const strings_size = try stringsEscape(strings, strings_output);
+        const prepared = try common.measure(stringsPrepared, .{ strings, strings_output });
+        try common.report(out, "  escape + con_serialize_string", strings_size, prepared);
+
+        const escape = try common.measure(stringsEscape, .{ strings, strings_output });
+        try common.report(out, "  con_serialize_string_escape", strings_size, escape);
+
+        var strings_bytes: usize = 0;
+        for (strings) |str| {
+            strings_bytes += str.len;
+        }
+        const check = try common.measure(checkStrings, .{strings});
+        try common.report(out, "  con_serialize_check_string", strings_bytes, check);
+    }
+}
@@ -0,0 +1,170 @@
+const std = @import("std");
+const gci = @import("gci");
+const common = @import("common.zig");
+const lib = @import("../internal.zig").lib;
+const Serialize = @import("../serialize/serialize.zig").Serialize;
+const Deserialize = @import("../deserialize/deserialize.zig").Deserialize;
+const dom = @import("../value/value.zig");
+
+const records = 20_000;
+
+const Kind = enum { leaf, branch, root };
+
+const Record = struct {
+    id: u64,
+    name: []const u8,
+    kind: Kind,
+    active: bool,
+    parent: ?u64,
+    values: []const f64,
+};
+
+fn generate(allocator: std.mem.Allocator) ![]Record {
+    const items = try allocator.alloc(Record, records);
+    errdefer allocator.free(items);
+
+    const values = try allocator.alloc(f64, records * 3);
+    errdefer allocator.free(values);
+
+    var random = std.Random.DefaultPrng.init(0);
+    for (items, 0..) |*item, i| {
+        for (values[i * 3 .. i * 3 + 3]) |*value| {
+            value.* = random.random().float(f64) * 2e3 - 1e3;
+        }
+        item.* = .{
+            .id = i,
+            .name = "record name",
+            .kind = @enumFromInt(i % 3),
+            .active = i % 2 == 0,
+            .parent = if (i % 4 == 0) null else i / 2,
+            .values = values[i * 3 .. i * 3 + 3],
+        };
+    }
+    return items;
+}
+
+const Fifo = std.fifo.LinearFifo(u8, .Slice);
+const ConFifo = gci.Writer(Fifo.Writer);
+
+fn serializeCon(items: []const Record, output: []u8) !usize {
+    var fifo = Fifo.init(output);
+    var writer = ConFifo.init(&fifo.writer());
+    var depth: [4]lib.ConContainer = undefined;
+    var context = try Serialize.init(writer.interface(), &depth);
+    defer context.deinit();
+
+    try context.serializeValue([]const Record, items);
+    return fifo.count;
+}
+
+fn serializeStd(items: []const Record, output: []u8) !usize {
+    var stream = std.io.fixedBufferStream(output);
+    try std.json.stringify(items, .{}, stream.writer());
+    return stream.pos;
+}
+
+fn deserializeCon(data: []const u8) !u64 {
+    var arena = std.heap.ArenaAllocator.init(std.heap.page_allocator);
+    defer arena.deinit();
+
+    var depth: [4]lib.ConContainer = undefined;
+    var context = try Deserialize.initMemory(data, &depth);
+
+    const items = try context.deserializeValue([]Record, arena.allocator());
+    return items[items.len - 1].id;
+}
+
+fn deserializeStd(data: []const u8) !u64 {
+    var arena = std.heap.ArenaAllocator.init(std.heap.page_allocator);
+    defer arena.deinit();
+
+    const items = try std.json.parseFromSliceLeaky([]Record, arena.allocator(), data, .{});
+    return items[items.len - 1].id;
+}
+
+fn domCon(data: []const u8, buffer: []u8) !usize {
+    var depth: [4]lib.ConContainer = undefined;
+    var context = try Deserialize.initMemory(data, &depth);
+
+    var arena = try dom.Arena.init(buffer);
+    const root = try dom.Value.deserialize(&context, &arena);
+    return root.len();
+}
+
+fn domStd(data: []const u8) !usize {
+    var arena = std.heap.ArenaAllocator.init(std.heap.page_allocator);
+    defer arena.deinit();
+
+    const root = try std.json.parseFromSliceLeaky(std.json.Value, arena.allocator(), data, .{});
+    return root.array.items.len;
+}
+
+fn domSerializeCon(root: dom.Value, output: []u8) !usize {
+    var fifo = Fifo.init(output);
+    var writer = ConFifo.init(&fifo.writer());
+    var depth: [4]lib.ConContainer = undefined;
+    var context = try Serialize.init(writer.interface(), &depth);
+    defer context.deinit();
+
+    try root.serialize(&context);
+    return fifo.count;
+}
+
+fn domSerializeStd(root: std.json.Value, output: []u8) !usize {
+    var stream = std.io.fixedBufferStream(output);
+    try std.json.stringify(root, .{}, stream.writer());
+    return stream.pos;
+}
+
+pub fn run(allocator: std.mem.Allocator, out: anytype) !void {
+    const items = try generate(allocator);
+    defer {
+        allocator.free(items[0].values.ptr[0 .. records * 3]);
+        allocator.free(items);
+    }
+
+    const output = try allocator.alloc(u8, records * 256);
+    defer allocator.free(output);
+
+    const length = try serializeStd(items, output);
+    const data = try allocator.dupe(u8, output[0..length]);
+    defer allocator.free(data);
+
+    try out.print("value: {d} records, {d} bytes of JSON\n", .{ records, data.len });
+
+    const con_out = try common.measure(serializeCon, .{ items, output });
+    try common.report(out, "  Serialize.serializeValue", data.len, con_out);
+
+    const std_out = try common.measure(serializeStd, .{ items, output });
+    try common.report(out, "  std.json.stringify", data.len, std_out);
+
+    const con_in = try common.measure(deserializeCon, .{data});
+    try common.report(out, "  Deserialize.deserializeValue", data.len, con_in);
+
+    const std_in = try common.measure(deserializeStd, .{data});
+    try common.report(out, "  std.json.parseFromSliceLeaky", data.len, std_in);
+
+    const buffer = try allocator.alloc(u8, records * 512);
+    defer allocator.free(buffer);
+
+    const con_dom = try common.measure(domCon, .{ data, buffer });
+    try common.report(out, "  Value.deserialize, tree in one arena", data.len, con_dom);
+
+    const std_dom = try common.measure(domStd, .{data});
+    try common.report(out, "  std.json.Value", data.len, std_dom);
+
+    var depth: [4]lib.ConContainer = undefined;
+    var context = try Deserialize.initMemory(data, &depth);
+    var arena = try dom.Arena.init(buffer);
+    const root = try dom.Value.deserialize(&context, &arena);
+
+    const con_tree_out = try common.measure(domSerializeCon, .{ root, output });
+    try common.report(out, "  Value.serialize", data.len, con_tree_out);
+
+    var std_arena = std.heap.ArenaAllocator.init(allocator);
+    defer std_arena.deinit();
+    const std_root = try std.json.parseFromSliceLeaky(std.json.Value, std_arena.allocator(), data, .{});
+
+    const std_tree_out = try common.measure(domSerializeStd, .{ std_root, output });
+    try common.report(out, "  std.json.Value stringify", data.len, std_tree_out);
+}
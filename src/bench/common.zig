@@ -0,0 +1,37 @@
+const std = @import("std");
+
+pub const iterations = 10;
+
+// Runs `func` `iterations` times and returns the fastest run in nanoseconds.
+pub fn measure(comptime func: anytype, args: anytype) !u64 {
+    var best: u64 = std.math.maxInt(u64);
+    for (0..iterations) |_| {
+        var timer = try std.time.Timer.start();
+        const result = try @call(.auto, func, args);
+        const elapsed = timer.read();
+
+        std.mem.doNotOptimizeAway(result);
+        best = @min(best, elapsed);
+    }
+    return best;
+}
+
+pub fn report(out: anytype, name: []const u8, bytes: usize, ns: u64) !void {
+    const seconds = @as(f64, @floatFromInt(@max(ns, 1))) / std.time.ns_per_s;
+    const megabytes = @as(f64, @floatFromInt(bytes)) / (1024 * 1024);
+    try out.print("{s:<48} {d:>10.3} ms {d:>10.1} MB/s\n", .{
+        name,
+        @as(f64, @floatFromInt(ns)) / std.time.ns_per_ms,
+        megabytes / seconds,
+    });
+}
+
+// Reports the time per token instead of the throughput, for benchmarks which
+// are dominated by the work done per token rather than per byte.
+pub fn reportTokens(out: anytype, name: []const u8, tokens: usize, ns: u64) !void {
+    try out.print("{s:<48} {d:>10.3} ms {d:>10.2} ns/token\n", .{
+        name,
+        @as(f64, @floatFromInt(ns)) / std.time.ns_per_ms,
+        @as(f64, @floatFromInt(ns)) / @as(f64, @floatFromInt(@max(tokens, 1))),
+    });
+}
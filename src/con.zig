@@ -3,16 +3,31 @@ const serialize = @import("serialize/serialize.zig");
 const writer = @import("serialize/writer.zig");
 const deserialize = @import("deserialize/deserialize.zig");
 const reader = @import("deserialize/reader.zig");
+const parallel = @import("deserialize/parallel.zig");
+const index = @import("deserialize/index.zig");
+const query = @import("deserialize/query.zig");
+const push = @import("deserialize/push.zig");
+const value = @import("value/value.zig");
 
 pub const State = lib.ConState;
 pub const Container = lib.ConContainer;
 
 pub const Serialize = serialize.Serialize;
 pub const WriterIndent = writer.Indent;
+pub const WriterIndentStyle = writer.Style;
 
 pub const DeserializeType = deserialize.Type;
 pub const Deserialize = deserialize.Deserialize;
+pub const DeserializeKeys = deserialize.Keys;
+pub const Index = index.Index;
+pub const Query = query.Query;
+pub const Push = push.Push;
+pub const Value = value.Value;
+pub const ValueArena = value.Arena;
+pub const splitLines = parallel.splitLines;
+pub const deserializeLines = parallel.deserializeLines;
 pub const ReaderComment = reader.Comment;
+pub const ReaderMap = reader.Map;
 
 test {
     @import("std").testing.refAllDecls(@This());
@@ -21,4 +36,9 @@ test {
 
     _ = @import("deserialize/test/test_deserialize.zig");
     _ = @import("deserialize/test/test_reader.zig");
+    _ = @import("deserialize/test/test_index.zig");
+    _ = @import("deserialize/test/test_query.zig");
+    _ = @import("deserialize/test/test_push.zig");
+
+    _ = @import("value/test/test_value.zig");
 }
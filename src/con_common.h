@@ -1,5 +1,6 @@
 #ifndef CON_COMMON_H
 #define CON_COMMON_H
+#include <stddef.h>
 #include <stdbool.h>
 
 enum ConError {
@@ -23,6 +24,11 @@ enum ConError {
     CON_ERROR_COMMA_UNEXPECTED  = 17,
     CON_ERROR_TYPE              = 18,
     CON_ERROR_STATE_UNKNOWN     = 19,
+    CON_ERROR_OVERFLOW          = 20,
+    CON_ERROR_SURROGATE         = 21,
+    CON_ERROR_INCOMPLETE        = 22,
+    CON_ERROR_QUERY             = 23,
+    CON_ERROR_NEED_INPUT        = 24,
 };
 
 enum ConState {
@@ -41,6 +47,41 @@ enum ConContainer {
     CON_CONTAINER_ARRAY = 2,
 };
 
+// Interface to an allocator, lets a context grow memory it was handed at
+// initialization instead of failing once it is full.
+//
+// Fields:
+//  context:    Passed to `resize` as is.
+//  resize:     Resizes `memory`, which holds `size` bytes, to `new_size`
+//              bytes and returns the new memory with the first
+//              `min(size, new_size)` bytes kept, or null if this failed in
+//              which case `memory` is unchanged. Allocates if `memory` is
+//              null and `size` is 0, frees and returns null if `new_size` is
+//              0.
+struct ConInterfaceAllocator {
+    void const *context;
+    void *(*resize)(void const *context, void *memory, size_t size, size_t new_size);
+};
+
+// Stack of the containers a context is nested in, packed to one bit per level
+// so that 64 levels take up 8 bytes. Level `i` is bit `i % 8` of byte `i / 8`,
+// set for an array and cleared for a dictionary.
+//
+// Fields:
+//  bits:       Pointer to at least `bits_size` bytes.
+//  bits_size:  Amount of bytes `bits` points to.
+//  size:       Maximum amount of levels.
+//  allocated:  If `bits` was allocated with `allocator` and must be freed.
+//  allocator:  Grows `bits` once `size` levels are used, `resize` is null if
+//              the stack may not grow.
+struct ConDepth {
+    unsigned char *bits;
+    size_t bits_size;
+    size_t size;
+    bool allocated;
+    struct ConInterfaceAllocator allocator;
+};
+
 struct ConStateChar {
     enum ConState state;
     bool in_string;
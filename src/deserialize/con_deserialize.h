@@ -1,5 +1,8 @@
 #ifndef CON_DESERIALIZE_H
 #define CON_DESERIALIZE_H
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <gci_interface_reader.h>
 #include <gci_interface_writer.h>
 #include <con_common.h>
@@ -19,32 +22,48 @@ enum ConDeserializeType {
     CON_DESERIALIZE_TYPE_MAX,
 };
 
-// Context struct representing a single JSON element. All characters are read
-// from the `reader` one at a time. With one `struct ConDeserialize` only a
-// single element may be read, if one attempts to read invalid JSON or multiple
+// Context struct representing a single JSON element. Characters are read from
+// the `reader` either one at a time or, if a read buffer is supplied, in chunks
+// as large as the read buffer. With one `struct ConDeserialize` only a single
+// element may be read, if one attempts to read invalid JSON or multiple
 // elements errors will be raised (returned).
 //
 // Fields:
 //  reader:             A valid reader, see `con_reader.h`.
 //  depth:              Current depth of nested containers.
-//  depth_buffer:       Pointer to at least as many items as specified by
-//                      `depth_buffer_size`, owned by this struct.
-//  depth_buffer_size:  A non-negative number specifying at most how many items
-//                      `depth_buffer` points to to.
+//  depth_stack:        Containers which are open, packed to one bit per level
+//                      in the depth buffer passed at initialization, see
+//                      `struct ConDepth`.
+//  read_buffer:        Pointer to at least as many bytes as specified by
+//                      `read_buffer_size`, owned by this struct. Characters
+//                      are read from the `reader` into this buffer in bulk.
+//  read_buffer_size:   Amount of bytes `read_buffer` points to, if 0 the
+//                      `reader` is read from one character at a time.
+//  read_buffer_length: Amount of bytes in `read_buffer` which were read from
+//                      the `reader`.
+//  read_buffer_offset: Index of the next byte in `read_buffer` which has not
+//                      yet been consumed.
+//  from_memory:        If the complete input is contained in `read_buffer`,
+//                      in which case `read_buffer` is never written to.
+//  map:                Mapping `read_buffer` points into if `reader` came
+//                      from a `struct ConReaderMap`, null otherwise.
+//  release_offset:     Once `read_buffer_offset` reaches this the pages of
+//                      `map` before it are handed back to the os.
 //  buffer_char:        Character read from the `reader` which has not yet been
 //                      consumed. Does not contain a character if value is EOF.
 //  state:              Keeps track of the current state of the parsing.
 //  found_comma:        Remembers if a comma was found for the next entry.
 //
 // Invariants:
-//  depth:              0 <= depth <= depth_buffer_size
-//  depth_buffer:       If depth_buffer_size > 0:
-//                          Non-null, points to at least as many items as
-//                          specified by `depth_buffer_size`
-//                      If `depth_buffer_size` == 0:
+//  depth:              0 <= depth <= depth_stack.size
+//  read_buffer:        If read_buffer_size > 0:
+//                          Non-null, points to at least as many bytes as
+//                          specified by `read_buffer_size`
+//                      If `read_buffer_size` == 0:
 //                          May be null or even invalid, will never be read from
 //                          or written to.
-//  depth_buffer_size:  0 <= `depth_buffer_size`.
+//  read_buffer_length: 0 <= read_buffer_length <= read_buffer_size
+//  read_buffer_offset: 0 <= read_buffer_offset <= read_buffer_length
 //  buffer_char:        Contains EOF if empty, otherwise a character that has
 //                      not been consumed.
 //  state:              Managed internally, do not modify.
@@ -52,15 +71,23 @@ enum ConDeserializeType {
 struct ConDeserialize {
     struct GciInterfaceReader reader;
     size_t depth;
-    enum ConContainer *depth_buffer;
-    int depth_buffer_size;
+    struct ConDepth depth_stack;
+    char *read_buffer;
+    size_t read_buffer_size;
+    size_t read_buffer_length;
+    size_t read_buffer_offset;
+    bool from_memory;
+    struct ConReaderMap *map;
+    size_t release_offset;
     int buffer_char;
     enum ConState state;
     bool found_comma;
 };
 
 // Initializes a deserialization context which can then be used to read JSON
-// with `con_deserialize_array_open`, `con_deserialize_number` and similar.
+// with `con_deserialize_array_open`, `con_deserialize_number` and similar. A
+// `reader` from a `struct ConReaderMap` is read in place, see
+// `con_deserialize_init_buffer`.
 //
 // Params:
 //  context:            Valid pointer to single item.
@@ -86,6 +113,109 @@ enum ConError con_deserialize_init(
     int depth_buffer_size
 );
 
+// Initializes a deserialization context which reads from `reader` in chunks of
+// up to `read_buffer_size` bytes instead of one character at a time. Apart from
+// how the `reader` is read from the context behaves exactly like one made with
+// `con_deserialize_init`. Note that characters after the end of the element
+// may be consumed from the `reader`.
+//
+// If `reader` comes from a `struct ConReaderMap` the rest of the mapped file is
+// read in place exactly like with `con_deserialize_init_memory` and
+// `read_buffer` is not used. The mapping must then outlive `context` and any
+// views returned from it.
+//
+// Params:
+//  context:            Valid pointer to single item.
+//  reader:             A reader, see `con_reader.h`. If call succeeds the
+//                      context this reader came from is owned by this `context`
+//  depth_buffer:       May be null if `depth_buffer_size` is 0, must otherwise
+//                      be valid pointer to as many items (or more) as specified.
+//                      by `depth_buffer_size`. If call succeeds this pointer
+//                      is owned by `context`.
+//  depth_buffer_size:  must be equal to or smaller than actual length
+//                      of passed in parameter `depth_buffer`.
+//  read_buffer:        May be null if `read_buffer_size` is 0, must otherwise
+//                      be valid pointer to as many bytes (or more) as specified
+//                      by `read_buffer_size`. If call succeeds this pointer is
+//                      owned by `context`.
+//  read_buffer_size:   must be equal to or smaller than actual length of passed
+//                      in parameter `read_buffer`.
+//
+// Return:
+//  CON_ERROR_OK:       Call succeeded.
+//  CON_ERROR_NULL:     Returned in the following situations:
+//      1. `context` is null.
+//      2. `depth_buffer` is null.
+//      3. `read_buffer` is null.
+//  CON_ERROR_BUFFER:   `depth_buffer_size` is negative.
+enum ConError con_deserialize_init_buffer(
+    struct ConDeserialize *context,
+    struct GciInterfaceReader reader,
+    enum ConContainer *depth_buffer,
+    int depth_buffer_size,
+    char *read_buffer,
+    size_t read_buffer_size
+);
+
+// Initializes a deserialization context which reads from a contiguous buffer
+// in memory instead of a reader. Such a context can return strings, keys and
+// numbers which need no decoding as views into `data` with
+// `con_deserialize_string_view` and similar.
+//
+// Params:
+//  context:            Valid pointer to single item.
+//  data:               May be null if `data_size` is 0, must otherwise be a
+//                      valid pointer to as many bytes (or more) as specified
+//                      by `data_size`. Must outlive `context` and any views
+//                      returned from it, is never written to.
+//  data_size:          Amount of bytes of input in `data`.
+//  depth_buffer:       May be null if `depth_buffer_size` is 0, must otherwise
+//                      be valid pointer to as many items (or more) as specified.
+//                      by `depth_buffer_size`. If call succeeds this pointer
+//                      is owned by `context`.
+//  depth_buffer_size:  must be equal to or smaller than actual length
+//                      of passed in parameter `depth_buffer`.
+//
+// Return:
+//  CON_ERROR_OK:       Call succeeded.
+//  CON_ERROR_NULL:     Returned in the following situations:
+//      1. `context` is null.
+//      2. `data` is null.
+//      3. `depth_buffer` is null.
+//  CON_ERROR_BUFFER:   `depth_buffer_size` is negative.
+enum ConError con_deserialize_init_memory(
+    struct ConDeserialize *context,
+    char const *data,
+    size_t data_size,
+    enum ConContainer *depth_buffer,
+    int depth_buffer_size
+);
+
+// Lets the depth stack of `context` grow with `allocator` instead of returning
+// `CON_ERROR_TOO_DEEP` once it is full, for input of unknown depth. The depth
+// buffer passed at initialization is then used as initial storage at one bit
+// per level, e.g. a 4 byte item holds 32 levels, and memory is only allocated
+// for deeper nesting. `con_deserialize_deinit` must be called to free it.
+//
+// Params:
+//  context:    Valid pointer to single item.
+//  allocator:  An allocator, see `struct ConInterfaceAllocator`. Its context
+//              must stay valid until `context` is deinitialized.
+//
+// Return:
+//  CON_ERROR_OK:       Call succeeded.
+//  CON_ERROR_NULL:     `context` or `allocator.resize` is null.
+//  CON_ERROR_BUFFER:   The depth stack already grew with another allocator.
+enum ConError con_deserialize_depth_allocator(struct ConDeserialize *context, struct ConInterfaceAllocator allocator);
+
+// Frees memory the depth stack of `context` allocated, `context` may not be
+// used afterwards. Does nothing if it has no allocator.
+//
+// Return:
+//  CON_ERROR_OK:       Call succeeded.
+//  CON_ERROR_NULL:     `context` is null.
+enum ConError con_deserialize_deinit(struct ConDeserialize *context);
+
 // Return:
 //  CON_ERROR_OK:               Call succeded.
 //  CON_ERROR_NULL:             `type` is null.
@@ -105,7 +235,8 @@ enum ConError con_deserialize_next(
 // Return:
 //  CON_ERROR_OK:               Call succeded.
 //  CON_ERROR_READER:           Failed to read data.
-//  CON_ERROR_TOO_DEEP:         Opened too many containers.
+//  CON_ERROR_TOO_DEEP:         Opened too many containers, or the depth stack
+//                              failed to grow.
 //  CON_ERROR_COMPLETE:         JSON already complete.
 //  CON_ERROR_KEY:              Missing dictionary key before this element.
 //  CON_ERROR_INVALID_JSON:     Could not recognize start of next token.
@@ -136,7 +267,8 @@ enum ConError con_deserialize_array_close(struct ConDeserialize *context);
 // Return:
 //  CON_ERROR_OK:               Call succeded.
 //  CON_ERROR_READER:           Failed to read data.
-//  CON_ERROR_TOO_DEEP:         Opened too many containers.
+//  CON_ERROR_TOO_DEEP:         Opened too many containers, or the depth stack
+//                              failed to grow.
 //  CON_ERROR_COMPLETE:         JSON already complete.
 //  CON_ERROR_KEY:              Missing dictionary key before this element.
 //  CON_ERROR_INVALID_JSON:     Could not recognize start of next token.
@@ -177,8 +309,27 @@ enum ConError con_deserialize_dict_close(struct ConDeserialize *context);
 //  CON_ERROR_COMMA_UNEXPECTED: Comma found before the first element in a
 //                              container.
 //  CON_ERROR_TYPE:             Next token is not a string.
+//  CON_ERROR_SURROGATE:        A `\u` escape is a lone or invalid UTF-16
+//                              surrogate.
 enum ConError con_deserialize_dict_key(struct ConDeserialize *context, struct GciInterfaceWriter writer);
 
+// Reads a key like `con_deserialize_dict_key` but avoids copying it if
+// possible. If the context reads from memory, see
+// `con_deserialize_init_memory`, and the key contains no escape sequences
+// `key` and `key_size` are set to refer to the key in the input and nothing
+// is written to `writer`. Otherwise `key` is set to null and the decoded key
+// is written to `writer`.
+//
+// Return:
+//  Same as `con_deserialize_dict_key` and additionally:
+//  CON_ERROR_NULL:             `key` or `key_size` is null.
+enum ConError con_deserialize_dict_key_view(
+    struct ConDeserialize *context,
+    char const **key,
+    size_t *key_size,
+    struct GciInterfaceWriter writer
+);
+
 // Return:
 //  CON_ERROR_OK:               Call succeded.
 //  CON_ERROR_READER:           Failed to read data.
@@ -197,6 +348,55 @@ enum ConError con_deserialize_dict_key(struct ConDeserialize *context, struct Gc
 //  CON_ERROR_TYPE:             Next token is not a number.
 enum ConError con_deserialize_number(struct ConDeserialize *context, struct GciInterfaceWriter writer);
 
+// Reads a number like `con_deserialize_number` but avoids copying it if
+// possible. If the context reads from memory, see
+// `con_deserialize_init_memory`, `number` and `number_size` are set to refer
+// to the number in the input and nothing is written to `writer`. Otherwise
+// `number` is set to null and the number is written to `writer`.
+//
+// Return:
+//  Same as `con_deserialize_number` and additionally:
+//  CON_ERROR_NULL:             `number` or `number_size` is null.
+enum ConError con_deserialize_number_view(
+    struct ConDeserialize *context,
+    char const **number,
+    size_t *number_size,
+    struct GciInterfaceWriter writer
+);
+
+// Reads a number and converts it to a signed integer in the same pass as it
+// is validated. The number is consumed even if it cannot be converted.
+//
+// Return:
+//  Same as `con_deserialize_number` except for writer errors and additionally:
+//  CON_ERROR_NULL:             `value` is null.
+//  CON_ERROR_TYPE:             Next token is not a number or the number has a
+//                              fraction or an exponent.
+//  CON_ERROR_OVERFLOW:         Number does not fit in an `int64_t`.
+enum ConError con_deserialize_int64(struct ConDeserialize *context, int64_t *value);
+
+// Reads a number and converts it to an unsigned integer in the same pass as it
+// is validated. The number is consumed even if it cannot be converted.
+//
+// Return:
+//  Same as `con_deserialize_number` except for writer errors and additionally:
+//  CON_ERROR_NULL:             `value` is null.
+//  CON_ERROR_TYPE:             Next token is not a number or the number has a
+//                              fraction or an exponent.
+//  CON_ERROR_OVERFLOW:         Number is negative or does not fit in a
+//                              `uint64_t`.
+enum ConError con_deserialize_uint64(struct ConDeserialize *context, uint64_t *value);
+
+// Reads a number and converts it to the nearest double, ties to even, in the
+// same pass as it is validated. Numbers too small to be represented become
+// zero. The number is consumed even if it cannot be converted.
+//
+// Return:
+//  Same as `con_deserialize_number` except for writer errors and additionally:
+//  CON_ERROR_NULL:             `value` is null.
+//  CON_ERROR_OVERFLOW:         Number is too large to be represented.
+enum ConError con_deserialize_double(struct ConDeserialize *context, double *value);
+
 // Return:
 //  CON_ERROR_OK:               Call succeded.
 //  CON_ERROR_READER:           Failed to read data.
@@ -210,8 +410,27 @@ enum ConError con_deserialize_number(struct ConDeserialize *context, struct GciI
 //  CON_ERROR_COMMA_UNEXPECTED: Comma found before the first element in a
 //                              container.
 //  CON_ERROR_TYPE:             Next token is not a string.
+//  CON_ERROR_SURROGATE:        A `\u` escape is a lone or invalid UTF-16
+//                              surrogate.
 enum ConError con_deserialize_string(struct ConDeserialize *context, struct GciInterfaceWriter writer);
 
+// Reads a string like `con_deserialize_string` but avoids copying it if
+// possible. If the context reads from memory, see
+// `con_deserialize_init_memory`, and the string contains no escape sequences
+// `string` and `string_size` are set to refer to the string in the input and
+// nothing is written to `writer`. Otherwise `string` is set to null and the
+// decoded string is written to `writer`.
+//
+// Return:
+//  Same as `con_deserialize_string` and additionally:
+//  CON_ERROR_NULL:             `string` or `string_size` is null.
+enum ConError con_deserialize_string_view(
+    struct ConDeserialize *context,
+    char const **string,
+    size_t *string_size,
+    struct GciInterfaceWriter writer
+);
+
 // Return:
 //  CON_ERROR_OK:               Call succeded.
 //  CON_ERROR_READER:           Failed to read data.
@@ -242,4 +461,107 @@ enum ConError con_deserialize_bool(struct ConDeserialize *context, bool *value);
 //  CON_ERROR_TYPE:             Next token is not null.
 enum ConError con_deserialize_null(struct ConDeserialize *context);
 
+// Consumes the next value, a scalar or a whole array or dictionary, without
+// decoding it. Scalars are validated as by their typed functions. Inside a
+// skipped container only brackets are counted and strings are followed to their
+// closing quote, so the contents are otherwise not validated and the depth
+// buffer is not used.
+//
+// Return:
+//  CON_ERROR_OK:               Call succeded.
+//  CON_ERROR_READER:           Failed to read data, e.g. the container or a
+//                              string in it is not closed.
+//  CON_ERROR_COMPLETE:         JSON already complete.
+//  CON_ERROR_KEY:              Missing dictionary key before this element, or
+//                              the next token is a key.
+//  CON_ERROR_INVALID_JSON:     Returned in the following situations:
+//      1. could not recognize start of next token.
+//      2. invalid number, bool or null.
+//  CON_ERROR_COMMA_MISSING:    Missing comma.
+//  CON_ERROR_COMMA_MULTIPLE:   Multiple commas found.
+//  CON_ERROR_COMMA_UNEXPECTED: Comma found before the first element in a
+//                              container.
+//  CON_ERROR_TYPE:             Next token closes a container.
+enum ConError con_deserialize_skip(struct ConDeserialize *context);
+
+// Starts reading the next element of a stream of elements separated by
+// whitespace, such as newline delimited JSON. Skips whitespace up to the next
+// element and resets the context to read it like a newly initialized one,
+// without losing anything which is buffered. Call it once before the first
+// element and after each complete element.
+//
+// Params:
+//  context:    Valid pointer to single item.
+//  found:      Set to true if another element follows, false if the input is
+//              exhausted.
+//
+// Return:
+//  CON_ERROR_OK:           Call succeded.
+//  CON_ERROR_NULL:         `found` is null.
+//  CON_ERROR_INCOMPLETE:   Current element is not complete.
+enum ConError con_deserialize_record(struct ConDeserialize *context, bool *found);
+
+// Index reported by `con_deserialize_dict_key_match` for a key which is not in
+// the table.
+#define CON_DESERIALIZE_KEY_UNKNOWN SIZE_MAX
+
+// Table of the keys a dictionary is expected to contain, made once with
+// `con_deserialize_keys_init` and then used with
+// `con_deserialize_dict_key_match` to identify keys while they are read.
+//
+// Fields:
+//  keys:       Pointer to `keys_size` null terminated keys, not owned.
+//  keys_size:  Amount of keys.
+//  order:      Indices into `keys` sorted by key, owned by this struct.
+//  first:      Keys starting with the byte `c` are `order[first[c]]` up to
+//              but excluding `order[first[c + 1]]`.
+struct ConDeserializeKeys {
+    char const *const *keys;
+    size_t keys_size;
+    size_t const *order;
+    size_t first[UCHAR_MAX + 2];
+};
+
+// Initializes a table of expected dictionary keys. If a key occurs more than
+// once it is matched to its first occurrence.
+//
+// Params:
+//  table:      Valid pointer to single item.
+//  keys:       May be null if `keys_size` is 0, must otherwise be a valid
+//              pointer to `keys_size` null terminated keys which outlive
+//              `table`.
+//  order:      May be null if `keys_size` is 0, must otherwise be a valid
+//              pointer to `keys_size` items. If call succeeds this pointer is
+//              owned by `table`.
+//  keys_size:  Amount of keys.
+//
+// Return:
+//  CON_ERROR_OK:   Call succeeded.
+//  CON_ERROR_NULL: Returned in the following situations:
+//      1. `table` is null.
+//      2. `keys` or `order` is null.
+//      3. a key is null.
+enum ConError con_deserialize_keys_init(
+    struct ConDeserializeKeys *table,
+    char const *const *keys,
+    size_t *order,
+    size_t keys_size
+);
+
+// Reads a key like `con_deserialize_dict_key` and sets `index` to its index in
+// `table`. The key is compared to the table while it is read, one byte at a
+// time, and is never written anywhere. If the key is not in the table `index`
+// is set to `CON_DESERIALIZE_KEY_UNKNOWN` and its value is consumed with
+// `con_deserialize_skip`.
+//
+// Return:
+//  Same as `con_deserialize_dict_key` except for writer errors, the same as
+//  `con_deserialize_skip` if the key is unknown and additionally:
+//  CON_ERROR_NULL:             `table` or `index` is null.
+enum ConError con_deserialize_dict_key_match(
+    struct ConDeserialize *context,
+    struct ConDeserializeKeys const *table,
+    size_t *index
+);
+
 #endif
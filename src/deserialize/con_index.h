@@ -0,0 +1,131 @@
+#ifndef CON_INDEX_H
+#define CON_INDEX_H
+#include <stddef.h>
+#include <stdint.h>
+#include <con_common.h>
+#include "con_deserialize.h"
+
+// Entry returned for a value which is not in the document.
+#define CON_INDEX_NONE SIZE_MAX
+
+// A single token of an indexed document. The entries of a container follow its
+// opening entry and are ended by its closing entry, a key is followed by the
+// entry of its value.
+struct ConIndexEntry {
+    enum ConDeserializeType type;
+    size_t offset;      // position of the first character of the token
+    size_t size;        // elements of an array or keys of a dict when opening,
+                        // otherwise length of the token in bytes
+    size_t next;        // entry after this value including all of its contents
+};
+
+// A validated document in memory together with a tape of its tokens, which can
+// be queried any number of times without reading the document again.
+struct ConIndex {
+    char const *data;
+    size_t data_size;
+    struct ConIndexEntry *tape;
+    size_t tape_size;
+    size_t tape_length;
+};
+
+// Validates the single JSON element in `data` and writes one entry per token
+// to `tape`, the element itself is entry 0. The data is scanned with SSE2 or
+// AVX2 where the target supports it, skipping whitespace and the bodies of
+// strings in blocks. Escape sequences are checked to be well formed but only
+// decoded when read, see `con_index_deserialize`.
+//
+// Params:
+//  index:              Valid pointer to single item.
+//  data:               May be null if `data_size` is 0, must otherwise be a
+//                      valid pointer to as many bytes (or more) as specified
+//                      by `data_size`. Must outlive `index`.
+//  data_size:          Amount of bytes of input in `data`.
+//  tape:               May be null if `tape_size` is 0, must otherwise be a
+//                      valid pointer to as many items (or more) as specified
+//                      by `tape_size`. If call succeeds this pointer is owned
+//                      by `index`.
+//  tape_size:          Must be equal to or smaller than actual length of passed
+//                      in parameter `tape`.
+//  depth_buffer:       May be null if `depth_buffer_size` is 0, must otherwise
+//                      be valid pointer to as many items (or more) as specified
+//                      by `depth_buffer_size`. Only used during this call.
+//  depth_buffer_size:  Maximum depth of nested containers.
+//
+// Return:
+//  CON_ERROR_OK:               Call succeeded.
+//  CON_ERROR_NULL:             Returned in the following situations:
+//      1. `index` is null.
+//      2. `data` is null.
+//      3. `tape` is null.
+//      4. `depth_buffer` is null.
+//  CON_ERROR_READER:           Data ended before the element was complete.
+//  CON_ERROR_CLOSED_TOO_MANY:  Closed a container which was not opened.
+//  CON_ERROR_BUFFER:           Document has more tokens than `tape_size`.
+//  CON_ERROR_TOO_DEEP:         Containers are nested deeper than
+//                              `depth_buffer_size`.
+//  CON_ERROR_COMPLETE:         More data follows the element.
+//  CON_ERROR_KEY:              Missing dictionary key.
+//  CON_ERROR_VALUE:            Dictionary closed after a key.
+//  CON_ERROR_NOT_ARRAY:        `]` closes a dictionary.
+//  CON_ERROR_NOT_DICT:         `}` closes an array.
+//  CON_ERROR_INVALID_JSON:     Returned in the following situations:
+//      1. could not recognize start of a token.
+//      2. invalid number, bool, null or escape sequence.
+//      3. missing `:` after a key.
+//  CON_ERROR_COMMA_MISSING:    Missing comma.
+//  CON_ERROR_COMMA_MULTIPLE:   Multiple commas found.
+//  CON_ERROR_COMMA_TRAILING:   Trailing comma found at end of container.
+//  CON_ERROR_COMMA_UNEXPECTED: Comma found before the first element of a
+//                              container or outside a container.
+enum ConError con_index_init(
+    struct ConIndex *index,
+    char const *data,
+    size_t data_size,
+    struct ConIndexEntry *tape,
+    size_t tape_size,
+    size_t *depth_buffer,
+    size_t depth_buffer_size
+);
+
+// Sets `entry` to the element at `position` in the array at entry `array`,
+// or to `CON_INDEX_NONE` if the array is shorter. Containers before it are
+// jumped over in constant time.
+//
+// Return:
+//  CON_ERROR_OK:           Call succeeded.
+//  CON_ERROR_NULL:         `index` or `entry` is null.
+//  CON_ERROR_BUFFER:       `array` is not an entry of the tape.
+//  CON_ERROR_NOT_ARRAY:    `array` is not an array.
+enum ConError con_index_array_get(struct ConIndex const *index, size_t array, size_t position, size_t *entry);
+
+// Sets `entry` to the value of the first `key` in the dictionary at entry
+// `dict`, or to `CON_INDEX_NONE` if the key is not there. Keys with escape
+// sequences are decoded before they are compared.
+//
+// Return:
+//  CON_ERROR_OK:           Call succeeded.
+//  CON_ERROR_NULL:         `index`, `key` or `entry` is null.
+//  CON_ERROR_BUFFER:       `dict` is not an entry of the tape.
+//  CON_ERROR_NOT_DICT:     `dict` is not a dictionary.
+//  CON_ERROR_SURROGATE:    A key has an invalid `\u` escape.
+enum ConError con_index_dict_get(struct ConIndex const *index, size_t dict, char const *key, size_t key_size, size_t *entry);
+
+// Initializes `context` to read the value at entry `entry` with the functions
+// of `con_deserialize.h`, as if the value was all of the data passed to
+// `con_deserialize_init_memory`.
+//
+// Return:
+//  Same as `con_deserialize_init_memory` and additionally:
+//  CON_ERROR_NULL:         `index` is null.
+//  CON_ERROR_BUFFER:       `entry` is not an entry of the tape.
+//  CON_ERROR_TYPE:         `entry` closes a container.
+enum ConError con_index_deserialize(
+    struct ConIndex const *index,
+    size_t entry,
+    struct ConDeserialize *context,
+    enum ConContainer *depth_buffer,
+    int depth_buffer_size
+);
+
+#endif
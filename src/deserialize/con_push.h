@@ -0,0 +1,181 @@
+#ifndef CON_PUSH_H
+#define CON_PUSH_H
+#include <stddef.h>
+#include <gci_interface_writer.h>
+#include <con_common.h>
+#include "con_deserialize.h"
+
+// Where a push context stopped inside the input, lets reading resume at any
+// byte.
+enum ConPushLexer {
+    CON_PUSH_LEXER_TOKEN            = 0,    // between tokens
+    CON_PUSH_LEXER_COLON            = 1,    // after a key, before its `:`
+    CON_PUSH_LEXER_STRING           = 2,    // in the body of a string or key
+    CON_PUSH_LEXER_ESCAPE           = 3,    // after a `\`
+    CON_PUSH_LEXER_UNICODE          = 4,    // in the hex digits of a `\u`
+    CON_PUSH_LEXER_LOW_ESCAPE       = 5,    // after a high surrogate, before `\`
+    CON_PUSH_LEXER_LOW_U            = 6,    // after a high surrogate and `\`
+    CON_PUSH_LEXER_NUMBER           = 7,    // in a number
+    CON_PUSH_LEXER_LITERAL          = 8,    // in `true`, `false` or `null`
+};
+
+// Context struct reading a single JSON element token by token from chunks of
+// input which are handed to it as they become available, e.g. from a non
+// blocking socket. Every byte of a chunk is looked at exactly once and nothing
+// is copied, when a chunk ends in the middle of a token the partial token is
+// kept in the context so reading resumes at the next chunk where it stopped.
+// The decoded text of strings and keys and the characters of numbers are
+// written to `writer` as they are read, a token may thus be written over
+// several chunks.
+//
+// Fields:
+//  writer:             Receives strings, keys and numbers.
+//  depth:              Current depth of nested containers.
+//  depth_stack:        Containers which are open, packed to one bit per level
+//                      in the depth buffer passed at initialization, see
+//                      `struct ConDepth`.
+//  data:               Current chunk, owned by the caller until it is
+//                      consumed.
+//  data_size:          Amount of bytes in `data`.
+//  data_offset:        Index of the next byte in `data` which has not yet been
+//                      consumed.
+//  end:                If no chunk follows the current one.
+//  boolean:            Value of the last bool read.
+//  state:              Managed internally, do not modify.
+//  found_comma:        Managed internally, do not modify.
+//  token_end:          Managed internally, do not modify.
+//  lexer:              Managed internally, do not modify.
+//  key:                Managed internally, do not modify.
+//  number:             Managed internally, do not modify.
+//  literal:            Managed internally, do not modify.
+//  literal_offset:     Managed internally, do not modify.
+//  code_unit:          Managed internally, do not modify.
+//  digits:             Managed internally, do not modify.
+//  high_surrogate:     Managed internally, do not modify.
+//
+// Invariants:
+//  depth:              0 <= depth <= depth_stack.size
+//  data_offset:        0 <= data_offset <= data_size
+struct ConPush {
+    struct GciInterfaceWriter writer;
+    size_t depth;
+    struct ConDepth depth_stack;
+    char const *data;
+    size_t data_size;
+    size_t data_offset;
+    bool end;
+    bool boolean;
+    enum ConState state;
+    bool found_comma;
+    bool token_end;
+    enum ConPushLexer lexer;
+    bool key;
+    int number;
+    char const *literal;
+    size_t literal_offset;
+    unsigned int code_unit;
+    unsigned int digits;
+    unsigned int high_surrogate;
+};
+
+// Initializes a push context without any input, feed it chunks with
+// `con_push_feed`.
+//
+// Params:
+//  context:            Valid pointer to single item.
+//  writer:             A writer, see `gci_interface_writer.h`.
+//  depth_buffer:       May be null if `depth_buffer_size` is 0, must otherwise
+//                      be valid pointer to as many items (or more) as specified.
+//                      by `depth_buffer_size`. If call succeeds this pointer
+//                      is owned by `context`.
+//  depth_buffer_size:  must be equal to or smaller than actual length
+//                      of passed in parameter `depth_buffer`.
+//
+// Return:
+//  CON_ERROR_OK:       Call succeeded.
+//  CON_ERROR_NULL:     Returned in the following situations:
+//      1. `context` is null.
+//      2. `depth_buffer` is null.
+//  CON_ERROR_BUFFER:   `depth_buffer_size` is negative.
+enum ConError con_push_init(
+    struct ConPush *context,
+    struct GciInterfaceWriter writer,
+    enum ConContainer *depth_buffer,
+    int depth_buffer_size
+);
+
+// Hands the next chunk of input to `context`. May only be called once every
+// byte of the previous chunk is consumed, i.e. once `con_push_next` returned
+// `CON_ERROR_NEED_INPUT`. Only a pointer is kept, `data` must stay valid until
+// then.
+//
+// Params:
+//  context:    Valid pointer to single item.
+//  data:       May be null if `data_size` is 0, must otherwise be a valid
+//              pointer to as many bytes (or more) as specified by
+//              `data_size`.
+//  data_size:  Amount of bytes in `data`.
+//
+// Return:
+//  CON_ERROR_OK:       Call succeeded.
+//  CON_ERROR_NULL:     `context` or `data` is null.
+//  CON_ERROR_BUFFER:   Previous chunk is not consumed yet.
+//  CON_ERROR_READER:   `con_push_finish` was called before.
+enum ConError con_push_feed(struct ConPush *context, char const *data, size_t data_size);
+
+// Marks the end of the input, after the current chunk no more data follows.
+// A number at the very end of the input is only complete once this is known.
+//
+// Return:
+//  CON_ERROR_OK:   Call succeeded.
+//  CON_ERROR_NULL: `context` is null.
+enum ConError con_push_finish(struct ConPush *context);
+
+// Reads the next token from the fed chunks. Containers are opened and closed,
+// strings, keys and numbers are written to the writer of `context` and the
+// value of a bool is stored in its field `boolean`.
+//
+// Params:
+//  context:    Valid pointer to single item.
+//  type:       Valid pointer to single item, set to the type of the token.
+//
+// Return:
+//  CON_ERROR_OK:               Call succeeded.
+//  CON_ERROR_NULL:             `context` or `type` is null.
+//  CON_ERROR_NEED_INPUT:       The current chunk is consumed before the next
+//                              token is complete, feed another chunk and call
+//                              again.
+//  CON_ERROR_WRITER:           Writer failed.
+//  CON_ERROR_READER:           Input ended before the element was complete.
+//  CON_ERROR_CLOSED_TOO_MANY:  Closed a container which was not opened.
+//  CON_ERROR_TOO_DEEP:         Containers are nested deeper than the depth
+//                              buffer.
+//  CON_ERROR_COMPLETE:         The element was read completely, the rest of
+//                              the input is not looked at, see
+//                              `con_push_record`.
+//  CON_ERROR_KEY:              Missing dictionary key.
+//  CON_ERROR_VALUE:            Key without a value or key in an array.
+//  CON_ERROR_NOT_ARRAY:        `]` closes a dictionary.
+//  CON_ERROR_NOT_DICT:         `}` closes an array.
+//  CON_ERROR_INVALID_JSON:     Returned in the following situations:
+//      1. could not recognize start of a token.
+//      2. invalid number, bool, null or escape sequence.
+//      3. missing `:` after a key.
+//  CON_ERROR_COMMA_MISSING:    Missing comma.
+//  CON_ERROR_COMMA_MULTIPLE:   Multiple commas found.
+//  CON_ERROR_COMMA_TRAILING:   Trailing comma found at end of container.
+//  CON_ERROR_COMMA_UNEXPECTED: Comma found before the first element of a
+//                              container or outside a container.
+//  CON_ERROR_SURROGATE:        Unpaired UTF-16 surrogate in a `\u` escape.
+enum ConError con_push_next(struct ConPush *context, enum ConDeserializeType *type);
+
+// Prepares `context` to read another element following the current one, e.g.
+// the next message on a connection. The rest of the current chunk is kept.
+//
+// Return:
+//  CON_ERROR_OK:           Call succeeded.
+//  CON_ERROR_NULL:         `context` is null.
+//  CON_ERROR_INCOMPLETE:   The current element is not read completely.
+enum ConError con_push_record(struct ConPush *context);
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef CON_QUERY_H
+#define CON_QUERY_H
+#include <stddef.h>
+#include <stdint.h>
+#include <con_common.h>
+#include "con_deserialize.h"
+
+// Array index of a segment which is not a valid index.
+#define CON_QUERY_NONE SIZE_MAX
+
+// A single reference token of a pointer, for example `items` in
+// `/items/*/id`.
+struct ConQuerySegment {
+    char const *token;  // token as written in the pointer, with `~0` and `~1`
+    size_t token_size;
+    size_t index;       // token as array index, or `CON_QUERY_NONE`
+    size_t position;    // elements of the current array seen so far
+};
+
+struct ConQuery {
+    struct ConQuerySegment *segments;
+    size_t segments_size;
+    size_t segments_length;
+    size_t depth;
+    bool started;
+    bool done;
+};
+
+// Initializes a query for the values at `pointer`, a JSON Pointer as in
+// RFC 6901. The empty pointer refers to the whole element, every other
+// pointer consists of tokens each preceded by `/`. A token matches the dict
+// key it is equal to after replacing `~1` by `/` and `~0` by `~`, or the
+// array element at the position it spells in decimal without leading zeros.
+// As an extension a token `*` matches every key and every element, so that
+// `/items/*/id` refers to the `id` of every item.
+//
+// Params:
+//  query:          Valid pointer to single item.
+//  pointer:        May be null if `pointer_size` is 0, must otherwise be a
+//                  valid pointer to as many bytes (or more) as specified by
+//                  `pointer_size`. Must outlive `query`.
+//  pointer_size:   Amount of bytes in `pointer`.
+//  segments:       May be null if `segments_size` is 0, must otherwise be a
+//                  valid pointer to as many items (or more) as specified by
+//                  `segments_size`. If call succeeds this pointer is owned
+//                  by `query`.
+//  segments_size:  Must be equal to or smaller than actual length of passed
+//                  in parameter `segments`.
+//
+// Return:
+//  CON_ERROR_OK:               Call succeeded.
+//  CON_ERROR_NULL:             Returned in the following situations:
+//      1. `query` is null.
+//      2. `pointer` is null.
+//      3. `segments` is null.
+//  CON_ERROR_BUFFER:           Pointer has more tokens than `segments_size`.
+//  CON_ERROR_QUERY:            Returned in the following situations:
+//      1. pointer is not empty and does not start with `/`.
+//      2. `~` is not followed by `0` or `1`.
+enum ConError con_query_init(
+    struct ConQuery *query,
+    char const *pointer,
+    size_t pointer_size,
+    struct ConQuerySegment *segments,
+    size_t segments_size
+);
+
+// Reads `context` up to the next value matched by `query`, which can then be
+// read with the functions of `con_deserialize.h`. Subtrees which can not
+// contain a match are passed over with `con_deserialize_skip` without being
+// decoded. The first call must be made with `context` before the element to
+// query, every following call after the previous match was read completely.
+// Once `found` is false the element has been read completely.
+//
+// Params:
+//  query:      Valid pointer to single item.
+//  context:    Valid pointer to single item.
+//  found:      Set to true if `context` is before a matching value, false if
+//              the element has no more matches.
+//
+// Return:
+//  Same as `con_deserialize_skip` and additionally:
+//  CON_ERROR_NULL:         `query`, `context` or `found` is null.
+//  CON_ERROR_INCOMPLETE:   Previous match was not read completely, detected
+//                          for containers and values in a dict.
+enum ConError con_query_next(struct ConQuery *query, struct ConDeserialize *context, bool *found);
+
+#endif
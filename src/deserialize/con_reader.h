@@ -17,4 +17,68 @@ enum ConError con_reader_comment_init(
 
 struct GciInterfaceReader con_reader_comment_interface(struct ConReaderComment *context);
 
+// Amount of consumed bytes of a mapping which are handed back to the os at
+// once, keeps the resident size of reading a large file bounded. Must be a
+// multiple of the page size.
+#define CON_READER_MAP_RELEASE ((size_t) 1 << 24)
+
+// A reader over a file mapped into memory. Reading copies out of the mapping
+// without any system calls, and a deserialization context or comment reader
+// made from this reader scans the mapping directly instead, see
+// `con_deserialize_init` and `con_reader_comment_init`. The mapping is
+// hinted to be read sequentially and backed by huge pages where supported.
+// Pages which were consumed are handed back to the os in steps of
+// `CON_READER_MAP_RELEASE`, views into them stay valid since the mapping is
+// private and read only, they are read from the file again when accessed.
+struct ConReaderMap {
+    char const *data;
+    size_t data_size;
+    size_t position;
+    size_t released;    // bytes before this have been handed back to the os
+};
+
+// Initializes a `struct ConReaderMap` by mapping all of the regular file
+// `fd`. The file descriptor is not needed after this call and may be closed.
+//
+// Params:
+//  context:    Single items pointer to `struct ConReaderMap`.
+//  fd:         File descriptor of a regular file open for reading.
+//
+// Return:
+//  CON_ERROR_OK:       Call succeeded.
+//  CON_ERROR_NULL:     `context` is null.
+//  CON_ERROR_READER:   The file could not be mapped, e.g. `fd` is not a
+//                      regular file or memory mapping is not supported.
+enum ConError con_reader_map_init(struct ConReaderMap *context, int fd);
+
+// Unmaps the file of an initialized `struct ConReaderMap`. Any view returned
+// from a deserialization context using the mapping is invalid afterwards.
+//
+// Return:
+//  CON_ERROR_OK:       Call succeeded.
+//  CON_ERROR_NULL:     `context` is null.
+enum ConError con_reader_map_deinit(struct ConReaderMap *context);
+
+// Makes a reader interface from an already initialized `struct ConReaderMap`
+// the returned reader owns the passed in `context`.
+struct GciInterfaceReader con_reader_map_interface(struct ConReaderMap *context);
+
+// If `reader` was made with `con_reader_map_interface` the unread part of the
+// mapping is returned in `data` and `data_size` and counts as read from then
+// on, otherwise false is returned and nothing is changed.
+bool con_reader_map_take(struct GciInterfaceReader reader, char const **data, size_t *data_size);
+
+// Hands the pages of the mapping before `data` back to the os, for a context
+// scanning the data returned by `con_reader_map_take`. Pages are only released
+// in steps of `CON_READER_MAP_RELEASE`.
+//
+// Params:
+//  context:    Valid pointer to an initialized `struct ConReaderMap`.
+//  data:       Pointer into the mapping, everything before it is consumed.
+//
+// Return:
+//  Amount of bytes after `data` which may be consumed before calling this
+//  again releases anything.
+size_t con_reader_map_release_before(struct ConReaderMap *context, char const *data);
+
 #endif
@@ -1,34 +1,219 @@
 #include <assert.h>
 #include <ctype.h>
 #include <utils.h>
+#include <float.h>
 #include <limits.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include "con_writer.h"
+#include "con_reader.h"
 #include "con_deserialize.h"
 
+// Significant digits kept when converting a number to a double. Any input is
+// rounded correctly as long as the digits dropped are only remembered as being
+// zero or not, since a double never needs more than 767 to be told apart.
+#define CON_DESERIALIZE_NUMBER_DIGITS 800
+
+// Magnitude above which an exponent is not tracked exactly, any larger value
+// overflows or underflows a double regardless of the digits.
+#define CON_DESERIALIZE_NUMBER_EXPONENT_MAX 1000000000000000
+
+// Value of a number collected while it is validated, i.e. one character at a
+// time in the same pass as `con_utils_state_number_next`.
+//
+// The number is `(-1)^negative * digits * 10^(scale + exponent)` where
+// `digits` is read as an integer. `whole` holds the integer part on its own
+// so integers need no further parsing.
+struct ConDeserializeNumber {
+    bool negative;
+    bool fraction;                  // number has a fraction or an exponent
+    uint64_t whole;
+    bool whole_overflow;            // integer part does not fit in `whole`
+    char digits[CON_DESERIALIZE_NUMBER_DIGITS + 32];
+    size_t digits_length;           // significant digits, no leading zeros
+    bool digits_truncated;          // a dropped digit was not zero
+    int64_t scale;
+    int64_t exponent;
+    bool exponent_negative;
+};
+
+// Range of keys in a `struct ConDeserializeKeys`, `order[low]` up to but
+// excluding `order[high]`, which start with the `position` bytes of the key
+// read so far.
+struct ConDeserializeKeysMatch {
+    struct ConDeserializeKeys const *table;
+    size_t low;
+    size_t high;
+    size_t position;
+};
+
 static inline enum ConContainer con_deserialize_container_current(struct ConDeserialize *context);
 static inline enum ConError con_deserialize_internal_next(struct ConDeserialize *context, enum ConDeserializeType *type, bool *same_token);
+static inline bool con_deserialize_internal_fill(struct ConDeserialize *context);
+static inline bool con_deserialize_internal_read(struct ConDeserialize *context, char *c);
+static inline bool con_deserialize_internal_skip_whitespace(struct ConDeserialize *context);
 static inline enum ConError con_deserialize_internal_next_character(struct ConDeserialize *context, char *c, bool *same_token);
+static inline enum ConError con_deserialize_key_separator(struct ConDeserialize *context);
+static inline enum ConError con_deserialize_number_get(struct ConDeserialize *context, struct GciInterfaceWriter writer, char const **view, size_t *view_size, struct ConDeserializeNumber *number);
+static inline enum ConError con_deserialize_number_parse(struct ConDeserialize *context, struct ConDeserializeNumber *number);
+static inline void con_deserialize_number_next(struct ConDeserializeNumber *number, enum StateNumber state, char c);
+static enum ConError con_deserialize_number_double(struct ConDeserializeNumber *number, double *value);
 static inline enum ConError con_deserialize_string_get(struct ConDeserialize *context, struct GciInterfaceWriter writer);
-static inline enum ConError con_deserialize_string_next(struct ConDeserialize *context, bool escaped, char *c, bool *is_u);
+static inline enum ConError con_deserialize_string_get_view(struct ConDeserialize *context, struct GciInterfaceWriter writer, char const **view, size_t *view_size);
+static inline enum ConError con_deserialize_string_body(struct ConDeserialize *context, struct GciInterfaceWriter writer);
+static inline enum ConError con_deserialize_string_run(struct ConDeserialize *context, struct GciInterfaceWriter writer);
+static inline enum ConError con_deserialize_string_next(struct ConDeserialize *context, bool escaped, char *c, size_t *length);
+static inline enum ConError con_deserialize_string_unicode(struct ConDeserialize *context, char *c, size_t *length);
+static inline enum ConError con_deserialize_string_hex(struct ConDeserialize *context, unsigned int *code_unit);
+static inline enum ConError con_deserialize_skip_string(struct ConDeserialize *context);
+static inline enum ConError con_deserialize_skip_container(struct ConDeserialize *context);
 
 enum ConError con_deserialize_init(struct ConDeserialize *context, struct GciInterfaceReader reader, enum ConContainer *depth_buffer, int depth_buffer_size) {
+    return con_deserialize_init_buffer(context, reader, depth_buffer, depth_buffer_size, NULL, 0);
+}
+
+enum ConError con_deserialize_init_buffer(
+    struct ConDeserialize *context,
+    struct GciInterfaceReader reader,
+    enum ConContainer *depth_buffer,
+    int depth_buffer_size,
+    char *read_buffer,
+    size_t read_buffer_size
+) {
     if (context == NULL) { return CON_ERROR_NULL; }
     if (depth_buffer == NULL && depth_buffer_size > 0) { return CON_ERROR_NULL; }
+    if (read_buffer == NULL && read_buffer_size > 0) { return CON_ERROR_NULL; }
     if (depth_buffer_size < 0) { return CON_ERROR_BUFFER; }
 
     context->reader = reader;
     context->depth = 0;
-    context->depth_buffer = depth_buffer;
-    context->depth_buffer_size = depth_buffer_size;
+    con_utils_depth_init(&context->depth_stack, depth_buffer, (size_t) depth_buffer_size);
+    context->read_buffer = read_buffer;
+    context->read_buffer_size = read_buffer_size;
+    context->read_buffer_length = 0;
+    context->read_buffer_offset = 0;
+    context->from_memory = false;
+    context->map = NULL;
+    context->release_offset = SIZE_MAX;
     context->buffer_char = EOF;
     context->state = con_utils_state_init();
     context->found_comma = false;
 
+    // A mapped file is already in memory, it is scanned in place as if it
+    // came from `con_deserialize_init_memory` instead of being copied. The
+    // pages which were scanned are released as reading goes on.
+    char const *data;
+    size_t data_size;
+    if (con_reader_map_take(reader, &data, &data_size)) {
+        context->read_buffer = (char*) data;
+        context->read_buffer_size = data_size;
+        context->read_buffer_length = data_size;
+        context->from_memory = true;
+        context->map = (struct ConReaderMap*) reader.context;
+        context->release_offset = con_reader_map_release_before(context->map, data);
+    }
+
     return CON_ERROR_OK;
 }
 
+static size_t con_deserialize_internal_read_empty(void const *context, char *buffer, size_t buffer_size) {
+    (void) context;
+    (void) buffer;
+    (void) buffer_size;
+    return 0;
+}
+
+enum ConError con_deserialize_init_memory(
+    struct ConDeserialize *context,
+    char const *data,
+    size_t data_size,
+    enum ConContainer *depth_buffer,
+    int depth_buffer_size
+) {
+    if (data == NULL && data_size > 0) { return CON_ERROR_NULL; }
+
+    struct GciInterfaceReader reader = { .context = NULL, .read = con_deserialize_internal_read_empty };
+
+    // The read buffer is never refilled when reading from memory, `data` is
+    // therefore only ever read from.
+    enum ConError err = con_deserialize_init_buffer(context, reader, depth_buffer, depth_buffer_size, (char*) data, data_size);
+    if (err) { return err; }
+
+    context->read_buffer_length = data_size;
+    context->from_memory = true;
+    return CON_ERROR_OK;
+}
+
+enum ConError con_deserialize_depth_allocator(struct ConDeserialize *context, struct ConInterfaceAllocator allocator) {
+    if (context == NULL) { return CON_ERROR_NULL; }
+    if (allocator.resize == NULL) { return CON_ERROR_NULL; }
+    return con_utils_depth_allocator(&context->depth_stack, allocator);
+}
+
+enum ConError con_deserialize_deinit(struct ConDeserialize *context) {
+    if (context == NULL) { return CON_ERROR_NULL; }
+    con_utils_depth_deinit(&context->depth_stack);
+    return CON_ERROR_OK;
+}
+
+static size_t con_deserialize_internal_write_empty(void const *context, char const *data, size_t data_size) {
+    (void) context;
+    (void) data;
+    return data_size;
+}
+
+// Narrows the range of matching keys by each byte written. The keys in the
+// range share their first `position` bytes and are sorted, so the keys with
+// `c` as their next byte are found by bisection.
+static size_t con_deserialize_internal_write_match(void const *context, char const *data, size_t data_size) {
+    struct ConDeserializeKeysMatch *match = (struct ConDeserializeKeysMatch*) context;
+    struct ConDeserializeKeys const *table = match->table;
+
+    for (size_t i = 0; i < data_size && match->low < match->high; i++) {
+        unsigned char c = (unsigned char) data[i];
+
+        if (c == '\0') {
+            match->high = match->low;  // keys are null terminated
+        } else if (match->position == 0) {
+            match->low = table->first[c];
+            match->high = table->first[c + 1];
+        } else if (match->high - match->low == 1) {
+            unsigned char expected = (unsigned char) table->keys[table->order[match->low]][match->position];
+            if (expected != c) { match->high = match->low; }
+        } else {
+            size_t low = match->low;
+            size_t high = match->high;
+            while (low < high) {
+                size_t middle = low + (high - low) / 2;
+                if ((unsigned char) table->keys[table->order[middle]][match->position] < c) {
+                    low = middle + 1;
+                } else {
+                    high = middle;
+                }
+            }
+            match->low = low;
+
+            high = match->high;
+            while (low < high) {
+                size_t middle = low + (high - low) / 2;
+                if ((unsigned char) table->keys[table->order[middle]][match->position] <= c) {
+                    low = middle + 1;
+                } else {
+                    high = middle;
+                }
+            }
+            match->high = low;
+        }
+
+        match->position += 1;
+    }
+
+    return data_size;
+}
+
 enum ConError con_deserialize_next(struct ConDeserialize *context, enum ConDeserializeType *type) {
     bool same_token;
     return con_deserialize_internal_next(context, type, &same_token);
@@ -42,16 +227,15 @@ enum ConError con_deserialize_array_open(struct ConDeserialize *context) {
     if (next_err) { return next_err; }
     if (next != CON_DESERIALIZE_TYPE_ARRAY_OPEN) { return CON_ERROR_TYPE; }
 
-    assert(context->depth_buffer_size >= 0);
-    assert(0 <= context->depth && context->depth <= (size_t) context->depth_buffer_size);
-    if (context->depth >= (size_t) context->depth_buffer_size) { return CON_ERROR_TOO_DEEP; }
+    assert(context->depth <= context->depth_stack.size);
+    enum ConError depth_err = con_utils_depth_reserve(&context->depth_stack, context->depth + 1);
+    if (depth_err) { return depth_err; }
 
     enum ConContainer current = con_deserialize_container_current(context);
     enum ConError state_err = con_utils_state_open(&context->state, current);
     if (state_err) { return state_err; }
 
-    assert(context->depth_buffer != NULL);
-    context->depth_buffer[context->depth] = CON_CONTAINER_ARRAY;
+    con_utils_depth_set(&context->depth_stack, context->depth, CON_CONTAINER_ARRAY);
     context->depth += 1;
 
     assert(context->buffer_char == '[');
@@ -74,8 +258,7 @@ enum ConError con_deserialize_array_close(struct ConDeserialize *context) {
     }
     if (next != CON_DESERIALIZE_TYPE_ARRAY_CLOSE) { return CON_ERROR_TYPE; }
 
-    assert(context->depth_buffer_size >= 0);
-    assert(0 <= context->depth && context->depth <= (size_t) context->depth_buffer_size);
+    assert(context->depth <= context->depth_stack.size);
     if (context->depth <= 0) { return CON_ERROR_CLOSED_TOO_MANY; }
     assert(current_state != CON_STATE_EMPTY);
 
@@ -106,16 +289,15 @@ enum ConError con_deserialize_dict_open(struct ConDeserialize *context) {
     if (next_err) { return next_err; }
     if (next != CON_DESERIALIZE_TYPE_DICT_OPEN) { return CON_ERROR_TYPE; }
 
-    assert(context->depth_buffer_size >= 0);
-    assert(0 <= context->depth && context->depth <= (size_t) context->depth_buffer_size);
-    if (context->depth >= (size_t) context->depth_buffer_size) { return CON_ERROR_TOO_DEEP; }
+    assert(context->depth <= context->depth_stack.size);
+    enum ConError depth_err = con_utils_depth_reserve(&context->depth_stack, context->depth + 1);
+    if (depth_err) { return depth_err; }
 
     enum ConContainer current = con_deserialize_container_current(context);
     enum ConError state_err = con_utils_state_open(&context->state, current);
     if (state_err) { return state_err; }
 
-    assert(context->depth_buffer != NULL);
-    context->depth_buffer[context->depth] = CON_CONTAINER_DICT;
+    con_utils_depth_set(&context->depth_stack, context->depth, CON_CONTAINER_DICT);
     context->depth += 1;
 
     assert(context->buffer_char == '{');
@@ -138,8 +320,7 @@ enum ConError con_deserialize_dict_close(struct ConDeserialize *context) {
     }
     if (next != CON_DESERIALIZE_TYPE_DICT_CLOSE) { return CON_ERROR_TYPE; }
 
-    assert(context->depth_buffer_size >= 0);
-    assert(0 <= context->depth && context->depth <= (size_t) context->depth_buffer_size);
+    assert(context->depth <= context->depth_stack.size);
     if (context->depth <= 0) { return CON_ERROR_CLOSED_TOO_MANY; }
     assert(current_state != CON_STATE_EMPTY);
 
@@ -177,20 +358,28 @@ enum ConError con_deserialize_dict_key(struct ConDeserialize *context, struct Gc
     enum ConError err = con_deserialize_string_get(context, writer);
     if (err) { return err; }
 
-    {
-        char c = '*';
-        bool same_token;
-        context->buffer_char = EOF;
-        enum ConError err = con_deserialize_internal_next_character(context, &c, &same_token);
-        if (err != CON_ERROR_OK && err != CON_ERROR_COMMA_MISSING) {
-            return err;
-        } else if (c != ':') {
-            return CON_ERROR_INVALID_JSON;  // Missing ':'
-        }
+    return con_deserialize_key_separator(context);
+}
 
-        context->buffer_char = EOF;
-    }
-    return CON_ERROR_OK;
+enum ConError con_deserialize_dict_key_view(struct ConDeserialize *context, char const **key, size_t *key_size, struct GciInterfaceWriter writer) {
+    assert(context != NULL);
+    if (key == NULL || key_size == NULL) { return CON_ERROR_NULL; }
+    *key = NULL;
+    *key_size = 0;
+
+    enum ConDeserializeType next;
+    enum ConError next_err = con_deserialize_next(context, &next);
+    if (next_err) { return next_err; }
+    if (next != CON_DESERIALIZE_TYPE_DICT_KEY) { return CON_ERROR_TYPE; }
+
+    enum ConContainer current = con_deserialize_container_current(context);
+    enum ConError state_err = con_utils_state_key(&context->state, current);
+    if (state_err) { return state_err; }
+
+    enum ConError err = con_deserialize_string_get_view(context, writer, key, key_size);
+    if (err) { return err; }
+
+    return con_deserialize_key_separator(context);
 }
 
 enum ConError con_deserialize_number(struct ConDeserialize *context, struct GciInterfaceWriter writer) {
@@ -205,47 +394,76 @@ enum ConError con_deserialize_number(struct ConDeserialize *context, struct GciI
     enum ConError state_err = con_utils_state_next(&context->state, current);
     if (state_err) { return state_err; }
 
-    enum StateNumber state = NUMBER_START;
+    return con_deserialize_number_get(context, writer, NULL, NULL, NULL);
+}
 
-    assert(context->buffer_char != EOF);
-    state = con_utils_state_number_next(state, (char) context->buffer_char);
-    assert(state != NUMBER_ERROR);
+enum ConError con_deserialize_number_view(struct ConDeserialize *context, char const **number, size_t *number_size, struct GciInterfaceWriter writer) {
+    assert(context != NULL);
+    if (number == NULL || number_size == NULL) { return CON_ERROR_NULL; }
+    *number = NULL;
+    *number_size = 0;
 
-    size_t amount_written = gci_writer_write(writer, (char*) &context->buffer_char, 1);
-    if (amount_written != 1) { return CON_ERROR_WRITER; }
+    enum ConDeserializeType next;
+    enum ConError next_err = con_deserialize_next(context, &next);
+    if (next_err) { return next_err; }
+    if (next != CON_DESERIALIZE_TYPE_NUMBER) { return CON_ERROR_TYPE; }
 
-    context->buffer_char = EOF;
-    while (true) {
-        char c = '*';
-        bool same_token = false;
-        context->buffer_char = EOF;
-        enum ConError err = con_deserialize_internal_next_character(context, &c, &same_token);
+    enum ConContainer current = con_deserialize_container_current(context);
+    enum ConError state_err = con_utils_state_next(&context->state, current);
+    if (state_err) { return state_err; }
 
-        if (err == CON_ERROR_READER && con_utils_state_number_terminal(state)) {
-            break;  // number may be done
-        } else if (err != CON_ERROR_OK && err != CON_ERROR_COMMA_MISSING) {
-            return err;
-        } else if (!same_token) {
-            break;  // number done
-        } else {
-            state = con_utils_state_number_next(state, c);
+    return con_deserialize_number_get(context, writer, number, number_size, NULL);
+}
 
-            if (state != NUMBER_ERROR) {
-                amount_written = gci_writer_write(writer, &c, 1);
-                if (amount_written != 1) { return CON_ERROR_WRITER; }
-            } else {
-                return CON_ERROR_INVALID_JSON;
-            }
-        }
-    }
+enum ConError con_deserialize_int64(struct ConDeserialize *context, int64_t *value) {
+    assert(context != NULL);
+    if (value == NULL) { return CON_ERROR_NULL; }
 
-    if (!con_utils_state_number_terminal(state)) {
-        return CON_ERROR_NOT_NUMBER;
+    struct ConDeserializeNumber number;
+    enum ConError err = con_deserialize_number_parse(context, &number);
+    if (err) { return err; }
+
+    if (number.fraction) { return CON_ERROR_TYPE; }
+    if (number.whole_overflow) { return CON_ERROR_OVERFLOW; }
+
+    if (!number.negative) {
+        if (number.whole > (uint64_t) INT64_MAX) { return CON_ERROR_OVERFLOW; }
+        *value = (int64_t) number.whole;
+    } else {
+        if (number.whole > (uint64_t) INT64_MAX + 1) { return CON_ERROR_OVERFLOW; }
+        *value = (int64_t) (0 - number.whole);
     }
 
     return CON_ERROR_OK;
 }
 
+enum ConError con_deserialize_uint64(struct ConDeserialize *context, uint64_t *value) {
+    assert(context != NULL);
+    if (value == NULL) { return CON_ERROR_NULL; }
+
+    struct ConDeserializeNumber number;
+    enum ConError err = con_deserialize_number_parse(context, &number);
+    if (err) { return err; }
+
+    if (number.fraction) { return CON_ERROR_TYPE; }
+    if (number.whole_overflow) { return CON_ERROR_OVERFLOW; }
+    if (number.negative && number.whole != 0) { return CON_ERROR_OVERFLOW; }
+
+    *value = number.whole;
+    return CON_ERROR_OK;
+}
+
+enum ConError con_deserialize_double(struct ConDeserialize *context, double *value) {
+    assert(context != NULL);
+    if (value == NULL) { return CON_ERROR_NULL; }
+
+    struct ConDeserializeNumber number;
+    enum ConError err = con_deserialize_number_parse(context, &number);
+    if (err) { return err; }
+
+    return con_deserialize_number_double(&number, value);
+}
+
 enum ConError con_deserialize_string(struct ConDeserialize *context, struct GciInterfaceWriter writer) {
     assert(context != NULL);
 
@@ -260,6 +478,24 @@ enum ConError con_deserialize_string(struct ConDeserialize *context, struct GciI
     return con_deserialize_string_get(context, writer);
 }
 
+enum ConError con_deserialize_string_view(struct ConDeserialize *context, char const **string, size_t *string_size, struct GciInterfaceWriter writer) {
+    assert(context != NULL);
+    if (string == NULL || string_size == NULL) { return CON_ERROR_NULL; }
+    *string = NULL;
+    *string_size = 0;
+
+    enum ConDeserializeType next;
+    enum ConError next_err = con_deserialize_next(context, &next);
+    if (next_err) { return next_err; }
+    if (next != CON_DESERIALIZE_TYPE_STRING) { return CON_ERROR_TYPE; }
+
+    enum ConContainer current = con_deserialize_container_current(context);
+    enum ConError state_err = con_utils_state_next(&context->state, current);
+    if (state_err) { return state_err; }
+
+    return con_deserialize_string_get_view(context, writer, string, string_size);
+}
+
 enum ConError con_deserialize_bool(struct ConDeserialize *context, bool *value) {
     assert(context != NULL);
 
@@ -368,6 +604,138 @@ enum ConError con_deserialize_null(struct ConDeserialize *context) {
     return CON_ERROR_OK;
 }
 
+enum ConError con_deserialize_skip(struct ConDeserialize *context) {
+    assert(context != NULL);
+
+    enum ConDeserializeType next;
+    enum ConError next_err = con_deserialize_next(context, &next);
+    if (next_err) { return next_err; }
+
+    switch (next) {
+        case CON_DESERIALIZE_TYPE_NUMBER: {
+            struct GciInterfaceWriter writer = { .context = NULL, .write = con_deserialize_internal_write_empty };
+            return con_deserialize_number(context, writer);
+        }
+        case CON_DESERIALIZE_TYPE_BOOL: {
+            bool value;
+            return con_deserialize_bool(context, &value);
+        }
+        case CON_DESERIALIZE_TYPE_NULL:
+            return con_deserialize_null(context);
+        case CON_DESERIALIZE_TYPE_STRING:
+        case CON_DESERIALIZE_TYPE_DICT_KEY:
+        case CON_DESERIALIZE_TYPE_ARRAY_OPEN:
+        case CON_DESERIALIZE_TYPE_DICT_OPEN:
+            break;
+        default:
+            return CON_ERROR_TYPE;
+    }
+
+    // A key is rejected here, the container is consumed as a single value so
+    // neither the depth nor the depth buffer change.
+    enum ConContainer current = con_deserialize_container_current(context);
+    enum ConError state_err = con_utils_state_next(&context->state, current);
+    if (state_err) { return state_err; }
+
+    assert(context->buffer_char == '"' || context->buffer_char == '[' || context->buffer_char == '{');
+    bool is_string = context->buffer_char == '"';
+    context->buffer_char = EOF;
+
+    if (is_string) {
+        return con_deserialize_skip_string(context);
+    } else {
+        return con_deserialize_skip_container(context);
+    }
+}
+
+enum ConError con_deserialize_record(struct ConDeserialize *context, bool *found) {
+    assert(context != NULL);
+    if (found == NULL) { return CON_ERROR_NULL; }
+    if (context->state != CON_STATE_EMPTY && context->state != CON_STATE_COMPLETE) { return CON_ERROR_INCOMPLETE; }
+    assert(context->depth == 0);
+
+    // Only the state is reset, the read buffer and any character read past the
+    // end of the previous element are kept.
+    context->state = con_utils_state_init();
+    context->found_comma = false;
+
+    if (context->buffer_char != EOF && !isspace((unsigned char) context->buffer_char)) {
+        *found = true;
+        return CON_ERROR_OK;
+    }
+
+    char next;
+    do {
+        context->buffer_char = EOF;
+        con_deserialize_internal_skip_whitespace(context);
+
+        if (!con_deserialize_internal_read(context, &next)) {
+            *found = false;
+            return CON_ERROR_OK;
+        }
+        context->buffer_char = next;
+    } while (isspace((unsigned char) next));
+
+    *found = true;
+    return CON_ERROR_OK;
+}
+
+enum ConError con_deserialize_keys_init(struct ConDeserializeKeys *table, char const *const *keys, size_t *order, size_t keys_size) {
+    if (table == NULL) { return CON_ERROR_NULL; }
+    if ((keys == NULL || order == NULL) && keys_size > 0) { return CON_ERROR_NULL; }
+    for (size_t i = 0; i < keys_size; i++) {
+        if (keys[i] == NULL) { return CON_ERROR_NULL; }
+    }
+
+    // Tables are small and built once, a stable insertion sort keeps the first
+    // of several equal keys first. `strcmp` compares bytes as unsigned char
+    // which `first` relies on.
+    for (size_t i = 0; i < keys_size; i++) {
+        size_t j = i;
+        while (j > 0 && strcmp(keys[order[j - 1]], keys[i]) > 0) {
+            order[j] = order[j - 1];
+            j -= 1;
+        }
+        order[j] = i;
+    }
+
+    size_t k = 0;
+    for (size_t c = 0; c <= UCHAR_MAX; c++) {
+        while (k < keys_size && (unsigned char) keys[order[k]][0] < c) { k += 1; }
+        table->first[c] = k;
+    }
+    table->first[UCHAR_MAX + 1] = keys_size;
+
+    table->keys = keys;
+    table->keys_size = keys_size;
+    table->order = order;
+    return CON_ERROR_OK;
+}
+
+enum ConError con_deserialize_dict_key_match(struct ConDeserialize *context, struct ConDeserializeKeys const *table, size_t *index) {
+    assert(context != NULL);
+    if (table == NULL || index == NULL) { return CON_ERROR_NULL; }
+    *index = CON_DESERIALIZE_KEY_UNKNOWN;
+
+    struct ConDeserializeKeysMatch match = {
+        .table = table,
+        .low = 0,
+        .high = table->keys_size,
+        .position = 0,
+    };
+    struct GciInterfaceWriter writer = { .context = &match, .write = con_deserialize_internal_write_match };
+
+    enum ConError err = con_deserialize_dict_key(context, writer);
+    if (err) { return err; }
+
+    if (match.low < match.high && table->keys[table->order[match.low]][match.position] == '\0') {
+        *index = table->order[match.low];
+        return CON_ERROR_OK;
+    }
+
+    return con_deserialize_skip(context);
+}
+
 enum ConError con_deserialize_internal_next(struct ConDeserialize *context, enum ConDeserializeType *type, bool *same_token) {
     assert(context != NULL);
     if (type == NULL) { return CON_ERROR_NULL; }
@@ -431,9 +799,12 @@ static inline enum ConError con_deserialize_internal_next_character(struct ConDe
         while (true) {
             context->buffer_char = EOF;
 
+            if (con_deserialize_internal_skip_whitespace(context)) {
+                *same_token = false;
+            }
+
             char next;
-            size_t length = gci_reader_read(context->reader, &next, 1);
-            if (length != 1) {
+            if (!con_deserialize_internal_read(context, &next)) {
                 return CON_ERROR_READER;
             }
             context->buffer_char = next;
@@ -475,6 +846,307 @@ static inline enum ConError con_deserialize_internal_next_character(struct ConDe
     return CON_ERROR_OK;
 }
 
+// Hands the pages of the mapping which were consumed back to the os.
+static void con_deserialize_internal_release(struct ConDeserialize *context) {
+    assert(context != NULL);
+    assert(context->map != NULL);
+
+    char const *position = context->read_buffer + context->read_buffer_offset;
+    context->release_offset = context->read_buffer_offset + con_reader_map_release_before(context->map, position);
+}
+
+static inline bool con_deserialize_internal_fill(struct ConDeserialize *context) {
+    assert(context != NULL);
+    assert(context->read_buffer_size > 0);
+    assert(context->read_buffer != NULL);
+    assert(context->read_buffer_offset <= context->read_buffer_length);
+
+    if (context->read_buffer_offset >= context->release_offset) {
+        con_deserialize_internal_release(context);
+    }
+
+    if (context->read_buffer_offset < context->read_buffer_length) { return true; }
+    if (context->from_memory) { return false; }
+
+    size_t length = gci_reader_read(context->reader, context->read_buffer, context->read_buffer_size);
+    assert(length <= context->read_buffer_size);
+
+    context->read_buffer_length = length;
+    context->read_buffer_offset = 0;
+    return length > 0;
+}
+
+static inline bool con_deserialize_internal_read(struct ConDeserialize *context, char *c) {
+    assert(context != NULL);
+    assert(c != NULL);
+
+    if (context->read_buffer_size == 0) {
+        size_t length = gci_reader_read(context->reader, c, 1);
+        return length == 1;
+    }
+
+    if (!con_deserialize_internal_fill(context)) { return false; }
+
+    *c = context->read_buffer[context->read_buffer_offset];
+    context->read_buffer_offset += 1;
+    return true;
+}
+
+static inline bool con_deserialize_internal_skip_whitespace(struct ConDeserialize *context) {
+    assert(context != NULL);
+    if (context->read_buffer_size == 0) { return false; }
+
+    assert(context->read_buffer != NULL);
+    assert(context->read_buffer_offset <= context->read_buffer_length);
+    size_t length = con_utils_whitespace_skip(
+        context->read_buffer + context->read_buffer_offset,
+        context->read_buffer_length - context->read_buffer_offset
+    );
+
+    context->read_buffer_offset += length;
+    return length > 0;
+}
+
+static inline enum ConError con_deserialize_key_separator(struct ConDeserialize *context) {
+    assert(context != NULL);
+
+    char c = '*';
+    bool same_token;
+    context->buffer_char = EOF;
+    enum ConError err = con_deserialize_internal_next_character(context, &c, &same_token);
+    if (err != CON_ERROR_OK && err != CON_ERROR_COMMA_MISSING) {
+        return err;
+    } else if (c != ':') {
+        return CON_ERROR_INVALID_JSON;  // Missing ':'
+    }
+
+    context->buffer_char = EOF;
+    return CON_ERROR_OK;
+}
+
+static inline enum ConError con_deserialize_number_get(struct ConDeserialize *context, struct GciInterfaceWriter writer, char const **view, size_t *view_size, struct ConDeserializeNumber *number) {
+    assert(context != NULL);
+
+    enum StateNumber state = NUMBER_START;
+
+    assert(context->buffer_char != EOF);
+    state = con_utils_state_number_next(state, (char) context->buffer_char);
+    assert(state != NUMBER_ERROR);
+
+    size_t amount_written;
+    if (view != NULL && context->from_memory) {
+        // The whole input is in the read buffer, the number ends at the first
+        // character which is not part of it and can be referred to directly.
+        assert(context->read_buffer_offset > 0);
+        assert(context->read_buffer[context->read_buffer_offset - 1] == (char) context->buffer_char);
+        char const *start = context->read_buffer + context->read_buffer_offset - 1;
+        size_t length = 1;
+
+        while (context->read_buffer_offset < context->read_buffer_length) {
+            enum StateNumber next = con_utils_state_number_next(state, context->read_buffer[context->read_buffer_offset]);
+            if (next == NUMBER_ERROR) { break; }
+
+            state = next;
+            context->read_buffer_offset += 1;
+            length += 1;
+        }
+
+        *view = start;
+        *view_size = length;
+    } else if (number != NULL) {
+        con_deserialize_number_next(number, state, (char) context->buffer_char);
+    } else {
+        amount_written = gci_writer_write(writer, (char*) &context->buffer_char, 1);
+        if (amount_written != 1) { return CON_ERROR_WRITER; }
+    }
+
+    context->buffer_char = EOF;
+    while (true) {
+        char c = '*';
+        bool same_token = false;
+        context->buffer_char = EOF;
+        enum ConError err = con_deserialize_internal_next_character(context, &c, &same_token);
+
+        if (err == CON_ERROR_READER && con_utils_state_number_terminal(state)) {
+            break;  // number may be done
+        } else if (err != CON_ERROR_OK && err != CON_ERROR_COMMA_MISSING) {
+            return err;
+        } else if (!same_token) {
+            break;  // number done
+        } else {
+            state = con_utils_state_number_next(state, c);
+
+            if (state == NUMBER_ERROR) {
+                return CON_ERROR_INVALID_JSON;
+            } else if (number != NULL) {
+                con_deserialize_number_next(number, state, c);
+            } else {
+                amount_written = gci_writer_write(writer, &c, 1);
+                if (amount_written != 1) { return CON_ERROR_WRITER; }
+            }
+        }
+    }
+
+    if (!con_utils_state_number_terminal(state)) {
+        return CON_ERROR_NOT_NUMBER;
+    }
+
+    return CON_ERROR_OK;
+}
+
+static inline enum ConError con_deserialize_number_parse(struct ConDeserialize *context, struct ConDeserializeNumber *number) {
+    assert(context != NULL);
+    assert(number != NULL);
+
+    enum ConDeserializeType next;
+    enum ConError next_err = con_deserialize_next(context, &next);
+    if (next_err) { return next_err; }
+    if (next != CON_DESERIALIZE_TYPE_NUMBER) { return CON_ERROR_TYPE; }
+
+    enum ConContainer current = con_deserialize_container_current(context);
+    enum ConError state_err = con_utils_state_next(&context->state, current);
+    if (state_err) { return state_err; }
+
+    number->negative = false;
+    number->fraction = false;
+    number->whole = 0;
+    number->whole_overflow = false;
+    number->digits_length = 0;
+    number->digits_truncated = false;
+    number->scale = 0;
+    number->exponent = 0;
+    number->exponent_negative = false;
+
+    struct GciInterfaceWriter writer = { .context = NULL, .write = NULL };
+    return con_deserialize_number_get(context, writer, NULL, NULL, number);
+}
+
+static inline void con_deserialize_number_next(struct ConDeserializeNumber *number, enum StateNumber state, char c) {
+    assert(number != NULL);
+
+    switch (state) {
+        case (NUMBER_NEGATIVE):
+            number->negative = true;
+            break;
+        case (NUMBER_ZERO):
+        case (NUMBER_WHOLE): {
+            uint64_t digit = (uint64_t) (c - '0');
+            if (number->whole > (UINT64_MAX - digit) / 10) {
+                number->whole_overflow = true;
+            } else {
+                number->whole = 10 * number->whole + digit;
+            }
+
+            if (number->digits_length == 0 && c == '0') {
+                break;  // leading zero
+            } else if (number->digits_length < CON_DESERIALIZE_NUMBER_DIGITS) {
+                number->digits[number->digits_length++] = c;
+            } else {
+                number->digits_truncated |= c != '0';
+                number->scale += 1;
+            }
+            break;
+        }
+        case (NUMBER_POINT):
+        case (NUMBER_E):
+            number->fraction = true;
+            break;
+        case (NUMBER_FRACTION):
+            if (number->digits_length == 0 && c == '0') {
+                number->scale -= 1;
+            } else if (number->digits_length < CON_DESERIALIZE_NUMBER_DIGITS) {
+                number->digits[number->digits_length++] = c;
+                number->scale -= 1;
+            } else {
+                number->digits_truncated |= c != '0';
+            }
+            break;
+        case (NUMBER_EXPONENT_SIGN):
+            number->exponent_negative = c == '-';
+            break;
+        case (NUMBER_EXPONENT):
+            if (number->exponent < CON_DESERIALIZE_NUMBER_EXPONENT_MAX) {
+                number->exponent = 10 * number->exponent + (c - '0');
+            }
+            break;
+        default:
+            assert(false);
+    }
+}
+
+static enum ConError con_deserialize_number_double(struct ConDeserializeNumber *number, double *value) {
+    assert(number != NULL);
+    assert(value != NULL);
+
+    double sign = number->negative ? -1.0 : 1.0;
+    if (number->digits_length == 0) {
+        *value = sign * 0.0;
+        return CON_ERROR_OK;
+    }
+
+    int64_t exponent = number->scale + (number->exponent_negative ? -number->exponent : number->exponent);
+    int64_t length = (int64_t) number->digits_length;
+
+    // Fast path: the digits and the power of ten are both exact doubles, so a
+    // single correctly rounded multiplication or division gives the result.
+    if (FLT_EVAL_METHOD == 0 && !number->digits_truncated && number->digits_length <= 19) {
+        static double const powers[] = {
+            1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+            1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+            1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+        };
+        uint64_t const exact_max = (uint64_t) 1 << 53;
+
+        uint64_t mantissa = 0;
+        for (size_t i = 0; i < number->digits_length; i++) {
+            mantissa = 10 * mantissa + (uint64_t) (number->digits[i] - '0');
+        }
+
+        int64_t power = exponent;
+        while (power > 22 && mantissa <= exact_max / 10) {
+            mantissa *= 10;
+            power -= 1;
+        }
+
+        if (mantissa <= exact_max && -22 <= power && power <= 22) {
+            double result = (double) mantissa;
+            if (power < 0) {
+                result /= powers[-power];
+            } else {
+                result *= powers[power];
+            }
+
+            *value = sign * result;
+            return CON_ERROR_OK;
+        }
+    }
+
+    // The value lies in [10^(length + exponent - 1), 10^(length + exponent)),
+    // the smallest subnormal double is about 4.9e-324.
+    if (length + exponent - 1 > DBL_MAX_10_EXP) {
+        return CON_ERROR_OVERFLOW;
+    }
+    if (length + exponent < -324) {
+        *value = sign * 0.0;
+        return CON_ERROR_OK;
+    }
+
+    // Exact fallback. The text is written without a decimal point so the
+    // conversion does not depend on the current locale.
+    size_t size = number->digits_length;
+    if (number->digits_truncated) {
+        number->digits[size++] = '1';
+        exponent -= 1;
+    }
+    snprintf(number->digits + size, sizeof(number->digits) - size, "e%ld", (long) exponent);
+
+    double result = strtod(number->digits, NULL);
+    if (isinf(result)) { return CON_ERROR_OVERFLOW; }
+
+    *value = sign * result;
+    return CON_ERROR_OK;
+}
+
 static inline enum ConError con_deserialize_string_get(struct ConDeserialize *context, struct GciInterfaceWriter writer) {
     assert(context != NULL);
 
@@ -482,11 +1154,48 @@ static inline enum ConError con_deserialize_string_get(struct ConDeserialize *co
     assert(context->buffer_char == '"');
     context->buffer_char = EOF;
 
+    return con_deserialize_string_body(context, writer);
+}
+
+static inline enum ConError con_deserialize_string_get_view(struct ConDeserialize *context, struct GciInterfaceWriter writer, char const **view, size_t *view_size) {
+    assert(context != NULL);
+    assert(view != NULL);
+    assert(view_size != NULL);
+
+    assert(context->buffer_char != EOF);
+    assert(context->buffer_char == '"');
+    context->buffer_char = EOF;
+
+    if (context->from_memory) {
+        char const *start = context->read_buffer + context->read_buffer_offset;
+        size_t available = context->read_buffer_length - context->read_buffer_offset;
+        size_t length = con_utils_string_span(start, available);
+
+        if (length < available && start[length] == '"') {
+            context->read_buffer_offset += length + 1;
+            *view = start;
+            *view_size = length;
+            return CON_ERROR_OK;
+        }
+    }
+
+    // String contains escapes or is not fully contained in the read buffer
+    return con_deserialize_string_body(context, writer);
+}
+
+static inline enum ConError con_deserialize_string_body(struct ConDeserialize *context, struct GciInterfaceWriter writer) {
+    assert(context != NULL);
+
     bool escaped = false;
     while (true) {
-        bool is_u;
-        char c[2];
-        enum ConError err = con_deserialize_string_next(context, escaped, c, &is_u);
+        if (!escaped && context->read_buffer_size > 0) {
+            enum ConError err = con_deserialize_string_run(context, writer);
+            if (err) { return err; }
+        }
+
+        size_t length;
+        char c[4];
+        enum ConError err = con_deserialize_string_next(context, escaped, c, &length);
         if (err) { return err; }
 
         if (*c == '"' && !escaped) {
@@ -495,18 +1204,40 @@ static inline enum ConError con_deserialize_string_get(struct ConDeserialize *co
             escaped = true;
         } else {
             escaped = false;
-            size_t amount_written = gci_writer_write(writer, c, 1 + is_u);
-            if (amount_written != 1 + is_u) { return CON_ERROR_WRITER; }
+            size_t amount_written = gci_writer_write(writer, c, length);
+            if (amount_written != length) { return CON_ERROR_WRITER; }
+        }
+    }
+
+    return CON_ERROR_OK;
+}
+
+// Writes characters from the read buffer up until the next `"` or `\` with a
+// single write, the character which ends the run is left in the read buffer.
+static inline enum ConError con_deserialize_string_run(struct ConDeserialize *context, struct GciInterfaceWriter writer) {
+    assert(context != NULL);
+    assert(context->read_buffer_size > 0);
+
+    while (con_deserialize_internal_fill(context)) {
+        char const *start = context->read_buffer + context->read_buffer_offset;
+        size_t available = context->read_buffer_length - context->read_buffer_offset;
+        size_t length = con_utils_string_span(start, available);
+
+        if (length > 0) {
+            context->read_buffer_offset += length;
+            size_t amount_written = gci_writer_write(writer, start, length);
+            if (amount_written != length) { return CON_ERROR_WRITER; }
         }
+
+        if (length < available) { break; }
     }
 
     return CON_ERROR_OK;
 }
 
-static inline enum ConError con_deserialize_string_next(struct ConDeserialize *context, bool escaped, char *c, bool *is_u) {
-    size_t length = gci_reader_read(context->reader, c, 1);
-    if (length != 1) { return CON_ERROR_READER; }
-    *is_u = false;
+static inline enum ConError con_deserialize_string_next(struct ConDeserialize *context, bool escaped, char *c, size_t *length) {
+    if (!con_deserialize_internal_read(context, c)) { return CON_ERROR_READER; }
+    *length = 1;
 
     if (escaped) {
         switch (*c) {
@@ -531,68 +1262,8 @@ static inline enum ConError con_deserialize_string_next(struct ConDeserialize *c
             case 't':
                 *c = '\t';
                 break;
-            case 'u': {
-                *is_u = true;
-
-                for (int i = 0; i < 2; i++) {
-                    for (int j = 0; j < 2; j++) {
-                        char d;
-                        size_t length = gci_reader_read(context->reader, &d, 1);
-                        if (length != 1) { return CON_ERROR_READER; }
-                        if (!isxdigit((unsigned char) d)) { return CON_ERROR_INVALID_JSON; }
-
-                        // Here we convert a hex digit to a number in a complicated way:
-                        // '0' to '9' are guaranteed to be contiguous, i.e. d - '0' results
-                        // in the correct value. Alas 'a' to 'f' and 'A' to 'F' are not
-                        // guaranteed to be contiguous by the C standard which means that
-                        // if we know that d is lower case then 10 + d - 'a' is not guaranteed
-                        // to equal the value we're looking for...
-                        switch (d) {
-                            case '0':
-                            case '1':
-                            case '2':
-                            case '3':
-                            case '4':
-                            case '5':
-                            case '6':
-                            case '7':
-                            case '8':
-                            case '9':
-                                d -= '0';
-                                break;
-                            case 'a':
-                            case 'A':
-                                d = 10;
-                                break;
-                            case 'b':
-                            case 'B':
-                                d = 11;
-                                break;
-                            case 'c':
-                            case 'C':
-                                d = 12;
-                                break;
-                            case 'd':
-                            case 'D':
-                                d = 13;
-                                break;
-                            case 'e':
-                            case 'E':
-                                d = 14;
-                                break;
-                            case 'f':
-                            case 'F':
-                                d = 15;
-                                break;
-                            default:
-                                assert(false);
-                        }
-
-                        c[i] = 16 * c[i] + d;
-                    }
-                }
-                break;
-            }
+            case 'u':
+                return con_deserialize_string_unicode(context, c, length);
             default:
                 return CON_ERROR_INVALID_JSON;
         }
@@ -601,9 +1272,122 @@ static inline enum ConError con_deserialize_string_next(struct ConDeserialize *c
     return CON_ERROR_OK;
 }
 
+// Decodes the rest of a `\uXXXX` escape, and the low surrogate following it if
+// it is a high surrogate, to 1 to 4 bytes of UTF-8.
+static inline enum ConError con_deserialize_string_unicode(struct ConDeserialize *context, char *c, size_t *length) {
+    assert(context != NULL);
+    assert(c != NULL);
+    assert(length != NULL);
+
+    unsigned int code_point;
+    enum ConError err = con_deserialize_string_hex(context, &code_point);
+    if (err) { return err; }
+
+    if (0xDC00 <= code_point && code_point <= 0xDFFF) {
+        return CON_ERROR_SURROGATE;  // low surrogate without high surrogate
+    } else if (0xD800 <= code_point && code_point <= 0xDBFF) {
+        char escape[2];
+        if (!con_deserialize_internal_read(context, &escape[0])) { return CON_ERROR_READER; }
+        if (escape[0] != '\\') { return CON_ERROR_SURROGATE; }
+        if (!con_deserialize_internal_read(context, &escape[1])) { return CON_ERROR_READER; }
+        if (escape[1] != 'u') { return CON_ERROR_SURROGATE; }
+
+        unsigned int low;
+        err = con_deserialize_string_hex(context, &low);
+        if (err) { return err; }
+        if (low < 0xDC00 || 0xDFFF < low) { return CON_ERROR_SURROGATE; }
+
+        code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+    }
+
+    *length = con_utils_utf8_encode(c, code_point);
+    return CON_ERROR_OK;
+}
+
+static inline enum ConError con_deserialize_string_hex(struct ConDeserialize *context, unsigned int *code_unit) {
+    assert(context != NULL);
+    assert(code_unit != NULL);
+
+    *code_unit = 0;
+    for (int i = 0; i < 4; i++) {
+        char d;
+        if (!con_deserialize_internal_read(context, &d)) { return CON_ERROR_READER; }
+
+        unsigned int digit = con_utils_hex_digit(d);
+        if (digit == 0) { return CON_ERROR_INVALID_JSON; }
+        *code_unit = 16 * *code_unit + digit - 1;
+    }
+
+    return CON_ERROR_OK;
+}
+
 static inline enum ConContainer con_deserialize_container_current(struct ConDeserialize *context) {
     assert(context != NULL);
-    assert(context->depth_buffer_size >= 0);
-    size_t size = (size_t) context->depth_buffer_size;
-    return con_utils_container_current(context->depth_buffer, size, context->depth);
+    return con_utils_depth_current(&context->depth_stack, context->depth);
+}
+
+// Consumes the rest of a string up to and including the closing `"`, escape
+// sequences are stepped over without being decoded.
+static inline enum ConError con_deserialize_skip_string(struct ConDeserialize *context) {
+    assert(context != NULL);
+
+    bool escaped = false;
+    while (true) {
+        if (!escaped && context->read_buffer_size > 0) {
+            while (con_deserialize_internal_fill(context)) {
+                char const *start = context->read_buffer + context->read_buffer_offset;
+                size_t available = context->read_buffer_length - context->read_buffer_offset;
+                size_t length = con_utils_string_span(start, available);
+
+                context->read_buffer_offset += length;
+                if (length < available) { break; }
+            }
+        }
+
+        char c;
+        if (!con_deserialize_internal_read(context, &c)) { return CON_ERROR_READER; }
+
+        if (escaped) {
+            escaped = false;
+        } else if (c == '"') {
+            return CON_ERROR_OK;
+        } else if (c == '\\') {
+            escaped = true;
+        }
+    }
+}
+
+// Consumes the rest of a container up to and including the bracket closing
+// it. Only brackets outside of strings are counted, anything else is stepped
+// over without being validated.
+static inline enum ConError con_deserialize_skip_container(struct ConDeserialize *context) {
+    assert(context != NULL);
+
+    size_t depth = 1;
+    while (depth > 0) {
+        if (context->read_buffer_size > 0) {
+            while (con_deserialize_internal_fill(context)) {
+                char const *start = context->read_buffer + context->read_buffer_offset;
+                size_t available = context->read_buffer_length - context->read_buffer_offset;
+                size_t length = con_utils_structure_span(start, available);
+
+                context->read_buffer_offset += length;
+                if (length < available) { break; }
+            }
+        }
+
+        char c;
+        if (!con_deserialize_internal_read(context, &c)) { return CON_ERROR_READER; }
+
+        if (c == '"') {
+            enum ConError err = con_deserialize_skip_string(context);
+            if (err) { return err; }
+        } else if (c == '[' || c == '{') {
+            depth += 1;
+        } else if (c == ']' || c == '}') {
+            depth -= 1;
+        }
+    }
+
+    return CON_ERROR_OK;
 }
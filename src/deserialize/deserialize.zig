@@ -16,8 +16,120 @@ pub const Type = enum {
     dict_key,
 };
 
+pub const Keys = struct {
+    inner: lib.ConDeserializeKeys,
+
+    pub fn init(keys: []const [*:0]const u8, order: []usize) !Keys {
+        if (order.len < keys.len) {
+            return error.Buffer;
+        }
+
+        var table = Keys{ .inner = undefined };
+        const err = lib.con_deserialize_keys_init(&table.inner, @ptrCast(keys.ptr), order.ptr, keys.len);
+
+        try internal.enumToError(err);
+        return table;
+    }
+};
+
+// Table of the field names of `T`, sorted at compile time so it is ready for
+// `con_deserialize_dict_key_match` without `con_deserialize_keys_init`.
+fn fieldKeys(comptime T: type) lib.ConDeserializeKeys {
+    comptime {
+        const fields = std.meta.fields(T);
+        @setEvalBranchQuota(10 * fields.len * fields.len + 2000);
+
+        var names: [fields.len][*c]const u8 = undefined;
+        var order: [fields.len]usize = undefined;
+        for (fields, 0..) |field, i| {
+            names[i] = field.name.ptr;
+
+            var j = i;
+            while (j > 0 and std.mem.order(u8, fields[order[j - 1]].name, field.name) == .gt) : (j -= 1) {
+                order[j] = order[j - 1];
+            }
+            order[j] = i;
+        }
+
+        // An empty name starts with its null terminator.
+        var first: std.meta.FieldType(lib.ConDeserializeKeys, .first) = undefined;
+        var k: usize = 0;
+        for (0..first.len - 1) |c| {
+            while (k < fields.len and names[order[k]][0] < c) {
+                k += 1;
+            }
+            first[c] = k;
+        }
+        first[first.len - 1] = fields.len;
+
+        const final_names = names;
+        const final_order = order;
+        return .{
+            .keys = &final_names,
+            .keys_size = fields.len,
+            .order = &final_order,
+            .first = first,
+        };
+    }
+}
+
+// Writer collecting a string into an `std.ArrayList(u8)`, remembers if it ran
+// out of memory since the library only sees a failed write.
+const StringWriter = struct {
+    list: std.ArrayList(u8),
+    out_of_memory: bool = false,
+
+    fn write(context: ?*const anyopaque, data: [*c]const u8, data_size: usize) callconv(.C) usize {
+        const self: *StringWriter = @ptrCast(@alignCast(@constCast(context.?)));
+        self.list.appendSlice(data[0..data_size]) catch {
+            self.out_of_memory = true;
+            return 0;
+        };
+        return data_size;
+    }
+
+    fn interface(self: *StringWriter) lib.GciInterfaceWriter {
+        return .{ .context = self, .write = &write };
+    }
+};
+
+// Writer keeping at most `size` bytes of a string, used to compare it to names
+// known at compile time. Longer strings cannot match so they are only flagged.
+fn NameWriter(comptime size: usize) type {
+    return struct {
+        const Self = @This();
+
+        buffer: [size]u8 = undefined,
+        length: usize = 0,
+        too_long: bool = false,
+
+        fn write(context: ?*const anyopaque, data: [*c]const u8, data_size: usize) callconv(.C) usize {
+            const self: *Self = @ptrCast(@alignCast(@constCast(context.?)));
+            if (data_size > size - self.length) {
+                self.too_long = true;
+            } else {
+                @memcpy(self.buffer[self.length .. self.length + data_size], data[0..data_size]);
+                self.length += data_size;
+            }
+            return data_size;
+        }
+
+        fn interface(self: *Self) lib.GciInterfaceWriter {
+            return .{ .context = self, .write = &write };
+        }
+
+        fn name(self: *const Self) ?[]const u8 {
+            if (self.too_long) {
+                return null;
+            }
+            return self.buffer[0..self.length];
+        }
+    };
+}
+
 pub const Deserialize = struct {
     inner: lib.ConDeserialize,
+    allocator: std.mem.Allocator = undefined,
 
     pub fn init(reader: gci.InterfaceReader, depth: []zcon.Container) !Deserialize {
         if (depth.len > std.math.maxInt(c_int)) {
@@ -36,6 +148,59 @@ pub const Deserialize = struct {
         return context;
     }
 
+    pub fn initBuffer(reader: gci.InterfaceReader, depth: []zcon.Container, buffer: []u8) !Deserialize {
+        if (depth.len > std.math.maxInt(c_int)) {
+            return error.Overflow;
+        }
+
+        var context = Deserialize{ .inner = undefined };
+        const err = lib.con_deserialize_init_buffer(
+            &context.inner,
+            @as(*lib.GciInterfaceReader, @ptrCast(@constCast(&reader.reader))).*,
+            depth.ptr,
+            @intCast(depth.len),
+            buffer.ptr,
+            buffer.len,
+        );
+
+        try internal.enumToError(err);
+        return context;
+    }
+
+    pub fn initMemory(data: []const u8, depth: []zcon.Container) !Deserialize {
+        if (depth.len > std.math.maxInt(c_int)) {
+            return error.Overflow;
+        }
+
+        var context = Deserialize{ .inner = undefined };
+        const err = lib.con_deserialize_init_memory(
+            &context.inner,
+            data.ptr,
+            data.len,
+            depth.ptr,
+            @intCast(depth.len),
+        );
+
+        try internal.enumToError(err);
+        return context;
+    }
+
+    // Lets the depth stack grow with `allocator`, see
+    // `con_deserialize_depth_allocator`. Memory is freed by `deinit`. The
+    // allocator is stored in `self` and the C context points at it, so `self`
+    // must not be moved or copied after this call.
+    pub fn depthAllocator(self: *Deserialize, allocator: std.mem.Allocator) !void {
+        self.allocator = allocator;
+        const err = lib.con_deserialize_depth_allocator(&self.inner, internal.allocatorInterface(&self.allocator));
+        return internal.enumToError(err);
+    }
+
+    pub fn deinit(self: Deserialize) void {
+        var inner = self.inner;
+        const err = lib.con_deserialize_deinit(&inner);
+        std.debug.assert(err == lib.CON_ERROR_OK);
+    }
+
     pub fn next(self: *Deserialize) !Type {
         var token_type: lib.ConDeserializeType = undefined;
         const err = lib.con_deserialize_next(&self.inner, &token_type);
@@ -80,16 +245,199 @@ pub const Deserialize = struct {
         return internal.enumToError(err);
     }
 
+    pub fn dictKeyView(self: *Deserialize, writer: gci.InterfaceWriter) !?[]const u8 {
+        var key: [*c]const u8 = undefined;
+        var key_size: usize = undefined;
+        const err = lib.con_deserialize_dict_key_view(&self.inner, &key, &key_size, @as(*lib.GciInterfaceWriter, @ptrCast(@constCast(&writer.writer))).*);
+        try internal.enumToError(err);
+
+        if (key == null) {
+            return null;
+        }
+        return key[0..key_size];
+    }
+
+    pub fn dictKeyMatch(self: *Deserialize, keys: *const Keys) !?usize {
+        var index: usize = undefined;
+        const err = lib.con_deserialize_dict_key_match(&self.inner, &keys.inner, &index);
+        try internal.enumToError(err);
+
+        if (index == std.math.maxInt(usize)) {
+            return null;
+        }
+        return index;
+    }
+
     pub fn number(self: *Deserialize, writer: gci.InterfaceWriter) !void {
         const err = lib.con_deserialize_number(&self.inner, @as(*lib.GciInterfaceWriter, @ptrCast(@constCast(&writer.writer))).*);
         return internal.enumToError(err);
     }
 
+    pub fn numberView(self: *Deserialize, writer: gci.InterfaceWriter) !?[]const u8 {
+        var num: [*c]const u8 = undefined;
+        var num_size: usize = undefined;
+        const err = lib.con_deserialize_number_view(&self.inner, &num, &num_size, @as(*lib.GciInterfaceWriter, @ptrCast(@constCast(&writer.writer))).*);
+        try internal.enumToError(err);
+
+        if (num == null) {
+            return null;
+        }
+        return num[0..num_size];
+    }
+
+    pub fn int(self: *Deserialize) !i64 {
+        var value: i64 = undefined;
+        const err = lib.con_deserialize_int64(&self.inner, &value);
+        try internal.enumToError(err);
+        return value;
+    }
+
+    pub fn uint(self: *Deserialize) !u64 {
+        var value: u64 = undefined;
+        const err = lib.con_deserialize_uint64(&self.inner, &value);
+        try internal.enumToError(err);
+        return value;
+    }
+
+    pub fn float(self: *Deserialize) !f64 {
+        var value: f64 = undefined;
+        const err = lib.con_deserialize_double(&self.inner, &value);
+        try internal.enumToError(err);
+        return value;
+    }
+
     pub fn string(self: *Deserialize, writer: gci.InterfaceWriter) !void {
         const err = lib.con_deserialize_string(&self.inner, @as(*lib.GciInterfaceWriter, @ptrCast(@constCast(&writer.writer))).*);
         return internal.enumToError(err);
     }
 
+    pub fn stringView(self: *Deserialize, writer: gci.InterfaceWriter) !?[]const u8 {
+        var str: [*c]const u8 = undefined;
+        var str_size: usize = undefined;
+        const err = lib.con_deserialize_string_view(&self.inner, &str, &str_size, @as(*lib.GciInterfaceWriter, @ptrCast(@constCast(&writer.writer))).*);
+        try internal.enumToError(err);
+
+        if (str == null) {
+            return null;
+        }
+        return str[0..str_size];
+    }
+
+    // Deserializes a value of type `T` with code generated for it at compile
+    // time, the inverse of `Serialize.serializeValue`. Keys of structs are
+    // matched while they are read, unknown keys are skipped and missing fields
+    // take their default value. Slices are allocated with `allocator` and not
+    // freed on error, an arena allocator is recommended.
+    pub fn deserializeValue(self: *Deserialize, comptime T: type, allocator: std.mem.Allocator) !T {
+        switch (@typeInfo(T)) {
+            .Bool => return self.bool(),
+            .Int => |info| {
+                if (info.bits > 64) {
+                    @compileError("integers wider than 64 bits are not supported: " ++ @typeName(T));
+                }
+                if (info.signedness == .signed) {
+                    return std.math.cast(T, try self.int()) orelse error.Overflow;
+                }
+                return std.math.cast(T, try self.uint()) orelse error.Overflow;
+            },
+            .Float => return @floatCast(try self.float()),
+            .Enum => |info| {
+                comptime var longest: usize = 0;
+                inline for (info.fields) |field| {
+                    longest = @max(longest, field.name.len);
+                }
+
+                var writer = NameWriter(longest){};
+                const err = lib.con_deserialize_string(&self.inner, writer.interface());
+                try internal.enumToError(err);
+
+                if (writer.name()) |name| {
+                    inline for (info.fields) |field| {
+                        if (std.mem.eql(u8, name, field.name)) {
+                            return @enumFromInt(field.value);
+                        }
+                    }
+                }
+                return error.InvalidEnumTag;
+            },
+            .Optional => |info| {
+                if (try self.next() == .null) {
+                    try self.null();
+                    return null;
+                }
+                return try self.deserializeValue(info.child, allocator);
+            },
+            .Array => |info| {
+                var result: T = undefined;
+                try self.arrayOpen();
+                for (&result) |*item| {
+                    item.* = try self.deserializeValue(info.child, allocator);
+                }
+                try self.arrayClose();
+                return result;
+            },
+            .Pointer => |info| {
+                if (info.size != .Slice or info.sentinel != null) {
+                    @compileError("only slices without sentinel are supported: " ++ @typeName(T));
+                }
+
+                if (info.child == u8) {
+                    var writer = StringWriter{ .list = std.ArrayList(u8).init(allocator) };
+                    errdefer writer.list.deinit();
+
+                    const err = lib.con_deserialize_string(&self.inner, writer.interface());
+                    if (writer.out_of_memory) {
+                        return error.OutOfMemory;
+                    }
+                    try internal.enumToError(err);
+                    return try writer.list.toOwnedSlice();
+                }
+
+                var list = std.ArrayList(info.child).init(allocator);
+                errdefer list.deinit();
+
+                try self.arrayOpen();
+                while (try self.next() != .array_close) {
+                    try list.append(try self.deserializeValue(info.child, allocator));
+                }
+                try self.arrayClose();
+                return try list.toOwnedSlice();
+            },
+            .Struct => |info| {
+                const keys = comptime fieldKeys(T);
+                var result: T = undefined;
+                var found = [_]bool{false} ** info.fields.len;
+
+                try self.dictOpen();
+                while (try self.next() != .dict_close) {
+                    var index: usize = undefined;
+                    const err = lib.con_deserialize_dict_key_match(&self.inner, &keys, &index);
+                    try internal.enumToError(err);
+
+                    inline for (info.fields, 0..) |field, i| {
+                        if (index == i) {
+                            @field(result, field.name) = try self.deserializeValue(field.type, allocator);
+                            found[i] = true;
+                        }
+                    }
+                }
+                try self.dictClose();
+
+                inline for (info.fields, 0..) |field, i| {
+                    if (!found[i]) {
+                        if (field.default_value) |default| {
+                            @field(result, field.name) = @as(*const field.type, @ptrCast(@alignCast(default))).*;
+                        } else {
+                            return error.MissingField;
+                        }
+                    }
+                }
+                return result;
+            },
+            else => @compileError("type is not supported: " ++ @typeName(T)),
+        }
+    }
+
     pub fn @"bool"(self: *Deserialize) !bool {
         var value: bool = undefined;
         const err = lib.con_deserialize_bool(&self.inner, &value);
@@ -101,6 +449,20 @@ pub const Deserialize = struct {
         const err = lib.con_deserialize_null(&self.inner);
         return internal.enumToError(err);
     }
+
+    pub fn skip(self: *Deserialize) !void {
+        const err = lib.con_deserialize_skip(&self.inner);
+        return internal.enumToError(err);
+    }
+
+    // Returns true if another element follows and the context has been reset
+    // to read it, false at the end of the input.
+    pub fn record(self: *Deserialize) !bool {
+        var found: bool = undefined;
+        const err = lib.con_deserialize_record(&self.inner, &found);
+        try internal.enumToError(err);
+        return found;
+    }
 };
 
 const testing = std.testing;
@@ -128,6 +490,31 @@ test "context init depth buffer overflow" {
     try testing.expectError(error.Overflow, err);
 }
 
+test "context init buffer" {
+    const data = "";
+    var reader = try gci.ReaderString.init(data);
+
+    var depth: [0]zcon.Container = undefined;
+    var buffer: [4]u8 = undefined;
+    _ = try Deserialize.initBuffer(reader.interface(), &depth, &buffer);
+}
+
+test "context init buffer depth buffer overflow" {
+    const data = "";
+    var reader = try gci.ReaderString.init(data);
+
+    var fake_large_depth = try testing.allocator.alloc(zcon.Container, 2);
+    fake_large_depth.len = @as(usize, std.math.maxInt(c_int)) + 1;
+    defer {
+        fake_large_depth.len = 2;
+        testing.allocator.free(fake_large_depth);
+    }
+
+    var buffer: [4]u8 = undefined;
+    const err = Deserialize.initBuffer(reader.interface(), fake_large_depth, &buffer);
+    try testing.expectError(error.Overflow, err);
+}
+
 // Section: Next ---------------------------------------------------------------
 
 test "next empty" {
@@ -596,8 +983,76 @@ test "string escaped" {
     var buffer: [16]u8 = undefined;
     var writer = try gci.WriterString.init(&buffer);
     try context.string(writer.interface());
-    try testing.expectEqual(10, writer.inner.current);
-    try testing.expectEqualStrings("\"\\/\x08\x0c\n\r\t\x12\xf4", buffer[0..10]);
+    try testing.expectEqual(11, writer.inner.current);
+    try testing.expectEqualStrings("\"\\/\x08\x0c\n\r\t\xe1\x8b\xb4", buffer[0..11]);
+}
+
+test "string unicode" {
+    const data = "\"\\u0000\\u0041\\u00e9\\u20AC\\ud83d\\ude00\"";
+    var reader = try gci.ReaderString.init(data);
+
+    var depth: [0]zcon.Container = undefined;
+    var context = try Deserialize.init(reader.interface(), &depth);
+
+    var buffer: [16]u8 = undefined;
+    var writer = try gci.WriterString.init(&buffer);
+    try context.string(writer.interface());
+    try testing.expectEqual(11, writer.inner.current);
+    try testing.expectEqualStrings("\x00A\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80", buffer[0..11]);
+}
+
+test "string surrogate invalid" {
+    var reader: gci.ReaderString = undefined;
+    var buffer: [5]u8 = undefined;
+    var writer: gci.WriterString = undefined;
+
+    var depth: [0]zcon.Container = undefined;
+    var context: Deserialize = undefined;
+
+    const data1 = "\"1\\ud83dx\"";
+    reader = try gci.ReaderString.init(data1);
+    writer = try gci.WriterString.init(&buffer);
+    context = try Deserialize.init(reader.interface(), &depth);
+    const err1 = context.string(writer.interface());
+    try testing.expectError(error.Surrogate, err1);
+    try testing.expectEqual(1, writer.inner.current);
+    try testing.expectEqualStrings("1", buffer[0..1]);
+
+    const data2 = "\"2\\ude00\"";
+    reader = try gci.ReaderString.init(data2);
+    writer = try gci.WriterString.init(&buffer);
+    context = try Deserialize.init(reader.interface(), &depth);
+    const err2 = context.string(writer.interface());
+    try testing.expectError(error.Surrogate, err2);
+    try testing.expectEqual(1, writer.inner.current);
+    try testing.expectEqualStrings("2", buffer[0..1]);
+
+    const data3 = "\"3\\ud83d\\u0041\"";
+    reader = try gci.ReaderString.init(data3);
+    writer = try gci.WriterString.init(&buffer);
+    context = try Deserialize.init(reader.interface(), &depth);
+    const err3 = context.string(writer.interface());
+    try testing.expectError(error.Surrogate, err3);
+    try testing.expectEqual(1, writer.inner.current);
+    try testing.expectEqualStrings("3", buffer[0..1]);
+
+    const data4 = "\"4\\ud83d\\n\"";
+    reader = try gci.ReaderString.init(data4);
+    writer = try gci.WriterString.init(&buffer);
+    context = try Deserialize.init(reader.interface(), &depth);
+    const err4 = context.string(writer.interface());
+    try testing.expectError(error.Surrogate, err4);
+    try testing.expectEqual(1, writer.inner.current);
+    try testing.expectEqualStrings("4", buffer[0..1]);
+
+    const data5 = "\"5\\ud83d";
+    reader = try gci.ReaderString.init(data5);
+    writer = try gci.WriterString.init(&buffer);
+    context = try Deserialize.init(reader.interface(), &depth);
+    const err5 = context.string(writer.interface());
+    try testing.expectError(error.Reader, err5);
+    try testing.expectEqual(1, writer.inner.current);
+    try testing.expectEqualStrings("5", buffer[0..1]);
 }
 
 test "string invalid" {
@@ -2031,6 +2486,764 @@ test "dict complete" {
     try testing.expectError(error.Complete, err);
 }
 
+// Section: Read buffer --------------------------------------------------------
+
+test "read buffer number" {
+    const data = "[12.5e3, -1]";
+    var reader = try gci.ReaderString.init(data);
+
+    var depth: [1]zcon.Container = undefined;
+    var read_buffer: [4]u8 = undefined;
+    var context = try Deserialize.initBuffer(reader.interface(), &depth, &read_buffer);
+
+    try context.arrayOpen();
+
+    var buffer: [8]u8 = undefined;
+    var writer = try gci.WriterString.init(&buffer);
+    try context.number(writer.interface());
+    try testing.expectEqualStrings("12.5e3", buffer[0..6]);
+
+    writer = try gci.WriterString.init(&buffer);
+    try context.number(writer.interface());
+    try testing.expectEqualStrings("-1", buffer[0..2]);
+
+    try context.arrayClose();
+}
+
+test "read buffer number end of input" {
+    const data = "123";
+    var reader = try gci.ReaderString.init(data);
+
+    var depth: [0]zcon.Container = undefined;
+    var read_buffer: [2]u8 = undefined;
+    var context = try Deserialize.initBuffer(reader.interface(), &depth, &read_buffer);
+
+    var buffer: [3]u8 = undefined;
+    var writer = try gci.WriterString.init(&buffer);
+    try context.number(writer.interface());
+    try testing.expectEqualStrings("123", &buffer);
+
+    const err = context.next();
+    try testing.expectError(error.Reader, err);
+}
+
+test "read buffer string" {
+    const data = "  \"a\\nb\\u00e9\"";
+    var reader = try gci.ReaderString.init(data);
+
+    var depth: [0]zcon.Container = undefined;
+    var read_buffer: [3]u8 = undefined;
+    var context = try Deserialize.initBuffer(reader.interface(), &depth, &read_buffer);
+
+    var buffer: [5]u8 = undefined;
+    var writer = try gci.WriterString.init(&buffer);
+    try context.string(writer.interface());
+    try testing.expectEqualStrings("a\nb\xc3\xa9", &buffer);
+}
+
+test "read buffer string long" {
+    const data = "\"abcdefghijklmnopqrstuvwxyz\\tABCDEFGHIJKLMNOPQRSTUVWXYZ\\\"0123456789\"";
+    var reader = try gci.ReaderString.init(data);
+
+    var depth: [0]zcon.Container = undefined;
+    var read_buffer: [16]u8 = undefined;
+    var context = try Deserialize.initBuffer(reader.interface(), &depth, &read_buffer);
+
+    var buffer: [64]u8 = undefined;
+    var writer = try gci.WriterString.init(&buffer);
+    try context.string(writer.interface());
+    try testing.expectEqual(64, writer.inner.current);
+    try testing.expectEqualStrings(
+        "abcdefghijklmnopqrstuvwxyz\tABCDEFGHIJKLMNOPQRSTUVWXYZ\"0123456789",
+        &buffer,
+    );
+}
+
+test "read buffer string writer fail" {
+    const data = "\"abcdef\"";
+    var reader = try gci.ReaderString.init(data);
+
+    var depth: [0]zcon.Container = undefined;
+    var read_buffer: [16]u8 = undefined;
+    var context = try Deserialize.initBuffer(reader.interface(), &depth, &read_buffer);
+
+    var buffer: [3]u8 = undefined;
+    var writer = try gci.WriterString.init(&buffer);
+    const err = context.string(writer.interface());
+    try testing.expectError(error.Writer, err);
+    try testing.expectEqualStrings("abc", &buffer);
+}
+
+test "read buffer reader fail" {
+    const data = "[null,true]";
+    var r = try gci.ReaderString.init(data);
+    var reader = try gci.ReaderFail.init(r.interface(), 7);
+
+    var depth: [1]zcon.Container = undefined;
+    var read_buffer: [16]u8 = undefined;
+    var context = try Deserialize.initBuffer(reader.interface(), &depth, &read_buffer);
+
+    try context.arrayOpen();
+    try context.null();
+
+    const err = context.bool();
+    try testing.expectError(error.Reader, err);
+}
+
+test "read buffer comma" {
+    const data = "[1,,2]";
+    var reader = try gci.ReaderString.init(data);
+
+    var depth: [1]zcon.Container = undefined;
+    var read_buffer: [64]u8 = undefined;
+    var context = try Deserialize.initBuffer(reader.interface(), &depth, &read_buffer);
+
+    try context.arrayOpen();
+
+    var buffer: [1]u8 = undefined;
+    var writer = try gci.WriterString.init(&buffer);
+    try context.number(writer.interface());
+
+    const err = context.next();
+    try testing.expectError(error.CommaMultiple, err);
+}
+
+// Section: Number conversion --------------------------------------------------
+
+test "int" {
+    const data = "[-9223372036854775808, 0, 42]";
+    var reader = try gci.ReaderString.init(data);
+
+    var depth: [1]zcon.Container = undefined;
+    var context = try Deserialize.init(reader.interface(), &depth);
+
+    try context.arrayOpen();
+    try testing.expectEqual(std.math.minInt(i64), try context.int());
+    try testing.expectEqual(0, try context.int());
+    try testing.expectEqual(42, try context.int());
+    try context.arrayClose();
+}
+
+test "int overflow" {
+    const data = "9223372036854775808";
+    var reader = try gci.ReaderString.init(data);
+
+    var depth: [0]zcon.Container = undefined;
+    var context = try Deserialize.init(reader.interface(), &depth);
+
+    const err = context.int();
+    try testing.expectError(error.Overflow, err);
+}
+
+test "int fraction" {
+    const data = "1.0";
+    var reader = try gci.ReaderString.init(data);
+
+    var depth: [0]zcon.Container = undefined;
+    var context = try Deserialize.init(reader.interface(), &depth);
+
+    const err = context.int();
+    try testing.expectError(error.Type, err);
+}
+
+test "uint" {
+    const data = "18446744073709551615";
+    var reader = try gci.ReaderString.init(data);
+
+    var depth: [0]zcon.Container = undefined;
+    var context = try Deserialize.init(reader.interface(), &depth);
+
+    try testing.expectEqual(std.math.maxInt(u64), try context.uint());
+}
+
+test "uint negative" {
+    const data = "-1";
+    var reader = try gci.ReaderString.init(data);
+
+    var depth: [0]zcon.Container = undefined;
+    var context = try Deserialize.init(reader.interface(), &depth);
+
+    const err = context.uint();
+    try testing.expectError(error.Overflow, err);
+}
+
+test "float" {
+    const data = "{\"a\": 0.1, \"b\": -2.5e-3, \"c\": 9007199254740993}";
+    var reader = try gci.ReaderString.init(data);
+
+    var depth: [1]zcon.Container = undefined;
+    var context = try Deserialize.init(reader.interface(), &depth);
+
+    var buffer: [1]u8 = undefined;
+    var writer: gci.WriterString = undefined;
+
+    try context.dictOpen();
+
+    writer = try gci.WriterString.init(&buffer);
+    try context.dictKey(writer.interface());
+    try testing.expectEqual(0.1, try context.float());
+
+    writer = try gci.WriterString.init(&buffer);
+    try context.dictKey(writer.interface());
+    try testing.expectEqual(-2.5e-3, try context.float());
+
+    writer = try gci.WriterString.init(&buffer);
+    try context.dictKey(writer.interface());
+    try testing.expectEqual(9007199254740992.0, try context.float());
+
+    try context.dictClose();
+}
+
+test "float long" {
+    const data = "2.4703282292062327208828439643411068618252990130716238221279284125033775363510437593264991818081799618989828234772285886546332835517796989819938739800539093906315035659515570226392290858392449105184435931802849936536152500319370457678249219365623669863658480757001585769269903706311928279558551332927834338409351978015531246597263579574622766465272827220056374006485499977096599470454020828166226237857393450736339007967761930577506740176324673600968951340535537458516661134223766678604162159680461914467291840300530057530849048765391711386591646239524912623653881879636239373280423891018672348497668235089863388587925628302755995657524455507255189313690836254779186948667994968324049705821028513185451396213837722826145437693412532098591327667236328125e-324";
+    var reader = try gci.ReaderString.init(data);
+
+    var depth: [0]zcon.Container = undefined;
+    var context = try Deserialize.init(reader.interface(), &depth);
+
+    try testing.expectEqual(0.0, try context.float());
+}
+
+test "float overflow" {
+    const data = "1e309";
+    var reader = try gci.ReaderString.init(data);
+
+    var depth: [0]zcon.Container = undefined;
+    var context = try Deserialize.init(reader.interface(), &depth);
+
+    const err = context.float();
+    try testing.expectError(error.Overflow, err);
+}
+
+test "float invalid" {
+    const data = "1.e2";
+    var reader = try gci.ReaderString.init(data);
+
+    var depth: [0]zcon.Container = undefined;
+    var context = try Deserialize.init(reader.interface(), &depth);
+
+    const err = context.float();
+    try testing.expectError(error.InvalidJson, err);
+}
+
+// Section: Views --------------------------------------------------------------
+
+test "context init memory" {
+    const data = "";
+    var depth: [0]zcon.Container = undefined;
+    _ = try Deserialize.initMemory(data, &depth);
+}
+
+test "view values" {
+    const data = "{\"key\": [\"abc\", -12.5e3]}";
+    var depth: [2]zcon.Container = undefined;
+    var context = try Deserialize.initMemory(data, &depth);
+
+    var buffer: [0]u8 = undefined;
+    var writer = try gci.WriterString.init(&buffer);
+
+    try context.dictOpen();
+
+    const key = try context.dictKeyView(writer.interface());
+    try testing.expectEqualStrings("key", key.?);
+    try testing.expectEqual(data.ptr + 2, key.?.ptr);
+
+    try context.arrayOpen();
+
+    const str = try context.stringView(writer.interface());
+    try testing.expectEqualStrings("abc", str.?);
+
+    const num = try context.numberView(writer.interface());
+    try testing.expectEqualStrings("-12.5e3", num.?);
+
+    try context.arrayClose();
+    try context.dictClose();
+}
+
+test "view string escaped" {
+    const data = "\"a\\tb\"";
+    var depth: [0]zcon.Container = undefined;
+    var context = try Deserialize.initMemory(data, &depth);
+
+    var buffer: [3]u8 = undefined;
+    var writer = try gci.WriterString.init(&buffer);
+
+    const str = try context.stringView(writer.interface());
+    try testing.expectEqual(null, str);
+    try testing.expectEqualStrings("a\tb", &buffer);
+}
+
+test "view key escaped" {
+    const data = "{\"\\u0041\":null}";
+    var depth: [1]zcon.Container = undefined;
+    var context = try Deserialize.initMemory(data, &depth);
+
+    var buffer: [1]u8 = undefined;
+    var writer = try gci.WriterString.init(&buffer);
+
+    try context.dictOpen();
+
+    const key = try context.dictKeyView(writer.interface());
+    try testing.expectEqual(null, key);
+    try testing.expectEqualStrings("A", &buffer);
+
+    try context.null();
+    try context.dictClose();
+}
+
+test "view number end of input" {
+    const data = "123";
+    var depth: [0]zcon.Container = undefined;
+    var context = try Deserialize.initMemory(data, &depth);
+
+    var buffer: [0]u8 = undefined;
+    var writer = try gci.WriterString.init(&buffer);
+
+    const num = try context.numberView(writer.interface());
+    try testing.expectEqualStrings("123", num.?);
+}
+
+test "view number invalid" {
+    const data = "12a";
+    var depth: [0]zcon.Container = undefined;
+    var context = try Deserialize.initMemory(data, &depth);
+
+    var buffer: [0]u8 = undefined;
+    var writer = try gci.WriterString.init(&buffer);
+
+    const err = context.numberView(writer.interface());
+    try testing.expectError(error.InvalidJson, err);
+}
+
+test "view string not terminated" {
+    const data = "\"abc";
+    var depth: [0]zcon.Container = undefined;
+    var context = try Deserialize.initMemory(data, &depth);
+
+    var buffer: [3]u8 = undefined;
+    var writer = try gci.WriterString.init(&buffer);
+
+    const err = context.stringView(writer.interface());
+    try testing.expectError(error.Reader, err);
+}
+
+test "view from reader" {
+    const data = "\"abc\"";
+    var reader = try gci.ReaderString.init(data);
+
+    var depth: [0]zcon.Container = undefined;
+    var context = try Deserialize.init(reader.interface(), &depth);
+
+    var buffer: [3]u8 = undefined;
+    var writer = try gci.WriterString.init(&buffer);
+
+    const str = try context.stringView(writer.interface());
+    try testing.expectEqual(null, str);
+    try testing.expectEqualStrings("abc", &buffer);
+}
+
+// Section: Skip ---------------------------------------------------------------
+
+test "skip values" {
+    const data = "{\"a\": [1, {\"b\": \"]}\\\"\"}, []], \"b\": -1.5, \"c\": \"x\\\\\", \"d\": true, \"e\": null, \"f\": 2}";
+    var reader = try gci.ReaderString.init(data);
+
+    var depth: [1]zcon.Container = undefined;
+    var context = try Deserialize.init(reader.interface(), &depth);
+
+    var buffer: [1]u8 = undefined;
+    var writer: gci.WriterString = undefined;
+
+    try context.dictOpen();
+
+    const keys = "abcde";
+    for (keys) |key| {
+        writer = try gci.WriterString.init(&buffer);
+        try context.dictKey(writer.interface());
+        try testing.expectEqual(key, buffer[0]);
+        try context.skip();
+    }
+
+    writer = try gci.WriterString.init(&buffer);
+    try context.dictKey(writer.interface());
+    try testing.expectEqualStrings("f", &buffer);
+
+    writer = try gci.WriterString.init(&buffer);
+    try context.number(writer.interface());
+    try testing.expectEqualStrings("2", &buffer);
+
+    try context.dictClose();
+}
+
+test "skip read buffer" {
+    const data = "[[\"[[[\", {\"\\\\\": [{}]}, \"0123456789abcdef0123456789abcdef\"], 3]";
+    var reader = try gci.ReaderString.init(data);
+
+    var depth: [1]zcon.Container = undefined;
+    var read_buffer: [3]u8 = undefined;
+    var context = try Deserialize.initBuffer(reader.interface(), &depth, &read_buffer);
+
+    var buffer: [1]u8 = undefined;
+    var writer = try gci.WriterString.init(&buffer);
+
+    try context.arrayOpen();
+    try context.skip();
+    try context.number(writer.interface());
+    try testing.expectEqualStrings("3", &buffer);
+    try context.arrayClose();
+}
+
+test "skip complete" {
+    const data = "[[[[]]]] 1";
+    var depth: [0]zcon.Container = undefined;
+    var context = try Deserialize.initMemory(data, &depth);
+
+    try context.skip();
+
+    const err = context.skip();
+    try testing.expectError(error.Complete, err);
+}
+
+test "skip invalid" {
+    var depth: [1]zcon.Container = undefined;
+    var context: Deserialize = undefined;
+
+    context = try Deserialize.initMemory("{\"a\": 1}", &depth);
+    try context.dictOpen();
+    const err1 = context.skip();
+    try testing.expectError(error.Key, err1);
+
+    context = try Deserialize.initMemory("[]", &depth);
+    try context.arrayOpen();
+    const err2 = context.skip();
+    try testing.expectError(error.Type, err2);
+
+    context = try Deserialize.initMemory("[1, \"]\"", &depth);
+    const err3 = context.skip();
+    try testing.expectError(error.Reader, err3);
+
+    context = try Deserialize.initMemory("\"a\\\"", &depth);
+    const err4 = context.skip();
+    try testing.expectError(error.Reader, err4);
+
+    context = try Deserialize.initMemory("nux", &depth);
+    const err5 = context.skip();
+    try testing.expectError(error.InvalidJson, err5);
+}
+
+// Section: Key match ----------------------------------------------------------
+
+test "keys init" {
+    const names = [_][*:0]const u8{ "name", "id", "n", "", "id" };
+    var order: [names.len]usize = undefined;
+    const keys = try Keys.init(&names, &order);
+
+    try testing.expectEqualSlices(usize, &[_]usize{ 3, 1, 4, 2, 0 }, &order);
+    try testing.expectEqual(1, keys.inner.first['i']);
+    try testing.expectEqual(3, keys.inner.first['j']);
+}
+
+test "keys init order too small" {
+    const names = [_][*:0]const u8{ "a", "b" };
+    var order: [1]usize = undefined;
+
+    const err = Keys.init(&names, &order);
+    try testing.expectError(error.Buffer, err);
+}
+
+test "dict key match" {
+    const data = "{\"id\": 1, \"nam\": [\"}\"], \"name\": 2, \"\\u0069d\": 3, \"idx\": {}, \"\": 4, \"n\": 5}";
+    const names = [_][*:0]const u8{ "id", "name", "n", "" };
+    var order: [names.len]usize = undefined;
+    const keys = try Keys.init(&names, &order);
+
+    var reader = try gci.ReaderString.init(data);
+
+    var depth: [1]zcon.Container = undefined;
+    var context = try Deserialize.init(reader.interface(), &depth);
+
+    try context.dictOpen();
+
+    const expected = [_]?usize{ 0, null, 1, 0, null, 3, 2 };
+    var value: u64 = 1;
+    for (expected) |index| {
+        const match = try context.dictKeyMatch(&keys);
+        try testing.expectEqual(index, match);
+        if (match != null) {
+            try testing.expectEqual(value, try context.uint());
+            value += 1;
+        }
+    }
+
+    try context.dictClose();
+}
+
+test "dict key match from memory" {
+    const data = "{\"b\": [1], \"a\": 2}";
+    const names = [_][*:0]const u8{"a"};
+    var order: [names.len]usize = undefined;
+    const keys = try Keys.init(&names, &order);
+
+    var depth: [1]zcon.Container = undefined;
+    var context = try Deserialize.initMemory(data, &depth);
+
+    try context.dictOpen();
+    try testing.expectEqual(null, try context.dictKeyMatch(&keys));
+    try testing.expectEqual(0, (try context.dictKeyMatch(&keys)).?);
+    try testing.expectEqual(2, try context.uint());
+    try context.dictClose();
+}
+
+test "dict key match unknown" {
+    const data = "{\"b\": [1], \"c\"";
+    const names = [_][*:0]const u8{"a"};
+    var order: [names.len]usize = undefined;
+    const keys = try Keys.init(&names, &order);
+
+    var depth: [1]zcon.Container = undefined;
+    var context = try Deserialize.initMemory(data, &depth);
+
+    try context.dictOpen();
+    try testing.expectEqual(null, try context.dictKeyMatch(&keys));
+
+    const err = context.dictKeyMatch(&keys);
+    try testing.expectError(error.Reader, err);
+}
+
+test "dict key match not key" {
+    const data = "[\"a\"]";
+    const names = [_][*:0]const u8{"a"};
+    var order: [names.len]usize = undefined;
+    const keys = try Keys.init(&names, &order);
+
+    var depth: [1]zcon.Container = undefined;
+    var context = try Deserialize.initMemory(data, &depth);
+
+    try context.arrayOpen();
+
+    const err = context.dictKeyMatch(&keys);
+    try testing.expectError(error.Type, err);
+}
+
+// Section: Reflection ---------------------------------------------------------
+
+test "keys of fields" {
+    const keys = comptime fieldKeys(struct { name: u8, id: u8, n: u8 });
+
+    try testing.expectEqual(3, keys.keys_size);
+    try testing.expectEqualSlices(usize, &[_]usize{ 1, 2, 0 }, keys.order[0..3]);
+    try testing.expectEqual(0, keys.first['i']);
+    try testing.expectEqual(1, keys.first['j']);
+    try testing.expectEqual(3, keys.first[keys.first.len - 1]);
+}
+
+test "deserialize value struct" {
+    const Kind = enum { small, large };
+    const Item = struct {
+        id: u32,
+        name: []const u8,
+        kind: Kind,
+        score: f64,
+        parent: ?i16,
+        tags: []const []const u8,
+        pair: [2]bool,
+    };
+
+    const data = "{\"id\":7,\"name\":\"a\\\"b\",\"kind\":\"large\",\"score\":1.5,\"parent\":null,\"tags\":[\"x\",\"y\"],\"pair\":[true,false]}";
+    var reader = try gci.ReaderString.init(data);
+
+    var depth: [2]zcon.Container = undefined;
+    var context = try Deserialize.init(reader.interface(), &depth);
+
+    var arena = std.heap.ArenaAllocator.init(testing.allocator);
+    defer arena.deinit();
+
+    const item = try context.deserializeValue(Item, arena.allocator());
+    try testing.expectEqual(7, item.id);
+    try testing.expectEqualStrings("a\"b", item.name);
+    try testing.expectEqual(Kind.large, item.kind);
+    try testing.expectEqual(1.5, item.score);
+    try testing.expectEqual(null, item.parent);
+    try testing.expectEqual(2, item.tags.len);
+    try testing.expectEqualStrings("x", item.tags[0]);
+    try testing.expectEqualStrings("y", item.tags[1]);
+    try testing.expectEqual([2]bool{ true, false }, item.pair);
+}
+
+test "deserialize value defaults and unknown keys" {
+    const Config = struct {
+        a: u8 = 3,
+        b: []const u8,
+        c: ?bool = null,
+    };
+
+    const data = "[{\"x\": {\"y\": [1]}, \"b\": \"\\u00e9\", \"c\": true}, {\"b\": \"\", \"a\": 4}]";
+    var depth: [3]zcon.Container = undefined;
+    var context = try Deserialize.initMemory(data, &depth);
+
+    var arena = std.heap.ArenaAllocator.init(testing.allocator);
+    defer arena.deinit();
+
+    const configs = try context.deserializeValue([]Config, arena.allocator());
+    try testing.expectEqual(2, configs.len);
+    try testing.expectEqual(3, configs[0].a);
+    try testing.expectEqualStrings("\u{e9}", configs[0].b);
+    try testing.expectEqual(true, configs[0].c);
+    try testing.expectEqual(4, configs[1].a);
+    try testing.expectEqualStrings("", configs[1].b);
+    try testing.expectEqual(null, configs[1].c);
+}
+
+test "deserialize value invalid" {
+    const Kind = enum { small, large };
+    const Config = struct { a: u8, b: []const u8 };
+
+    var depth: [1]zcon.Container = undefined;
+    var context: Deserialize = undefined;
+
+    var arena = std.heap.ArenaAllocator.init(testing.allocator);
+    defer arena.deinit();
+    const allocator = arena.allocator();
+
+    context = try Deserialize.initMemory("{\"a\": 1}", &depth);
+    const err1 = context.deserializeValue(Config, allocator);
+    try testing.expectError(error.MissingField, err1);
+
+    context = try Deserialize.initMemory("{\"a\": 300, \"b\": \"\"}", &depth);
+    const err2 = context.deserializeValue(Config, allocator);
+    try testing.expectError(error.Overflow, err2);
+
+    context = try Deserialize.initMemory("\"tiny\"", &depth);
+    const err3 = context.deserializeValue(Kind, allocator);
+    try testing.expectError(error.InvalidEnumTag, err3);
+
+    context = try Deserialize.initMemory("\"larger\"", &depth);
+    const err4 = context.deserializeValue(Kind, allocator);
+    try testing.expectError(error.InvalidEnumTag, err4);
+
+    context = try Deserialize.initMemory("[true]", &depth);
+    const err5 = context.deserializeValue([2]bool, allocator);
+    try testing.expectError(error.Type, err5);
+
+    context = try Deserialize.initMemory("-1", &depth);
+    const err6 = context.deserializeValue(u32, allocator);
+    try testing.expectError(error.Overflow, err6);
+}
+
+test "deserialize value out of memory" {
+    const data = "\"abc\"";
+    var depth: [0]zcon.Container = undefined;
+    var context = try Deserialize.initMemory(data, &depth);
+
+    var buffer: [2]u8 = undefined;
+    var fixed = std.heap.FixedBufferAllocator.init(&buffer);
+
+    const err = context.deserializeValue([]const u8, fixed.allocator());
+    try testing.expectError(error.OutOfMemory, err);
+}
+
+// Section: Record -------------------------------------------------------------
+
+test "record" {
+    const data = "{\"a\": 1}\n[2]\n\"x\"\n3\n\n";
+    var reader = try gci.ReaderString.init(data);
+
+    var depth: [1]zcon.Container = undefined;
+    var context = try Deserialize.init(reader.interface(), &depth);
+
+    var buffer: [1]u8 = undefined;
+    var writer: gci.WriterString = undefined;
+
+    try testing.expect(try context.record());
+    try context.dictOpen();
+    writer = try gci.WriterString.init(&buffer);
+    try context.dictKey(writer.interface());
+    try context.skip();
+    try context.dictClose();
+
+    try testing.expect(try context.record());
+    try context.skip();
+
+    try testing.expect(try context.record());
+    writer = try gci.WriterString.init(&buffer);
+    try context.string(writer.interface());
+    try testing.expectEqualStrings("x", &buffer);
+
+    try testing.expect(try context.record());
+    try testing.expectEqual(3, try context.int());
+
+    try testing.expect(!try context.record());
+}
+
+test "record read buffer" {
+    const data = "1 2 {}[]\"a\"";
+    var reader = try gci.ReaderString.init(data);
+
+    var depth: [1]zcon.Container = undefined;
+    var read_buffer: [2]u8 = undefined;
+    var context = try Deserialize.initBuffer(reader.interface(), &depth, &read_buffer);
+
+    var count: usize = 0;
+    while (try context.record()) {
+        try context.skip();
+        count += 1;
+    }
+    try testing.expectEqual(5, count);
+}
+
+test "record incomplete" {
+    var depth: [1]zcon.Container = undefined;
+    var context = try Deserialize.initMemory("[1]", &depth);
+
+    try testing.expect(try context.record());
+    try context.arrayOpen();
+
+    const err = context.record();
+    try testing.expectError(error.Incomplete, err);
+}
+
+// Section: Depth stack --------------------------------------------------------
+
+test "depth allocator" {
+    const levels = 100;
+    const data = "[{\"a\":" ** levels ++ "null" ++ "}]" ** levels;
+
+    var depth: [1]zcon.Container = undefined;
+    var context = try Deserialize.initMemory(data, &depth);
+    try context.depthAllocator(testing.allocator);
+    defer context.deinit();
+
+    var buffer: [1]u8 = undefined;
+    for (0..levels) |_| {
+        try context.arrayOpen();
+        try context.dictOpen();
+        var writer = try gci.WriterString.init(&buffer);
+        try context.dictKey(writer.interface());
+    }
+    try context.@"null"();
+    for (0..levels) |_| {
+        try context.dictClose();
+        try context.arrayClose();
+    }
+}
+
+test "depth allocator fail" {
+    const data = "[" ** 64;
+
+    var depth: [1]zcon.Container = undefined;
+    var context = try Deserialize.initMemory(data, &depth);
+    try context.depthAllocator(testing.failing_allocator);
+    defer context.deinit();
+
+    // The initial buffer holds a bit per level before anything is allocated.
+    for (0..@bitSizeOf(zcon.Container)) |_| {
+        try context.arrayOpen();
+    }
+
+    const err = context.arrayOpen();
+    try testing.expectError(error.TooDeep, err);
+}
+
 // Section: Integration test ---------------------------------------------------
 
 test "nested structures" {
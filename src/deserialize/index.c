@@ -0,0 +1,391 @@
+#include <assert.h>
+#include <ctype.h>
+#include <string.h>
+#include <utils.h>
+#include "con_index.h"
+
+// Compares a decoded key, written in pieces, to an expected key.
+struct ConIndexKeyCompare {
+    char const *key;
+    size_t key_size;
+    size_t position;
+};
+
+static inline enum ConError con_index_push(struct ConIndex *index, enum ConDeserializeType type, size_t offset, size_t size);
+static inline enum ConContainer con_index_container_current(struct ConIndex *index, size_t *depth_buffer, size_t depth);
+static inline bool con_index_token_end(char const *data, size_t data_size, size_t position);
+static inline enum ConError con_index_string(char const *data, size_t data_size, size_t *position);
+static inline enum ConError con_index_number(char const *data, size_t data_size, size_t *position);
+static inline enum ConError con_index_literal(char const *data, size_t data_size, size_t *position, char const *literal, size_t literal_size);
+static enum ConError con_index_key_equal(struct ConIndex const *index, struct ConIndexEntry const *entry, char const *key, size_t key_size, bool *equal);
+
+enum ConError con_index_init(
+    struct ConIndex *index,
+    char const *data,
+    size_t data_size,
+    struct ConIndexEntry *tape,
+    size_t tape_size,
+    size_t *depth_buffer,
+    size_t depth_buffer_size
+) {
+    if (index == NULL) { return CON_ERROR_NULL; }
+    if (data == NULL && data_size > 0) { return CON_ERROR_NULL; }
+    if (tape == NULL && tape_size > 0) { return CON_ERROR_NULL; }
+    if (depth_buffer == NULL && depth_buffer_size > 0) { return CON_ERROR_NULL; }
+
+    index->data = data;
+    index->data_size = data_size;
+    index->tape = tape;
+    index->tape_size = tape_size;
+    index->tape_length = 0;
+    if (data_size == 0) { return CON_ERROR_READER; }
+
+    enum ConState state = con_utils_state_init();
+    bool found_comma = false;
+    size_t depth = 0;
+    size_t position = 0;
+
+    while (true) {
+        position += con_utils_whitespace_skip(data + position, data_size - position);
+        if (position >= data_size) {
+            if (state == CON_STATE_COMPLETE) { return CON_ERROR_OK; }
+            return CON_ERROR_READER;
+        }
+        if (state == CON_STATE_COMPLETE) { return CON_ERROR_COMPLETE; }
+
+        char c = data[position];
+        enum ConContainer current = con_index_container_current(index, depth_buffer, depth);
+
+        if (c == ',') {
+            if (found_comma) { return CON_ERROR_COMMA_MULTIPLE; }
+            if (state != CON_STATE_LATER) { return CON_ERROR_COMMA_UNEXPECTED; }
+
+            found_comma = true;
+            position += 1;
+            continue;
+        }
+
+        if (c == ']' || c == '}') {
+            if (found_comma) { return CON_ERROR_COMMA_TRAILING; }
+            if (depth == 0) { return CON_ERROR_CLOSED_TOO_MANY; }
+            if (c == ']' && current != CON_CONTAINER_ARRAY) { return CON_ERROR_NOT_ARRAY; }
+            if (c == '}' && current != CON_CONTAINER_DICT) { return CON_ERROR_NOT_DICT; }
+            if (state == CON_STATE_VALUE) { return CON_ERROR_VALUE; }
+
+            enum ConError state_err = con_utils_state_close(&state, current);
+            if (state_err) { return state_err; }
+
+            enum ConDeserializeType type = c == ']' ? CON_DESERIALIZE_TYPE_ARRAY_CLOSE : CON_DESERIALIZE_TYPE_DICT_CLOSE;
+            enum ConError push_err = con_index_push(index, type, position, 1);
+            if (push_err) { return push_err; }
+
+            depth -= 1;
+            index->tape[depth_buffer[depth]].next = index->tape_length;
+            if (depth == 0) {
+                state = CON_STATE_COMPLETE;
+            }
+
+            position += 1;
+            continue;
+        }
+
+        if (state == CON_STATE_LATER && !found_comma) { return CON_ERROR_COMMA_MISSING; }
+        found_comma = false;
+
+        size_t start = position;
+        if (c == '"' && current == CON_CONTAINER_DICT && (state == CON_STATE_FIRST || state == CON_STATE_LATER)) {
+            enum ConError state_err = con_utils_state_key(&state, current);
+            if (state_err) { return state_err; }
+
+            enum ConError string_err = con_index_string(data, data_size, &position);
+            if (string_err) { return string_err; }
+
+            enum ConError push_err = con_index_push(index, CON_DESERIALIZE_TYPE_DICT_KEY, start, position - start);
+            if (push_err) { return push_err; }
+            index->tape[depth_buffer[depth - 1]].size += 1;
+
+            position += con_utils_whitespace_skip(data + position, data_size - position);
+            if (position >= data_size) { return CON_ERROR_READER; }
+            if (data[position] != ':') { return CON_ERROR_INVALID_JSON; }
+
+            position += 1;
+            continue;
+        }
+
+        if (c == '[' || c == '{') {
+            enum ConError state_err = con_utils_state_open(&state, current);
+            if (state_err) { return state_err; }
+            if (depth >= depth_buffer_size) { return CON_ERROR_TOO_DEEP; }
+
+            enum ConDeserializeType type = c == '[' ? CON_DESERIALIZE_TYPE_ARRAY_OPEN : CON_DESERIALIZE_TYPE_DICT_OPEN;
+            enum ConError push_err = con_index_push(index, type, position, 0);
+            if (push_err) { return push_err; }
+            if (current == CON_CONTAINER_ARRAY) {
+                index->tape[depth_buffer[depth - 1]].size += 1;
+            }
+
+            depth_buffer[depth] = index->tape_length - 1;
+            depth += 1;
+
+            position += 1;
+            continue;
+        }
+
+        enum ConDeserializeType type;
+        enum ConError token_err;
+        if (c == '"') {
+            type = CON_DESERIALIZE_TYPE_STRING;
+            token_err = con_index_string(data, data_size, &position);
+        } else if (isdigit((unsigned char) c) || c == '-') {
+            type = CON_DESERIALIZE_TYPE_NUMBER;
+            token_err = con_index_number(data, data_size, &position);
+        } else if (c == 't') {
+            type = CON_DESERIALIZE_TYPE_BOOL;
+            token_err = con_index_literal(data, data_size, &position, "true", 4);
+        } else if (c == 'f') {
+            type = CON_DESERIALIZE_TYPE_BOOL;
+            token_err = con_index_literal(data, data_size, &position, "false", 5);
+        } else if (c == 'n') {
+            type = CON_DESERIALIZE_TYPE_NULL;
+            token_err = con_index_literal(data, data_size, &position, "null", 4);
+        } else {
+            return CON_ERROR_INVALID_JSON;
+        }
+
+        enum ConError state_err = con_utils_state_next(&state, current);
+        if (state_err) { return state_err; }
+        if (token_err) { return token_err; }
+
+        enum ConError push_err = con_index_push(index, type, start, position - start);
+        if (push_err) { return push_err; }
+        if (current == CON_CONTAINER_ARRAY) {
+            index->tape[depth_buffer[depth - 1]].size += 1;
+        }
+    }
+}
+
+enum ConError con_index_array_get(struct ConIndex const *index, size_t array, size_t position, size_t *entry) {
+    if (index == NULL) { return CON_ERROR_NULL; }
+    if (entry == NULL) { return CON_ERROR_NULL; }
+    if (array >= index->tape_length) { return CON_ERROR_BUFFER; }
+
+    struct ConIndexEntry const *tape = index->tape;
+    if (tape[array].type != CON_DESERIALIZE_TYPE_ARRAY_OPEN) { return CON_ERROR_NOT_ARRAY; }
+
+    if (position >= tape[array].size) {
+        *entry = CON_INDEX_NONE;
+        return CON_ERROR_OK;
+    }
+
+    size_t current = array + 1;
+    for (size_t i = 0; i < position; i++) {
+        assert(tape[current].type != CON_DESERIALIZE_TYPE_ARRAY_CLOSE);
+        current = tape[current].next;
+    }
+
+    *entry = current;
+    return CON_ERROR_OK;
+}
+
+enum ConError con_index_dict_get(struct ConIndex const *index, size_t dict, char const *key, size_t key_size, size_t *entry) {
+    if (index == NULL) { return CON_ERROR_NULL; }
+    if (key == NULL) { return CON_ERROR_NULL; }
+    if (entry == NULL) { return CON_ERROR_NULL; }
+    if (dict >= index->tape_length) { return CON_ERROR_BUFFER; }
+
+    struct ConIndexEntry const *tape = index->tape;
+    if (tape[dict].type != CON_DESERIALIZE_TYPE_DICT_OPEN) { return CON_ERROR_NOT_DICT; }
+
+    size_t current = dict + 1;
+    while (tape[current].type == CON_DESERIALIZE_TYPE_DICT_KEY) {
+        bool equal;
+        enum ConError err = con_index_key_equal(index, &tape[current], key, key_size, &equal);
+        if (err) { return err; }
+
+        if (equal) {
+            *entry = current + 1;
+            return CON_ERROR_OK;
+        }
+
+        current = tape[current + 1].next;
+    }
+
+    assert(tape[current].type == CON_DESERIALIZE_TYPE_DICT_CLOSE);
+    *entry = CON_INDEX_NONE;
+    return CON_ERROR_OK;
+}
+
+enum ConError con_index_deserialize(
+    struct ConIndex const *index,
+    size_t entry,
+    struct ConDeserialize *context,
+    enum ConContainer *depth_buffer,
+    int depth_buffer_size
+) {
+    if (index == NULL) { return CON_ERROR_NULL; }
+    if (entry >= index->tape_length) { return CON_ERROR_BUFFER; }
+
+    struct ConIndexEntry const *value = &index->tape[entry];
+    if (value->type == CON_DESERIALIZE_TYPE_ARRAY_CLOSE || value->type == CON_DESERIALIZE_TYPE_DICT_CLOSE) {
+        return CON_ERROR_TYPE;
+    }
+
+    size_t size = value->size;
+    if (value->type == CON_DESERIALIZE_TYPE_ARRAY_OPEN || value->type == CON_DESERIALIZE_TYPE_DICT_OPEN) {
+        struct ConIndexEntry const *close = &index->tape[value->next - 1];
+        size = close->offset + 1 - value->offset;
+    }
+
+    return con_deserialize_init_memory(context, index->data + value->offset, size, depth_buffer, depth_buffer_size);
+}
+
+static inline enum ConError con_index_push(struct ConIndex *index, enum ConDeserializeType type, size_t offset, size_t size) {
+    assert(index != NULL);
+    if (index->tape_length >= index->tape_size) { return CON_ERROR_BUFFER; }
+
+    assert(index->tape != NULL);
+    index->tape[index->tape_length] = (struct ConIndexEntry) {
+        .type = type,
+        .offset = offset,
+        .size = size,
+        .next = index->tape_length + 1,
+    };
+    index->tape_length += 1;
+    return CON_ERROR_OK;
+}
+
+static inline enum ConContainer con_index_container_current(struct ConIndex *index, size_t *depth_buffer, size_t depth) {
+    assert(index != NULL);
+    if (depth == 0) { return CON_CONTAINER_NONE; }
+
+    assert(depth_buffer != NULL);
+    enum ConDeserializeType type = index->tape[depth_buffer[depth - 1]].type;
+    assert(type == CON_DESERIALIZE_TYPE_ARRAY_OPEN || type == CON_DESERIALIZE_TYPE_DICT_OPEN);
+    return type == CON_DESERIALIZE_TYPE_ARRAY_OPEN ? CON_CONTAINER_ARRAY : CON_CONTAINER_DICT;
+}
+
+// A number, bool or null must be followed by whitespace, the end of a
+// container, a comma or the end of the data, like when deserializing.
+static inline bool con_index_token_end(char const *data, size_t data_size, size_t position) {
+    if (position >= data_size) { return true; }
+
+    char c = data[position];
+    return isspace((unsigned char) c) || c == ',' || c == ']' || c == '}' || c == '"';
+}
+
+static inline enum ConError con_index_string(char const *data, size_t data_size, size_t *position) {
+    assert(data != NULL);
+    assert(position != NULL);
+    assert(*position < data_size && data[*position] == '"');
+
+    size_t i = *position + 1;
+    while (true) {
+        i += con_utils_string_span(data + i, data_size - i);
+        if (i >= data_size) { return CON_ERROR_READER; }
+
+        if (data[i] == '"') {
+            *position = i + 1;
+            return CON_ERROR_OK;
+        }
+
+        assert(data[i] == '\\');
+        i += 1;
+        if (i >= data_size) { return CON_ERROR_READER; }
+
+        char escape = data[i];
+        if (escape == 'u') {
+            for (size_t j = 1; j <= 4; j++) {
+                if (i + j >= data_size) { return CON_ERROR_READER; }
+                if (!isxdigit((unsigned char) data[i + j])) { return CON_ERROR_INVALID_JSON; }
+            }
+            i += 5;
+        } else if (escape != '\0' && strchr("\"\\/bfnrt", escape) != NULL) {
+            i += 1;
+        } else {
+            return CON_ERROR_INVALID_JSON;
+        }
+    }
+}
+
+static inline enum ConError con_index_number(char const *data, size_t data_size, size_t *position) {
+    assert(data != NULL);
+    assert(position != NULL);
+
+    enum StateNumber state = NUMBER_START;
+    size_t i = *position;
+    while (i < data_size) {
+        enum StateNumber next = con_utils_state_number_next(state, data[i]);
+        if (next == NUMBER_ERROR) { break; }
+
+        state = next;
+        i += 1;
+    }
+
+    if (i >= data_size && !con_utils_state_number_terminal(state)) { return CON_ERROR_READER; }
+    if (!con_utils_state_number_terminal(state)) { return CON_ERROR_INVALID_JSON; }
+    if (!con_index_token_end(data, data_size, i)) { return CON_ERROR_INVALID_JSON; }
+
+    *position = i;
+    return CON_ERROR_OK;
+}
+
+static inline enum ConError con_index_literal(char const *data, size_t data_size, size_t *position, char const *literal, size_t literal_size) {
+    assert(data != NULL);
+    assert(position != NULL);
+
+    size_t i = *position;
+    if (data_size - i < literal_size) {
+        bool prefix = memcmp(data + i, literal, data_size - i) == 0;
+        return prefix ? CON_ERROR_READER : CON_ERROR_INVALID_JSON;
+    }
+    if (memcmp(data + i, literal, literal_size) != 0) { return CON_ERROR_INVALID_JSON; }
+    if (!con_index_token_end(data, data_size, i + literal_size)) { return CON_ERROR_INVALID_JSON; }
+
+    *position = i + literal_size;
+    return CON_ERROR_OK;
+}
+
+static size_t con_index_key_write(void const *void_context, char const *data, size_t data_size) {
+    struct ConIndexKeyCompare *context = (struct ConIndexKeyCompare*) void_context;
+    assert(context != NULL);
+
+    if (context->key_size - context->position < data_size) { return 0; }
+    if (memcmp(context->key + context->position, data, data_size) != 0) { return 0; }
+
+    context->position += data_size;
+    return data_size;
+}
+
+static enum ConError con_index_key_equal(struct ConIndex const *index, struct ConIndexEntry const *entry, char const *key, size_t key_size, bool *equal) {
+    assert(index != NULL);
+    assert(entry != NULL && entry->type == CON_DESERIALIZE_TYPE_DICT_KEY);
+    assert(entry->size >= 2);
+    assert(equal != NULL);
+
+    char const *raw = index->data + entry->offset + 1;
+    size_t raw_size = entry->size - 2;
+    if (memchr(raw, '\\', raw_size) == NULL) {
+        *equal = raw_size == key_size && memcmp(raw, key, key_size) == 0;
+        return CON_ERROR_OK;
+    }
+
+    // Escaped keys are decoded by a deserialization context reading the key
+    // as a single string, a mismatch stops it with a writer error.
+    struct ConIndexKeyCompare compare = { .key = key, .key_size = key_size, .position = 0 };
+    struct GciInterfaceWriter writer = { .context = &compare, .write = con_index_key_write };
+
+    struct ConDeserialize context;
+    enum ConError init_err = con_deserialize_init_memory(&context, index->data + entry->offset, entry->size, NULL, 0);
+    if (init_err) { return init_err; }
+
+    enum ConError err = con_deserialize_string(&context, writer);
+    if (err == CON_ERROR_WRITER) {
+        *equal = false;
+        return CON_ERROR_OK;
+    } else if (err) {
+        return err;
+    }
+
+    *equal = compare.position == key_size;
+    return CON_ERROR_OK;
+}
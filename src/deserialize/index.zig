@@ -0,0 +1,200 @@
+const std = @import("std");
+const zcon = @import("../con.zig");
+const internal = @import("../internal.zig");
+const lib = internal.lib;
+const Deserialize = @import("deserialize.zig").Deserialize;
+
+pub const Index = struct {
+    inner: lib.ConIndex,
+
+    pub const Entry = lib.ConIndexEntry;
+
+    pub fn init(data: []const u8, tape: []Entry, depth: []usize) !Index {
+        var index = Index{ .inner = undefined };
+        const err = lib.con_index_init(
+            &index.inner,
+            data.ptr,
+            data.len,
+            tape.ptr,
+            tape.len,
+            depth.ptr,
+            depth.len,
+        );
+
+        try internal.enumToError(err);
+        return index;
+    }
+
+    pub fn entries(self: *const Index) []const Entry {
+        return self.inner.tape[0..self.inner.tape_length];
+    }
+
+    pub fn arrayGet(self: *const Index, array: usize, position: usize) !?usize {
+        var entry: usize = undefined;
+        const err = lib.con_index_array_get(&self.inner, array, position, &entry);
+        try internal.enumToError(err);
+
+        if (entry == lib.CON_INDEX_NONE) {
+            return null;
+        }
+        return entry;
+    }
+
+    pub fn dictGet(self: *const Index, dict: usize, key: []const u8) !?usize {
+        var entry: usize = undefined;
+        const err = lib.con_index_dict_get(&self.inner, dict, key.ptr, key.len, &entry);
+        try internal.enumToError(err);
+
+        if (entry == lib.CON_INDEX_NONE) {
+            return null;
+        }
+        return entry;
+    }
+
+    pub fn deserialize(self: *const Index, entry: usize, depth: []zcon.Container) !Deserialize {
+        if (depth.len > std.math.maxInt(c_int)) {
+            return error.Overflow;
+        }
+
+        var context = Deserialize{ .inner = undefined };
+        const err = lib.con_index_deserialize(
+            &self.inner,
+            entry,
+            &context.inner,
+            depth.ptr,
+            @intCast(depth.len),
+        );
+
+        try internal.enumToError(err);
+        return context;
+    }
+};
+
+const testing = std.testing;
+
+test "index init" {
+    const data = "{\"a\": [1, true, \"x\"], \"b\": {}}";
+
+    var tape: [16]Index.Entry = undefined;
+    var depth: [2]usize = undefined;
+    const index = try Index.init(data, &tape, &depth);
+
+    const types = [_]c_uint{
+        lib.CON_DESERIALIZE_TYPE_DICT_OPEN,
+        lib.CON_DESERIALIZE_TYPE_DICT_KEY,
+        lib.CON_DESERIALIZE_TYPE_ARRAY_OPEN,
+        lib.CON_DESERIALIZE_TYPE_NUMBER,
+        lib.CON_DESERIALIZE_TYPE_BOOL,
+        lib.CON_DESERIALIZE_TYPE_STRING,
+        lib.CON_DESERIALIZE_TYPE_ARRAY_CLOSE,
+        lib.CON_DESERIALIZE_TYPE_DICT_KEY,
+        lib.CON_DESERIALIZE_TYPE_DICT_OPEN,
+        lib.CON_DESERIALIZE_TYPE_DICT_CLOSE,
+        lib.CON_DESERIALIZE_TYPE_DICT_CLOSE,
+    };
+
+    const result = index.entries();
+    try testing.expectEqual(types.len, result.len);
+    for (types, result) |expected, entry| {
+        try testing.expectEqual(expected, entry.type);
+    }
+
+    try testing.expectEqual(2, result[0].size);
+    try testing.expectEqual(11, result[0].next);
+    try testing.expectEqual(3, result[2].size);
+    try testing.expectEqual(7, result[2].next);
+    try testing.expectEqual(0, result[8].size);
+}
+
+test "index tape too small" {
+    var tape: [2]Index.Entry = undefined;
+    var depth: [1]usize = undefined;
+
+    const err = Index.init("[1, 2]", &tape, &depth);
+    try testing.expectError(error.Buffer, err);
+}
+
+test "index too deep" {
+    var tape: [8]Index.Entry = undefined;
+    var depth: [1]usize = undefined;
+
+    const err = Index.init("[[]]", &tape, &depth);
+    try testing.expectError(error.TooDeep, err);
+}
+
+test "index invalid" {
+    var tape: [8]Index.Entry = undefined;
+    var depth: [2]usize = undefined;
+
+    try testing.expectError(error.Reader, Index.init("[1, 2", &tape, &depth));
+    try testing.expectError(error.Complete, Index.init("[] 1", &tape, &depth));
+    try testing.expectError(error.CommaTrailing, Index.init("[1,]", &tape, &depth));
+    try testing.expectError(error.CommaMissing, Index.init("[1 2]", &tape, &depth));
+    try testing.expectError(error.InvalidJson, Index.init("{\"a\" 1}", &tape, &depth));
+    try testing.expectError(error.InvalidJson, Index.init("[tru]", &tape, &depth));
+    try testing.expectError(error.InvalidJson, Index.init("[\"\\x\"]", &tape, &depth));
+    try testing.expectError(error.Key, Index.init("{1: 2}", &tape, &depth));
+    try testing.expectError(error.Value, Index.init("{\"a\": }", &tape, &depth));
+    try testing.expectError(error.NotArray, Index.init("{]", &tape, &depth));
+}
+
+test "index lookup" {
+    const data = "[{\"id\": 1, \"tags\": [\"a\"]}, {\"tags\": [[], {}], \"id\": 2}, 3]";
+
+    var tape: [32]Index.Entry = undefined;
+    var depth: [4]usize = undefined;
+    const index = try Index.init(data, &tape, &depth);
+
+    try testing.expectEqual(3, index.entries()[0].size);
+
+    const second = (try index.arrayGet(0, 1)).?;
+    const id = (try index.dictGet(second, "id")).?;
+
+    var container: [1]zcon.Container = undefined;
+    var context = try index.deserialize(id, &container);
+    try testing.expectEqual(2, try context.int());
+
+    const third = (try index.arrayGet(0, 2)).?;
+    context = try index.deserialize(third, &container);
+    try testing.expectEqual(3, try context.int());
+
+    try testing.expectEqual(null, try index.arrayGet(0, 3));
+    try testing.expectEqual(null, try index.dictGet(second, "name"));
+    try testing.expectError(error.NotDict, index.dictGet(0, "id"));
+    try testing.expectError(error.NotArray, index.arrayGet(second, 0));
+    try testing.expectError(error.Buffer, index.arrayGet(index.entries().len, 0));
+}
+
+test "index lookup escaped key" {
+    const data = "{\"a\\u00e9\": 1, \"\\\"\": 2}";
+
+    var tape: [8]Index.Entry = undefined;
+    var depth: [1]usize = undefined;
+    const index = try Index.init(data, &tape, &depth);
+
+    try testing.expectEqual(2, (try index.dictGet(0, "a\xc3\xa9")).?);
+    try testing.expectEqual(4, (try index.dictGet(0, "\"")).?);
+    try testing.expectEqual(null, try index.dictGet(0, "a"));
+}
+
+test "index deserialize container" {
+    const data = "{\"a\": [1, 2], \"b\": null}";
+
+    var tape: [16]Index.Entry = undefined;
+    var depth: [2]usize = undefined;
+    const index = try Index.init(data, &tape, &depth);
+
+    const array = (try index.dictGet(0, "a")).?;
+
+    var container: [1]zcon.Container = undefined;
+    var context = try index.deserialize(array, &container);
+    try context.arrayOpen();
+    try testing.expectEqual(1, try context.int());
+    try testing.expectEqual(2, try context.int());
+    try context.arrayClose();
+
+    const err = context.arrayOpen();
+    try testing.expectError(error.Complete, err);
+
+    try testing.expectError(error.Type, index.deserialize(index.entries()[array].next - 1, &container));
+}
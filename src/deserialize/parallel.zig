@@ -0,0 +1,202 @@
+const std = @import("std");
+const zcon = @import("../con.zig");
+const Deserialize = @import("deserialize.zig").Deserialize;
+
+// Splits newline delimited JSON in `data` into at most `chunks.len` chunks of
+// roughly equal size, each ending after a newline or at the end of `data`.
+// Every newline is taken to be a boundary between records, records must
+// therefore not contain raw newlines, e.g. inside a string, even though they
+// are accepted when deserializing. Returns the chunks written to `chunks`.
+pub fn splitLines(data: []const u8, chunks: [][]const u8) [][]const u8 {
+    var count: usize = 0;
+    var start: usize = 0;
+    for (0..chunks.len) |i| {
+        if (start >= data.len) {
+            break;
+        }
+
+        const target = @max(start, data.len / chunks.len * (i + 1));
+        var end = data.len;
+        if (i + 1 < chunks.len) {
+            if (std.mem.indexOfScalarPos(u8, data, target, '\n')) |newline| {
+                end = newline + 1;
+            }
+        }
+
+        chunks[count] = data[start..end];
+        count += 1;
+        start = end;
+    }
+    return chunks[0..count];
+}
+
+// Deserializes the newline delimited JSON in `data` on the threads of `pool`.
+// The input is split into `chunk_count` chunks with `splitLines`, more chunks
+// than threads let idle threads take over the work of slower ones. Every
+// record is passed to `callback` as a context positioned at its start, along
+// with `context` and the index of its chunk. Records of a chunk are passed in
+// order from a single thread, results can be merged in order by collecting
+// them per chunk.
+//
+// Records must not contain raw newlines, see `splitLines`. A record which is
+// split at one is seen as two invalid halves and makes its chunks fail.
+//
+// Returns the error of the first chunk which failed, if any.
+pub fn deserializeLines(
+    allocator: std.mem.Allocator,
+    pool: *std.Thread.Pool,
+    data: []const u8,
+    chunk_count: usize,
+    comptime depth: usize,
+    context: anytype,
+    comptime callback: fn (@TypeOf(context), usize, *Deserialize) anyerror!void,
+) !void {
+    const chunks = try allocator.alloc([]const u8, @max(chunk_count, 1));
+    defer allocator.free(chunks);
+
+    const results = try allocator.alloc(anyerror!void, chunks.len);
+    defer allocator.free(results);
+
+    const used = splitLines(data, chunks);
+
+    const Task = struct {
+        fn run(chunk: []const u8, index: usize, ctx: @TypeOf(context), result: *anyerror!void) void {
+            result.* = deserializeChunk(chunk, index, depth, ctx, callback);
+        }
+    };
+
+    var wait_group: std.Thread.WaitGroup = .{};
+    for (used, 0..) |chunk, i| {
+        pool.spawnWg(&wait_group, Task.run, .{ chunk, i, context, &results[i] });
+    }
+    pool.waitAndWork(&wait_group);
+
+    for (results[0..used.len]) |result| {
+        try result;
+    }
+}
+
+fn deserializeChunk(
+    chunk: []const u8,
+    index: usize,
+    comptime depth: usize,
+    context: anytype,
+    comptime callback: fn (@TypeOf(context), usize, *Deserialize) anyerror!void,
+) !void {
+    var depth_buffer: [depth]zcon.Container = undefined;
+    var deserialize = try Deserialize.initMemory(chunk, &depth_buffer);
+    while (try deserialize.record()) {
+        try callback(context, index, &deserialize);
+    }
+}
+
+const testing = std.testing;
+
+test "split lines" {
+    const data = "1\n22\n333\n4444\n";
+
+    var buffer: [3][]const u8 = undefined;
+    const chunks = splitLines(data, &buffer);
+
+    try testing.expectEqual(3, chunks.len);
+    try testing.expectEqualStrings("1\n22\n", chunks[0]);
+    try testing.expectEqualStrings("333\n", chunks[1]);
+    try testing.expectEqualStrings("4444\n", chunks[2]);
+}
+
+test "split lines long line" {
+    const data = "1\n22222222222222\n3";
+
+    var buffer: [4][]const u8 = undefined;
+    const chunks = splitLines(data, &buffer);
+
+    try testing.expectEqual(2, chunks.len);
+    try testing.expectEqualStrings("1\n22222222222222\n", chunks[0]);
+    try testing.expectEqualStrings("3", chunks[1]);
+}
+
+test "split lines empty" {
+    var buffer: [2][]const u8 = undefined;
+    const chunks = splitLines("", &buffer);
+    try testing.expectEqual(0, chunks.len);
+}
+
+const Sums = struct {
+    sums: []i64,
+
+    fn add(self: *const Sums, chunk: usize, deserialize: *Deserialize) anyerror!void {
+        try deserialize.arrayOpen();
+        while (try deserialize.next() != .array_close) {
+            self.sums[chunk] += try deserialize.int();
+        }
+        try deserialize.arrayClose();
+    }
+};
+
+test "deserialize lines" {
+    var data = std.ArrayList(u8).init(testing.allocator);
+    defer data.deinit();
+    for (0..1000) |i| {
+        try data.writer().print("[{d}, 1]\n", .{i});
+    }
+
+    var pool: std.Thread.Pool = undefined;
+    try pool.init(.{ .allocator = testing.allocator, .n_jobs = 4 });
+    defer pool.deinit();
+
+    var sums = [_]i64{0} ** 16;
+    const context = Sums{ .sums = &sums };
+    try deserializeLines(testing.allocator, &pool, data.items, sums.len, 1, &context, Sums.add);
+
+    var total: i64 = 0;
+    for (sums) |sum| {
+        total += sum;
+    }
+    try testing.expectEqual(999 * 1000 / 2 + 1000, total);
+}
+
+test "deserialize lines error" {
+    const data = "[1]\n[2]\n[x]\n[4]\n";
+
+    var pool: std.Thread.Pool = undefined;
+    try pool.init(.{ .allocator = testing.allocator, .n_jobs = 2 });
+    defer pool.deinit();
+
+    var sums = [_]i64{0} ** 4;
+    const context = Sums{ .sums = &sums };
+    const err = deserializeLines(testing.allocator, &pool, data, sums.len, 1, &context, Sums.add);
+    try testing.expectError(error.InvalidJson, err);
+}
+
+const Records = struct {
+    counts: []usize,
+
+    fn add(self: *const Records, chunk: usize, deserialize: *Deserialize) anyerror!void {
+        try deserialize.skip();
+        self.counts[chunk] += 1;
+    }
+};
+
+test "deserialize lines raw newline" {
+    const data = "[\"aaaaaa\nb\"]\n";
+
+    var pool: std.Thread.Pool = undefined;
+    try pool.init(.{ .allocator = testing.allocator, .n_jobs = 2 });
+    defer pool.deinit();
+
+    // In a single chunk the raw newline is accepted as part of the string.
+    var counts = [_]usize{0} ** 2;
+    const context = Records{ .counts = &counts };
+    try deserializeLines(testing.allocator, &pool, data, 1, 1, &context, Records.add);
+    try testing.expectEqual(1, counts[0]);
+
+    // Split in two at the raw newline, neither half is a valid record.
+    var buffer: [2][]const u8 = undefined;
+    const chunks = splitLines(data, &buffer);
+    try testing.expectEqual(2, chunks.len);
+    try testing.expectEqualStrings("[\"aaaaaa\n", chunks[0]);
+
+    if (deserializeLines(testing.allocator, &pool, data, 2, 1, &context, Records.add)) |_| {
+        return error.TestUnexpectedResult;
+    } else |_| {}
+}
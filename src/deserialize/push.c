@@ -0,0 +1,479 @@
+#include <assert.h>
+#include <ctype.h>
+#include <utils.h>
+#include "con_push.h"
+
+static inline enum ConError con_push_exhausted(struct ConPush const *context);
+static inline enum ConError con_push_write(struct ConPush *context, char const *data, size_t data_size);
+static inline enum ConContainer con_push_container_current(struct ConPush const *context);
+static inline bool con_push_token_end_valid(char c);
+static inline enum ConError con_push_token(struct ConPush *context, enum ConDeserializeType *type);
+static inline enum ConError con_push_colon(struct ConPush *context);
+static inline enum ConError con_push_string(struct ConPush *context, enum ConDeserializeType *type);
+static inline enum ConError con_push_escape(struct ConPush *context);
+static inline enum ConError con_push_unicode(struct ConPush *context);
+static inline enum ConError con_push_low(struct ConPush *context, char expected);
+static inline enum ConError con_push_number(struct ConPush *context, enum ConDeserializeType *type);
+static inline enum ConError con_push_literal(struct ConPush *context, enum ConDeserializeType *type);
+
+enum ConError con_push_init(
+    struct ConPush *context,
+    struct GciInterfaceWriter writer,
+    enum ConContainer *depth_buffer,
+    int depth_buffer_size
+) {
+    if (context == NULL) { return CON_ERROR_NULL; }
+    if (depth_buffer == NULL && depth_buffer_size > 0) { return CON_ERROR_NULL; }
+    if (depth_buffer_size < 0) { return CON_ERROR_BUFFER; }
+
+    context->writer = writer;
+    context->depth = 0;
+    con_utils_depth_init(&context->depth_stack, depth_buffer, (size_t) depth_buffer_size);
+    context->data = NULL;
+    context->data_size = 0;
+    context->data_offset = 0;
+    context->end = false;
+    context->boolean = false;
+    context->state = con_utils_state_init();
+    context->found_comma = false;
+    context->token_end = false;
+    context->lexer = CON_PUSH_LEXER_TOKEN;
+    context->key = false;
+    context->number = NUMBER_START;
+    context->literal = NULL;
+    context->literal_offset = 0;
+    context->code_unit = 0;
+    context->digits = 0;
+    context->high_surrogate = 0;
+
+    return CON_ERROR_OK;
+}
+
+enum ConError con_push_feed(struct ConPush *context, char const *data, size_t data_size) {
+    if (context == NULL) { return CON_ERROR_NULL; }
+    if (data == NULL && data_size > 0) { return CON_ERROR_NULL; }
+    if (context->end) { return CON_ERROR_READER; }
+    if (context->data_offset < context->data_size) { return CON_ERROR_BUFFER; }
+
+    context->data = data;
+    context->data_size = data_size;
+    context->data_offset = 0;
+    return CON_ERROR_OK;
+}
+
+enum ConError con_push_finish(struct ConPush *context) {
+    if (context == NULL) { return CON_ERROR_NULL; }
+
+    context->end = true;
+    return CON_ERROR_OK;
+}
+
+enum ConError con_push_next(struct ConPush *context, enum ConDeserializeType *type) {
+    if (context == NULL) { return CON_ERROR_NULL; }
+    if (type == NULL) { return CON_ERROR_NULL; }
+
+    // Every step either completes a token or moves on to the next lexer state,
+    // steps which run out of input return and are repeated with the next chunk.
+    *type = CON_DESERIALIZE_TYPE_UNKNOWN;
+    while (*type == CON_DESERIALIZE_TYPE_UNKNOWN) {
+        enum ConError err;
+        switch (context->lexer) {
+            case CON_PUSH_LEXER_TOKEN:
+                err = con_push_token(context, type);
+                break;
+            case CON_PUSH_LEXER_COLON:
+                err = con_push_colon(context);
+                break;
+            case CON_PUSH_LEXER_STRING:
+                err = con_push_string(context, type);
+                break;
+            case CON_PUSH_LEXER_ESCAPE:
+                err = con_push_escape(context);
+                break;
+            case CON_PUSH_LEXER_UNICODE:
+                err = con_push_unicode(context);
+                break;
+            case CON_PUSH_LEXER_LOW_ESCAPE:
+                err = con_push_low(context, '\\');
+                break;
+            case CON_PUSH_LEXER_LOW_U:
+                err = con_push_low(context, 'u');
+                break;
+            case CON_PUSH_LEXER_NUMBER:
+                err = con_push_number(context, type);
+                break;
+            case CON_PUSH_LEXER_LITERAL:
+                err = con_push_literal(context, type);
+                break;
+            default:
+                assert(false);
+                return CON_ERROR_STATE_UNKNOWN;
+        }
+
+        if (err) { return err; }
+    }
+
+    return CON_ERROR_OK;
+}
+
+enum ConError con_push_record(struct ConPush *context) {
+    if (context == NULL) { return CON_ERROR_NULL; }
+    if (context->state != CON_STATE_EMPTY && context->state != CON_STATE_COMPLETE) { return CON_ERROR_INCOMPLETE; }
+    if (context->lexer != CON_PUSH_LEXER_TOKEN) { return CON_ERROR_INCOMPLETE; }
+    assert(context->depth == 0);
+
+    // The state is reset but a number or literal ending the previous element
+    // must still be separated from the next one.
+    context->state = con_utils_state_init();
+    context->found_comma = false;
+    return CON_ERROR_OK;
+}
+
+static inline enum ConError con_push_exhausted(struct ConPush const *context) {
+    assert(context != NULL);
+    assert(context->data_offset == context->data_size);
+    return context->end ? CON_ERROR_READER : CON_ERROR_NEED_INPUT;
+}
+
+static inline enum ConError con_push_write(struct ConPush *context, char const *data, size_t data_size) {
+    assert(context != NULL);
+
+    size_t amount_written = gci_writer_write(context->writer, data, data_size);
+    if (amount_written != data_size) { return CON_ERROR_WRITER; }
+    return CON_ERROR_OK;
+}
+
+static inline enum ConContainer con_push_container_current(struct ConPush const *context) {
+    assert(context != NULL);
+    return con_utils_depth_current(&context->depth_stack, context->depth);
+}
+
+// Consumes whitespace and commas up to the start of the next token, containers
+// are opened and closed right away, other tokens continue in their own lexer
+// state.
+static inline bool con_push_token_end_valid(char c) {
+    return isspace((unsigned char) c) || c == ',' || c == ']' || c == '}' || c == '"';
+}
+
+static inline enum ConError con_push_token(struct ConPush *context, enum ConDeserializeType *type) {
+    assert(context != NULL);
+    assert(type != NULL);
+
+    // A number, bool or null must be followed by whitespace, the end of a
+    // container, a comma or the end of the input, like when deserializing.
+    // Checked before completion so that e.g. `01` is not accepted as `0`.
+    if (context->token_end) {
+        if (context->data_offset < context->data_size) {
+            if (!con_push_token_end_valid(context->data[context->data_offset])) { return CON_ERROR_INVALID_JSON; }
+        } else if (!context->end) {
+            return CON_ERROR_NEED_INPUT;
+        }
+        context->token_end = false;
+    }
+
+    if (context->state == CON_STATE_COMPLETE) { return CON_ERROR_COMPLETE; }
+
+    char const *data = context->data + context->data_offset;
+    size_t available = context->data_size - context->data_offset;
+    size_t skipped = con_utils_whitespace_skip(data, available);
+    context->data_offset += skipped;
+
+    if (skipped == available) { return con_push_exhausted(context); }
+
+    char c = data[skipped];
+    enum ConContainer current = con_push_container_current(context);
+
+    if (c == ',') {
+        if (context->found_comma) { return CON_ERROR_COMMA_MULTIPLE; }
+        if (context->state != CON_STATE_LATER) { return CON_ERROR_COMMA_UNEXPECTED; }
+
+        context->found_comma = true;
+        context->data_offset += 1;
+        return CON_ERROR_OK;
+    }
+
+    if (c == ']' || c == '}') {
+        if (context->found_comma) { return CON_ERROR_COMMA_TRAILING; }
+        if (context->depth == 0) { return CON_ERROR_CLOSED_TOO_MANY; }
+        if (c == ']' && current != CON_CONTAINER_ARRAY) { return CON_ERROR_NOT_ARRAY; }
+        if (c == '}' && current != CON_CONTAINER_DICT) { return CON_ERROR_NOT_DICT; }
+        if (context->state == CON_STATE_VALUE) { return CON_ERROR_VALUE; }
+
+        enum ConError state_err = con_utils_state_close(&context->state, current);
+        if (state_err) { return state_err; }
+
+        context->depth -= 1;
+        if (context->depth == 0) {
+            context->state = CON_STATE_COMPLETE;
+        }
+
+        context->data_offset += 1;
+        *type = c == ']' ? CON_DESERIALIZE_TYPE_ARRAY_CLOSE : CON_DESERIALIZE_TYPE_DICT_CLOSE;
+        return CON_ERROR_OK;
+    }
+
+    if (context->state == CON_STATE_LATER && !context->found_comma) { return CON_ERROR_COMMA_MISSING; }
+    context->found_comma = false;
+
+    if (c == '"' && current == CON_CONTAINER_DICT && (context->state == CON_STATE_FIRST || context->state == CON_STATE_LATER)) {
+        enum ConError state_err = con_utils_state_key(&context->state, current);
+        if (state_err) { return state_err; }
+
+        context->key = true;
+        context->lexer = CON_PUSH_LEXER_STRING;
+        context->data_offset += 1;
+        return CON_ERROR_OK;
+    }
+
+    if (c == '[' || c == '{') {
+        enum ConError state_err = con_utils_state_open(&context->state, current);
+        if (state_err) { return state_err; }
+        enum ConError depth_err = con_utils_depth_reserve(&context->depth_stack, context->depth + 1);
+        if (depth_err) { return depth_err; }
+
+        enum ConContainer container = c == '[' ? CON_CONTAINER_ARRAY : CON_CONTAINER_DICT;
+        con_utils_depth_set(&context->depth_stack, context->depth, container);
+        context->depth += 1;
+
+        context->data_offset += 1;
+        *type = c == '[' ? CON_DESERIALIZE_TYPE_ARRAY_OPEN : CON_DESERIALIZE_TYPE_DICT_OPEN;
+        return CON_ERROR_OK;
+    }
+
+    enum ConPushLexer lexer;
+    if (c == '"') {
+        lexer = CON_PUSH_LEXER_STRING;
+        context->key = false;
+        context->data_offset += 1;
+    } else if (isdigit((unsigned char) c) || c == '-') {
+        lexer = CON_PUSH_LEXER_NUMBER;
+        context->number = NUMBER_START;
+    } else if (c == 't' || c == 'f' || c == 'n') {
+        lexer = CON_PUSH_LEXER_LITERAL;
+        context->literal = c == 't' ? "true" : (c == 'f' ? "false" : "null");
+        context->literal_offset = 0;
+    } else {
+        return CON_ERROR_INVALID_JSON;
+    }
+
+    enum ConError state_err = con_utils_state_next(&context->state, current);
+    if (state_err) { return state_err; }
+
+    context->lexer = lexer;
+    return CON_ERROR_OK;
+}
+
+static inline enum ConError con_push_colon(struct ConPush *context) {
+    assert(context != NULL);
+
+    char const *data = context->data + context->data_offset;
+    size_t available = context->data_size - context->data_offset;
+    size_t skipped = con_utils_whitespace_skip(data, available);
+    context->data_offset += skipped;
+
+    if (skipped == available) { return con_push_exhausted(context); }
+    if (data[skipped] != ':') { return CON_ERROR_INVALID_JSON; }
+
+    context->data_offset += 1;
+    context->lexer = CON_PUSH_LEXER_TOKEN;
+    return CON_ERROR_OK;
+}
+
+// Writes the body of a string up to the next `"` or `\` with a single write
+// per chunk.
+static inline enum ConError con_push_string(struct ConPush *context, enum ConDeserializeType *type) {
+    assert(context != NULL);
+    assert(type != NULL);
+
+    char const *data = context->data + context->data_offset;
+    size_t available = context->data_size - context->data_offset;
+    size_t length = con_utils_string_span(data, available);
+
+    if (length > 0) {
+        context->data_offset += length;
+        enum ConError err = con_push_write(context, data, length);
+        if (err) { return err; }
+    }
+    if (length == available) { return con_push_exhausted(context); }
+
+    context->data_offset += 1;
+    if (data[length] == '\\') {
+        context->lexer = CON_PUSH_LEXER_ESCAPE;
+        return CON_ERROR_OK;
+    }
+
+    assert(data[length] == '"');
+    if (context->key) {
+        context->lexer = CON_PUSH_LEXER_COLON;
+        *type = CON_DESERIALIZE_TYPE_DICT_KEY;
+    } else {
+        context->lexer = CON_PUSH_LEXER_TOKEN;
+        *type = CON_DESERIALIZE_TYPE_STRING;
+    }
+    return CON_ERROR_OK;
+}
+
+static inline enum ConError con_push_escape(struct ConPush *context) {
+    assert(context != NULL);
+    if (context->data_offset == context->data_size) { return con_push_exhausted(context); }
+
+    char c = context->data[context->data_offset];
+    context->data_offset += 1;
+
+    switch (c) {
+        case '"':
+        case '\\':
+        case '/':
+            break;
+        case 'b':
+            c = '\b';
+            break;
+        case 'f':
+            c = '\f';
+            break;
+        case 'n':
+            c = '\n';
+            break;
+        case 'r':
+            c = '\r';
+            break;
+        case 't':
+            c = '\t';
+            break;
+        case 'u':
+            context->code_unit = 0;
+            context->digits = 0;
+            context->high_surrogate = 0;
+            context->lexer = CON_PUSH_LEXER_UNICODE;
+            return CON_ERROR_OK;
+        default:
+            return CON_ERROR_INVALID_JSON;
+    }
+
+    context->lexer = CON_PUSH_LEXER_STRING;
+    return con_push_write(context, &c, 1);
+}
+
+// Collects the four hex digits of a `\u` escape, a high surrogate is kept
+// until the low surrogate of the escape following it is read.
+static inline enum ConError con_push_unicode(struct ConPush *context) {
+    assert(context != NULL);
+
+    while (context->digits < 4) {
+        if (context->data_offset == context->data_size) { return con_push_exhausted(context); }
+
+        unsigned int digit = con_utils_hex_digit(context->data[context->data_offset]);
+        if (digit == 0) { return CON_ERROR_INVALID_JSON; }
+
+        context->code_unit = 16 * context->code_unit + digit - 1;
+        context->digits += 1;
+        context->data_offset += 1;
+    }
+
+    unsigned int code_point = context->code_unit;
+    bool low = 0xDC00 <= code_point && code_point <= 0xDFFF;
+    if (context->high_surrogate == 0) {
+        if (low) { return CON_ERROR_SURROGATE; }  // low surrogate without high surrogate
+        if (0xD800 <= code_point && code_point <= 0xDBFF) {
+            context->high_surrogate = code_point;
+            context->lexer = CON_PUSH_LEXER_LOW_ESCAPE;
+            return CON_ERROR_OK;
+        }
+    } else {
+        if (!low) { return CON_ERROR_SURROGATE; }
+        code_point = 0x10000 + ((context->high_surrogate - 0xD800) << 10) + (code_point - 0xDC00);
+        context->high_surrogate = 0;
+    }
+
+    char c[4];
+    size_t length = con_utils_utf8_encode(c, code_point);
+    context->lexer = CON_PUSH_LEXER_STRING;
+    return con_push_write(context, c, length);
+}
+
+// Reads the `\` or the `u` of the escape which must follow a high surrogate.
+static inline enum ConError con_push_low(struct ConPush *context, char expected) {
+    assert(context != NULL);
+    assert(context->high_surrogate != 0);
+    if (context->data_offset == context->data_size) { return con_push_exhausted(context); }
+
+    char c = context->data[context->data_offset];
+    if (c != expected) { return CON_ERROR_SURROGATE; }
+    context->data_offset += 1;
+
+    if (expected == '\\') {
+        context->lexer = CON_PUSH_LEXER_LOW_U;
+    } else {
+        context->code_unit = 0;
+        context->digits = 0;
+        context->lexer = CON_PUSH_LEXER_UNICODE;
+    }
+    return CON_ERROR_OK;
+}
+
+// Writes the characters of a number which are in the current chunk, the number
+// ends at the first character which cannot continue it. That character is left
+// for the next token.
+static inline enum ConError con_push_number(struct ConPush *context, enum ConDeserializeType *type) {
+    assert(context != NULL);
+    assert(type != NULL);
+
+    char const *data = context->data + context->data_offset;
+    size_t available = context->data_size - context->data_offset;
+    enum StateNumber state = (enum StateNumber) context->number;
+
+    size_t length = 0;
+    while (length < available) {
+        enum StateNumber next = con_utils_state_number_next(state, data[length]);
+        if (next == NUMBER_ERROR) { break; }
+
+        state = next;
+        length += 1;
+    }
+
+    context->number = state;
+    if (length > 0) {
+        context->data_offset += length;
+        enum ConError err = con_push_write(context, data, length);
+        if (err) { return err; }
+    }
+
+    if (length == available && !context->end) { return CON_ERROR_NEED_INPUT; }
+    if (!con_utils_state_number_terminal(state)) {
+        return length == available ? CON_ERROR_READER : CON_ERROR_INVALID_JSON;
+    }
+    if (length < available && !con_push_token_end_valid(data[length])) { return CON_ERROR_INVALID_JSON; }
+
+    context->token_end = true;
+    context->lexer = CON_PUSH_LEXER_TOKEN;
+    *type = CON_DESERIALIZE_TYPE_NUMBER;
+    return CON_ERROR_OK;
+}
+
+static inline enum ConError con_push_literal(struct ConPush *context, enum ConDeserializeType *type) {
+    assert(context != NULL);
+    assert(context->literal != NULL);
+    assert(type != NULL);
+
+    char const *literal = context->literal;
+    while (literal[context->literal_offset] != '\0') {
+        if (context->data_offset == context->data_size) { return con_push_exhausted(context); }
+        if (context->data[context->data_offset] != literal[context->literal_offset]) { return CON_ERROR_INVALID_JSON; }
+
+        context->data_offset += 1;
+        context->literal_offset += 1;
+    }
+    if (context->data_offset < context->data_size && !con_push_token_end_valid(context->data[context->data_offset])) {
+        return CON_ERROR_INVALID_JSON;
+    }
+
+    context->token_end = true;
+    context->lexer = CON_PUSH_LEXER_TOKEN;
+    if (literal[0] == 'n') {
+        *type = CON_DESERIALIZE_TYPE_NULL;
+    } else {
+        context->boolean = literal[0] == 't';
+        *type = CON_DESERIALIZE_TYPE_BOOL;
+    }
+    return CON_ERROR_OK;
+}
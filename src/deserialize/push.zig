@@ -0,0 +1,187 @@
+const std = @import("std");
+const gci = @import("gci");
+const zcon = @import("../con.zig");
+const internal = @import("../internal.zig");
+const lib = internal.lib;
+const Type = @import("deserialize.zig").Type;
+
+pub const Push = struct {
+    inner: lib.ConPush,
+
+    pub fn init(writer: gci.InterfaceWriter, depth: []zcon.Container) !Push {
+        if (depth.len > std.math.maxInt(c_int)) {
+            return error.Overflow;
+        }
+
+        var context = Push{ .inner = undefined };
+        const err = lib.con_push_init(
+            &context.inner,
+            @as(*lib.GciInterfaceWriter, @ptrCast(@constCast(&writer.writer))).*,
+            depth.ptr,
+            @intCast(depth.len),
+        );
+
+        try internal.enumToError(err);
+        return context;
+    }
+
+    pub fn feed(self: *Push, data: []const u8) !void {
+        const err = lib.con_push_feed(&self.inner, data.ptr, data.len);
+        return internal.enumToError(err);
+    }
+
+    pub fn finish(self: *Push) void {
+        const err = lib.con_push_finish(&self.inner);
+        std.debug.assert(err == lib.CON_ERROR_OK);
+    }
+
+    // Returns the next token, or null if the current chunk ran out before the
+    // token was complete and another one has to be fed.
+    pub fn next(self: *Push) !?Type {
+        var token_type: lib.ConDeserializeType = undefined;
+        const err = lib.con_push_next(&self.inner, &token_type);
+        if (err == lib.CON_ERROR_NEED_INPUT) {
+            return null;
+        }
+        try internal.enumToError(err);
+
+        return switch (token_type) {
+            lib.CON_DESERIALIZE_TYPE_NUMBER => .number,
+            lib.CON_DESERIALIZE_TYPE_STRING => .string,
+            lib.CON_DESERIALIZE_TYPE_BOOL => .bool,
+            lib.CON_DESERIALIZE_TYPE_NULL => .null,
+            lib.CON_DESERIALIZE_TYPE_ARRAY_OPEN => .array_open,
+            lib.CON_DESERIALIZE_TYPE_ARRAY_CLOSE => .array_close,
+            lib.CON_DESERIALIZE_TYPE_DICT_OPEN => .dict_open,
+            lib.CON_DESERIALIZE_TYPE_DICT_CLOSE => .dict_close,
+            lib.CON_DESERIALIZE_TYPE_DICT_KEY => .dict_key,
+            else => error.Unknown,
+        };
+    }
+
+    // Value of the last bool returned by `next`.
+    pub fn boolean(self: *const Push) bool {
+        return self.inner.boolean;
+    }
+
+    pub fn record(self: *Push) !void {
+        const err = lib.con_push_record(&self.inner);
+        return internal.enumToError(err);
+    }
+};
+
+const testing = std.testing;
+
+// Feeds `data` in chunks of `chunk` bytes and writes one line per token.
+fn pushChunks(data: []const u8, chunk: usize, out: []u8) ![]const u8 {
+    var text: [64]u8 = undefined;
+    var writer = try gci.WriterString.init(&text);
+
+    var depth: [4]zcon.Container = undefined;
+    var context = try Push.init(writer.interface(), &depth);
+
+    var length: usize = 0;
+    var position: usize = 0;
+    while (true) {
+        const token = context.next() catch |err| switch (err) {
+            error.Complete => break,
+            else => return err,
+        };
+
+        if (token) |t| {
+            const written = text[0..writer.inner.current];
+            const line = switch (t) {
+                .bool => try std.fmt.bufPrint(out[length..], "bool {}\n", .{context.boolean()}),
+                else => try std.fmt.bufPrint(out[length..], "{s} {s}\n", .{ @tagName(t), written }),
+            };
+            length += line.len;
+            writer.inner.current = 0;
+        } else if (position < data.len) {
+            const end = @min(position + chunk, data.len);
+            try context.feed(data[position..end]);
+            position = end;
+        } else {
+            context.finish();
+        }
+    }
+
+    return out[0..length];
+}
+
+test "push chunks" {
+    const data = "{\"k\\u00e9y\": [12.5e-1, \"a\\\"b\\ud83d\\ude00\", true, null], \"n\": -7}";
+    const expected =
+        "dict_open \n" ++
+        "dict_key k\xc3\xa9y\n" ++
+        "array_open \n" ++
+        "number 12.5e-1\n" ++
+        "string a\"b\xf0\x9f\x98\x80\n" ++
+        "bool true\n" ++
+        "null \n" ++
+        "array_close \n" ++
+        "dict_key n\n" ++
+        "number -7\n" ++
+        "dict_close \n";
+
+    for ([_]usize{ 1, 2, 3, 7, data.len }) |chunk| {
+        var out: [256]u8 = undefined;
+        try testing.expectEqualStrings(expected, try pushChunks(data, chunk, &out));
+    }
+}
+
+test "push number at end" {
+    var text: [8]u8 = undefined;
+    var writer = try gci.WriterString.init(&text);
+
+    var depth: [0]zcon.Container = undefined;
+    var context = try Push.init(writer.interface(), &depth);
+
+    try context.feed("-1");
+    try testing.expectEqual(null, try context.next());
+    try context.feed("0");
+    try testing.expectEqual(null, try context.next());
+
+    context.finish();
+    try testing.expectEqual(.number, try context.next());
+    try testing.expectEqualStrings("-10", text[0..writer.inner.current]);
+    try testing.expectError(error.Complete, context.next());
+}
+
+test "push records" {
+    var text: [8]u8 = undefined;
+    var writer = try gci.WriterString.init(&text);
+
+    var depth: [1]zcon.Container = undefined;
+    var context = try Push.init(writer.interface(), &depth);
+
+    try context.feed("[true]\n[fa");
+    try testing.expectEqual(.array_open, try context.next());
+    try testing.expectEqual(.bool, try context.next());
+    try testing.expectEqual(.array_close, try context.next());
+    try testing.expectError(error.Complete, context.next());
+
+    try context.record();
+    try testing.expectEqual(.array_open, try context.next());
+    try testing.expectEqual(null, try context.next());
+
+    try context.feed("lse]");
+    try testing.expectEqual(.bool, try context.next());
+    try testing.expectEqual(false, context.boolean());
+    try testing.expectEqual(.array_close, try context.next());
+}
+
+test "push incomplete" {
+    var text: [8]u8 = undefined;
+    var writer = try gci.WriterString.init(&text);
+
+    var depth: [1]zcon.Container = undefined;
+    var context = try Push.init(writer.interface(), &depth);
+
+    try context.feed("[\"ab");
+    try testing.expectEqual(.array_open, try context.next());
+    try testing.expectEqual(null, try context.next());
+    try testing.expectError(error.Incomplete, context.record());
+
+    context.finish();
+    try testing.expectError(error.Reader, context.next());
+}
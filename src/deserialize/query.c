@@ -0,0 +1,228 @@
+#include <assert.h>
+#include <string.h>
+#include "con_query.h"
+
+// Compares a decoded key, written in pieces, to the token of a segment.
+struct ConQueryKeyCompare {
+    struct ConQuerySegment const *segment;
+    size_t position;
+    bool equal;
+};
+
+static inline size_t con_query_index(char const *token, size_t token_size);
+static inline bool con_query_wildcard(struct ConQuerySegment const *segment);
+static void con_query_compare(struct ConQueryKeyCompare *compare, char const *data, size_t data_size);
+static size_t con_query_key_write(void const *void_context, char const *data, size_t data_size);
+static enum ConError con_query_key(struct ConQuerySegment const *segment, struct ConDeserialize *context, bool *match);
+static enum ConError con_query_open(struct ConQuery *query, struct ConDeserialize *context);
+
+enum ConError con_query_init(
+    struct ConQuery *query,
+    char const *pointer,
+    size_t pointer_size,
+    struct ConQuerySegment *segments,
+    size_t segments_size
+) {
+    if (query == NULL) { return CON_ERROR_NULL; }
+    if (pointer == NULL && pointer_size > 0) { return CON_ERROR_NULL; }
+    if (segments == NULL && segments_size > 0) { return CON_ERROR_NULL; }
+    if (pointer_size > 0 && pointer[0] != '/') { return CON_ERROR_QUERY; }
+
+    size_t length = 0;
+    size_t position = 0;
+    while (position < pointer_size) {
+        assert(pointer[position] == '/');
+        position += 1;
+
+        size_t start = position;
+        while (position < pointer_size && pointer[position] != '/') {
+            if (pointer[position] == '~') {
+                if (position + 1 >= pointer_size) { return CON_ERROR_QUERY; }
+                if (pointer[position + 1] != '0' && pointer[position + 1] != '1') { return CON_ERROR_QUERY; }
+                position += 1;
+            }
+            position += 1;
+        }
+
+        if (length >= segments_size) { return CON_ERROR_BUFFER; }
+        segments[length] = (struct ConQuerySegment) {
+            .token = pointer + start,
+            .token_size = position - start,
+            .index = con_query_index(pointer + start, position - start),
+            .position = 0,
+        };
+        length += 1;
+    }
+
+    query->segments = segments;
+    query->segments_size = segments_size;
+    query->segments_length = length;
+    query->depth = 0;
+    query->started = false;
+    query->done = false;
+
+    return CON_ERROR_OK;
+}
+
+enum ConError con_query_next(struct ConQuery *query, struct ConDeserialize *context, bool *found) {
+    if (query == NULL) { return CON_ERROR_NULL; }
+    if (context == NULL) { return CON_ERROR_NULL; }
+    if (found == NULL) { return CON_ERROR_NULL; }
+
+    *found = false;
+    if (query->done) { return CON_ERROR_OK; }
+
+    if (!query->started) {
+        query->started = true;
+        query->depth = context->depth;
+
+        if (query->segments_length == 0) {
+            query->done = true;
+            *found = true;
+            return CON_ERROR_OK;
+        }
+
+        enum ConError open_err = con_query_open(query, context);
+        if (open_err) { return open_err; }
+    } else if (context->depth != query->depth + query->segments_length || context->state != CON_STATE_LATER) {
+        return CON_ERROR_INCOMPLETE;
+    }
+
+    while (context->depth > query->depth) {
+        size_t level = context->depth - query->depth;
+        assert(level <= query->segments_length);
+        struct ConQuerySegment *segment = &query->segments[level - 1];
+
+        enum ConDeserializeType type;
+        enum ConError next_err = con_deserialize_next(context, &type);
+        if (next_err) { return next_err; }
+
+        if (type == CON_DESERIALIZE_TYPE_ARRAY_CLOSE) {
+            enum ConError close_err = con_deserialize_array_close(context);
+            if (close_err) { return close_err; }
+            continue;
+        } else if (type == CON_DESERIALIZE_TYPE_DICT_CLOSE) {
+            enum ConError close_err = con_deserialize_dict_close(context);
+            if (close_err) { return close_err; }
+            continue;
+        }
+
+        bool match;
+        if (type == CON_DESERIALIZE_TYPE_DICT_KEY) {
+            enum ConError key_err = con_query_key(segment, context, &match);
+            if (key_err) { return key_err; }
+        } else {
+            match = con_query_wildcard(segment) || segment->index == segment->position;
+            segment->position += 1;
+        }
+
+        if (!match) {
+            enum ConError skip_err = con_deserialize_skip(context);
+            if (skip_err) { return skip_err; }
+        } else if (level == query->segments_length) {
+            *found = true;
+            return CON_ERROR_OK;
+        } else {
+            enum ConError open_err = con_query_open(query, context);
+            if (open_err) { return open_err; }
+        }
+    }
+
+    query->done = true;
+    return CON_ERROR_OK;
+}
+
+static inline size_t con_query_index(char const *token, size_t token_size) {
+    assert(token != NULL || token_size == 0);
+    if (token_size == 0) { return CON_QUERY_NONE; }
+    if (token_size > 1 && token[0] == '0') { return CON_QUERY_NONE; }
+
+    size_t index = 0;
+    for (size_t i = 0; i < token_size; i++) {
+        if (token[i] < '0' || '9' < token[i]) { return CON_QUERY_NONE; }
+
+        size_t digit = (size_t) (token[i] - '0');
+        if (index > (SIZE_MAX - 1 - digit) / 10) { return CON_QUERY_NONE; }
+        index = index * 10 + digit;
+    }
+    return index;
+}
+
+static inline bool con_query_wildcard(struct ConQuerySegment const *segment) {
+    assert(segment != NULL);
+    return segment->token_size == 1 && segment->token[0] == '*';
+}
+
+static void con_query_compare(struct ConQueryKeyCompare *compare, char const *data, size_t data_size) {
+    assert(compare != NULL);
+    assert(data != NULL || data_size == 0);
+
+    struct ConQuerySegment const *segment = compare->segment;
+    for (size_t i = 0; i < data_size && compare->equal; i++) {
+        if (compare->position >= segment->token_size) {
+            compare->equal = false;
+            break;
+        }
+
+        char expected = segment->token[compare->position];
+        compare->position += 1;
+        if (expected == '~') {
+            expected = segment->token[compare->position] == '0' ? '~' : '/';
+            compare->position += 1;
+        }
+
+        compare->equal = data[i] == expected;
+    }
+}
+
+// Accepts the whole key even after a mismatch, the key has to be read
+// completely for the context to stay usable.
+static size_t con_query_key_write(void const *void_context, char const *data, size_t data_size) {
+    struct ConQueryKeyCompare *compare = (struct ConQueryKeyCompare*) void_context;
+    con_query_compare(compare, data, data_size);
+    return data_size;
+}
+
+static enum ConError con_query_key(struct ConQuerySegment const *segment, struct ConDeserialize *context, bool *match) {
+    assert(segment != NULL);
+    assert(context != NULL);
+    assert(match != NULL);
+
+    struct ConQueryKeyCompare compare = { .segment = segment, .position = 0, .equal = true };
+    struct GciInterfaceWriter writer = { .context = &compare, .write = con_query_key_write };
+
+    char const *key;
+    size_t key_size;
+    enum ConError err = con_deserialize_dict_key_view(context, &key, &key_size, writer);
+    if (err) { return err; }
+
+    if (key != NULL) {
+        con_query_compare(&compare, key, key_size);
+    }
+
+    *match = con_query_wildcard(segment) || (compare.equal && compare.position == segment->token_size);
+    return CON_ERROR_OK;
+}
+
+// Enters the next value if it is a container, the next segment is matched
+// against its contents. Other values can not contain a match and are skipped.
+static enum ConError con_query_open(struct ConQuery *query, struct ConDeserialize *context) {
+    assert(query != NULL);
+    assert(context != NULL);
+
+    size_t level = context->depth - query->depth;
+    assert(level < query->segments_length);
+
+    enum ConDeserializeType type;
+    enum ConError next_err = con_deserialize_next(context, &type);
+    if (next_err) { return next_err; }
+
+    if (type == CON_DESERIALIZE_TYPE_ARRAY_OPEN) {
+        query->segments[level].position = 0;
+        return con_deserialize_array_open(context);
+    } else if (type == CON_DESERIALIZE_TYPE_DICT_OPEN) {
+        return con_deserialize_dict_open(context);
+    }
+
+    return con_deserialize_skip(context);
+}
@@ -0,0 +1,169 @@
+const std = @import("std");
+const gci = @import("gci");
+const zcon = @import("../con.zig");
+const internal = @import("../internal.zig");
+const lib = internal.lib;
+const Deserialize = @import("deserialize.zig").Deserialize;
+
+pub const Query = struct {
+    inner: lib.ConQuery,
+
+    pub const Segment = lib.ConQuerySegment;
+
+    pub fn init(pointer: []const u8, segments: []Segment) !Query {
+        var query = Query{ .inner = undefined };
+        const err = lib.con_query_init(
+            &query.inner,
+            pointer.ptr,
+            pointer.len,
+            segments.ptr,
+            segments.len,
+        );
+
+        try internal.enumToError(err);
+        return query;
+    }
+
+    // Positions `context` before the next match and returns true, or returns
+    // false once the element has been read completely.
+    pub fn next(self: *Query, context: *Deserialize) !bool {
+        var found: bool = undefined;
+        const err = lib.con_query_next(&self.inner, &context.inner, &found);
+        try internal.enumToError(err);
+        return found;
+    }
+};
+
+const testing = std.testing;
+
+test "query wildcard" {
+    const data = "{\"items\": [{\"id\": 1, \"tags\": [\"x\"]}, {\"name\": \"b\"}, {\"id\": 3}], \"id\": 4}";
+
+    var depth: [3]zcon.Container = undefined;
+    var context = try Deserialize.initMemory(data, &depth);
+
+    var segments: [3]Query.Segment = undefined;
+    var query = try Query.init("/items/*/id", &segments);
+
+    var ids: [4]i64 = undefined;
+    var count: usize = 0;
+    while (try query.next(&context)) {
+        ids[count] = try context.int();
+        count += 1;
+    }
+
+    try testing.expectEqualSlices(i64, &.{ 1, 3 }, ids[0..count]);
+    try testing.expectEqual(false, try query.next(&context));
+
+    const err = context.skip();
+    try testing.expectError(error.Complete, err);
+}
+
+test "query index" {
+    const data = "[[1, 2], [3, 4], [5, 6]]";
+
+    var depth: [2]zcon.Container = undefined;
+    var context = try Deserialize.initMemory(data, &depth);
+
+    var segments: [2]Query.Segment = undefined;
+    var query = try Query.init("/2/0", &segments);
+
+    try testing.expect(try query.next(&context));
+    try testing.expectEqual(5, try context.int());
+    try testing.expect(!try query.next(&context));
+}
+
+test "query escaped tokens" {
+    const data = "{\"a/b\": {\"m~n\": true}, \"\": null}";
+
+    var depth: [2]zcon.Container = undefined;
+    var segments: [2]Query.Segment = undefined;
+
+    var context = try Deserialize.initMemory(data, &depth);
+    var query = try Query.init("/a~1b/m~0n", &segments);
+    try testing.expect(try query.next(&context));
+    try testing.expectEqual(true, try context.@"bool"());
+    try testing.expect(!try query.next(&context));
+
+    context = try Deserialize.initMemory(data, &depth);
+    query = try Query.init("/", &segments);
+    try testing.expect(try query.next(&context));
+    try context.@"null"();
+    try testing.expect(!try query.next(&context));
+}
+
+test "query container match" {
+    const data = "{\"a\": [1, {\"b\": 2}], \"c\": [3]}";
+
+    var depth: [3]zcon.Container = undefined;
+    var context = try Deserialize.initMemory(data, &depth);
+
+    var segments: [1]Query.Segment = undefined;
+    var query = try Query.init("/a", &segments);
+
+    try testing.expect(try query.next(&context));
+    try context.arrayOpen();
+    try testing.expectEqual(1, try context.int());
+
+    const err = query.next(&context);
+    try testing.expectError(error.Incomplete, err);
+
+    try context.skip();
+    try context.arrayClose();
+    try testing.expect(!try query.next(&context));
+}
+
+test "query whole element" {
+    var depth: [1]zcon.Container = undefined;
+    var context = try Deserialize.initMemory("[1]", &depth);
+
+    var segments: [0]Query.Segment = undefined;
+    var query = try Query.init("", &segments);
+    try testing.expect(try query.next(&context));
+    try context.skip();
+    try testing.expect(!try query.next(&context));
+}
+
+test "query no match in scalar" {
+    var depth: [0]zcon.Container = undefined;
+    var context = try Deserialize.initMemory("12", &depth);
+
+    var segments: [1]Query.Segment = undefined;
+    var query = try Query.init("/a", &segments);
+    try testing.expect(!try query.next(&context));
+}
+
+test "query buffered reader" {
+    const data = "[{\"k\\u0065y\": \"first\"}, {\"key\": \"second\"}, {\"other\": 0}]";
+    var reader = try gci.ReaderString.init(data);
+
+    var depth: [2]zcon.Container = undefined;
+    var buffer: [4]u8 = undefined;
+    var context = try Deserialize.initBuffer(reader.interface(), &depth, &buffer);
+
+    var segments: [2]Query.Segment = undefined;
+    var query = try Query.init("/*/key", &segments);
+
+    var first: [5]u8 = undefined;
+    var writer1 = try gci.WriterString.init(&first);
+    try testing.expect(try query.next(&context));
+    try context.string(writer1.interface());
+    try testing.expectEqualStrings("first", &first);
+
+    var second: [6]u8 = undefined;
+    var writer2 = try gci.WriterString.init(&second);
+    try testing.expect(try query.next(&context));
+    try context.string(writer2.interface());
+    try testing.expectEqualStrings("second", &second);
+
+    try testing.expect(!try query.next(&context));
+}
+
+test "query invalid pointer" {
+    var segments: [1]Query.Segment = undefined;
+
+    try testing.expectError(error.Query, Query.init("a", &segments));
+    try testing.expectError(error.Query, Query.init("/~2", &segments));
+    try testing.expectError(error.Query, Query.init("/a~", &segments));
+    try testing.expectError(error.Buffer, Query.init("/a/b", &segments));
+}
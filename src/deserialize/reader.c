@@ -1,8 +1,20 @@
+// Exposes `madvise` and `MADV_*` on glibc when compiling with `-std=c99`.
+#define _DEFAULT_SOURCE
 #include <stdio.h>
+#include <stdint.h>
+#include <string.h>
 #include <utils.h>
 #include "con_reader.h"
 
+#if defined(__unix__) || defined(__APPLE__)
+#define CON_READER_MAP_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 size_t con_reader_comment_read(void const *context, char *buffer, size_t buffer_size);
+size_t con_reader_map_read(void const *context, char *buffer, size_t buffer_size);
+static void con_reader_map_release(struct ConReaderMap *context, size_t position);
 
 enum ConError con_reader_comment_init(struct ConReaderComment *context, struct GciInterfaceReader reader) {
     if (context == NULL) { return CON_ERROR_NULL; }
@@ -17,12 +29,30 @@ struct GciInterfaceReader con_reader_comment_interface(struct ConReaderComment *
     return (struct GciInterfaceReader) { .context = context, .read = con_reader_comment_read };
 }
 
+// Reads a single character from the inner reader, straight from the mapping
+// if it is a `struct ConReaderMap` to avoid a call through the interface for
+// every character.
+static inline size_t con_reader_comment_next(struct ConReaderComment *context, char *c) {
+    if (context->reader.read == con_reader_map_read) {
+        struct ConReaderMap *map = (struct ConReaderMap*) context->reader.context;
+        if (map->position >= map->data_size) { return 0; }
+
+        *c = map->data[map->position++];
+        if (map->position - map->released >= CON_READER_MAP_RELEASE) {
+            con_reader_map_release(map, map->position);
+        }
+        return 1;
+    }
+
+    return gci_reader_read(context->reader, c, 1);
+}
+
 size_t con_reader_comment_comment_start(struct ConReaderComment *context, char *buffer, size_t buffer_size) {
     assert(context != NULL);
     size_t length = 0;
 
     char c;
-    size_t l = gci_reader_read(context->reader, &c, 1);
+    size_t l = con_reader_comment_next(context, &c);
     assert(l == 0 || l == 1);
 
     if (l != 1) {
@@ -73,7 +103,7 @@ size_t con_reader_comment_read(void const *void_context, char *buffer, size_t bu
     while (length < buffer_size) {
         char c;
 
-        size_t l = gci_reader_read(context->reader, &c, 1);
+        size_t l = con_reader_comment_next(context, &c);
         assert(l == 0 || l == 1);
         if (l != 1) { break; }
 
@@ -99,3 +129,114 @@ size_t con_reader_comment_read(void const *void_context, char *buffer, size_t bu
     assert(length <= buffer_size);
     return length;
 }
+
+enum ConError con_reader_map_init(struct ConReaderMap *context, int fd) {
+    if (context == NULL) { return CON_ERROR_NULL; }
+    context->data = NULL;
+    context->data_size = 0;
+    context->position = 0;
+    context->released = 0;
+
+#if defined(CON_READER_MAP_MMAP)
+    struct stat info;
+    if (fstat(fd, &info) != 0) { return CON_ERROR_READER; }
+    if (!S_ISREG(info.st_mode)) { return CON_ERROR_READER; }
+    if (info.st_size == 0) { return CON_ERROR_OK; }
+    if ((uintmax_t) info.st_size > SIZE_MAX) { return CON_ERROR_READER; }
+
+    size_t data_size = (size_t) info.st_size;
+    void *data = mmap(NULL, data_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) { return CON_ERROR_READER; }
+
+    // Only hints, the mapping is usable whether they are followed or not.
+    (void) madvise(data, data_size, MADV_SEQUENTIAL);
+#if defined(MADV_HUGEPAGE)
+    (void) madvise(data, data_size, MADV_HUGEPAGE);
+#endif
+
+    context->data = data;
+    context->data_size = data_size;
+    return CON_ERROR_OK;
+#else
+    (void) fd;
+    return CON_ERROR_READER;
+#endif
+}
+
+enum ConError con_reader_map_deinit(struct ConReaderMap *context) {
+    if (context == NULL) { return CON_ERROR_NULL; }
+
+#if defined(CON_READER_MAP_MMAP)
+    if (context->data != NULL) {
+        (void) munmap((void*) context->data, context->data_size);
+    }
+#endif
+
+    context->data = NULL;
+    context->data_size = 0;
+    context->position = 0;
+    context->released = 0;
+    return CON_ERROR_OK;
+}
+
+struct GciInterfaceReader con_reader_map_interface(struct ConReaderMap *context) {
+    return (struct GciInterfaceReader) { .context = context, .read = con_reader_map_read };
+}
+
+bool con_reader_map_take(struct GciInterfaceReader reader, char const **data, size_t *data_size) {
+    assert(data != NULL);
+    assert(data_size != NULL);
+    if (reader.read != con_reader_map_read) { return false; }
+
+    struct ConReaderMap *context = (struct ConReaderMap*) reader.context;
+    assert(context != NULL);
+    assert(context->position <= context->data_size);
+
+    *data = context->data + context->position;
+    *data_size = context->data_size - context->position;
+    context->position = context->data_size;
+    return true;
+}
+
+size_t con_reader_map_read(void const *void_context, char *buffer, size_t buffer_size) {
+    assert(void_context != NULL);
+    struct ConReaderMap *context = (struct ConReaderMap*) void_context;
+    assert(context->position <= context->data_size);
+
+    size_t length = context->data_size - context->position;
+    if (length > buffer_size) { length = buffer_size; }
+    if (length == 0) { return 0; }
+
+    assert(buffer != NULL);
+    memcpy(buffer, context->data + context->position, length);
+    context->position += length;
+
+    if (context->position - context->released >= CON_READER_MAP_RELEASE) {
+        con_reader_map_release(context, context->position);
+    }
+
+    return length;
+}
+
+size_t con_reader_map_release_before(struct ConReaderMap *context, char const *data) {
+    assert(context != NULL);
+    assert(data >= context->data && (size_t) (data - context->data) <= context->data_size);
+
+    size_t position = (size_t) (data - context->data);
+    con_reader_map_release(context, position);
+    return context->released + CON_READER_MAP_RELEASE - position;
+}
+
+// Drops the pages of the mapping before `position`, the file stays in the page
+// cache but no longer counts towards the resident size of this process.
+static void con_reader_map_release(struct ConReaderMap *context, size_t position) {
+    assert(context != NULL);
+    assert(position <= context->data_size);
+    size_t release = position - position % CON_READER_MAP_RELEASE;
+    if (release <= context->released) { return; }
+
+#if defined(CON_READER_MAP_MMAP)
+    (void) madvise((void*) (context->data + context->released), release - context->released, MADV_DONTNEED);
+#endif
+    context->released = release;
+}
@@ -1,3 +1,4 @@
+const std = @import("std");
 const gci = @import("gci");
 const internal = @import("../internal.zig");
 const lib = internal.lib;
@@ -24,7 +25,30 @@ pub const Comment = struct {
     }
 };
 
-const testing = @import("std").testing;
+pub const Map = struct {
+    inner: lib.ConReaderMap,
+
+    pub fn init(file: std.fs.File) !Map {
+        var self: Map = undefined;
+        const err = lib.con_reader_map_init(&self.inner, file.handle);
+        try internal.enumToError(err);
+        return self;
+    }
+
+    pub fn deinit(self: *Map) void {
+        _ = lib.con_reader_map_deinit(&self.inner);
+    }
+
+    pub fn interface(self: *Map) gci.InterfaceReader {
+        const temp: gci.InterfaceReader = undefined;
+        return .{ .reader = @as(
+            *@TypeOf(temp.reader),
+            @ptrCast(@constCast(&lib.con_reader_map_interface(&self.inner))),
+        ).* };
+    }
+};
+
+const testing = std.testing;
 
 test "comment init" {
     const d = "";
@@ -186,3 +210,97 @@ test "comment reader half comment clear error" {
     const result = try reader.read(&buffer);
     try testing.expectEqualStrings("/1", result);
 }
+
+test "map read" {
+    var dir = testing.tmpDir(.{});
+    defer dir.cleanup();
+    try dir.dir.writeFile(.{ .sub_path = "map.json", .data = "[1,2]" });
+
+    const file = try dir.dir.openFile("map.json", .{});
+    var context = try Map.init(file);
+    defer context.deinit();
+    file.close();
+
+    const reader = context.interface();
+
+    var buffer: [3]u8 = undefined;
+    const result1 = try reader.read(&buffer);
+    try testing.expectEqualStrings("[1,", result1);
+
+    const result2 = try reader.read(&buffer);
+    try testing.expectEqualStrings("2]", result2);
+
+    const err = reader.read(&buffer);
+    try testing.expectError(error.Reader, err);
+}
+
+test "map empty file" {
+    var dir = testing.tmpDir(.{});
+    defer dir.cleanup();
+    try dir.dir.writeFile(.{ .sub_path = "map.json", .data = "" });
+
+    const file = try dir.dir.openFile("map.json", .{});
+    defer file.close();
+
+    var context = try Map.init(file);
+    defer context.deinit();
+    const reader = context.interface();
+
+    var buffer: [1]u8 = undefined;
+    const err = reader.read(&buffer);
+    try testing.expectError(error.Reader, err);
+}
+
+test "map not a file" {
+    var dir = testing.tmpDir(.{});
+    defer dir.cleanup();
+
+    const err = Map.init(.{ .handle = dir.dir.fd });
+    try testing.expectError(error.Reader, err);
+}
+
+test "map comment" {
+    var dir = testing.tmpDir(.{});
+    defer dir.cleanup();
+    try dir.dir.writeFile(.{ .sub_path = "map.json", .data = "[  //:(\n \"k //:)\",1/]" });
+
+    const file = try dir.dir.openFile("map.json", .{});
+    defer file.close();
+
+    var map = try Map.init(file);
+    defer map.deinit();
+
+    var context = try Comment.init(map.interface());
+    const reader = context.interface();
+
+    var buffer: [17]u8 = undefined;
+    const result = try reader.read(&buffer);
+    try testing.expectEqualStrings("[  \n \"k //:)\",1/]", result);
+}
+
+test "map deserialize in place" {
+    const Deserialize = @import("deserialize.zig").Deserialize;
+    const zcon = @import("../con.zig");
+
+    var dir = testing.tmpDir(.{});
+    defer dir.cleanup();
+    try dir.dir.writeFile(.{ .sub_path = "map.json", .data = "[\"key\"]" });
+
+    const file = try dir.dir.openFile("map.json", .{});
+    defer file.close();
+
+    var map = try Map.init(file);
+    defer map.deinit();
+
+    var depth: [1]zcon.Container = undefined;
+    var context = try Deserialize.init(map.interface(), &depth);
+    try testing.expect(context.inner.from_memory);
+
+    var buffer: [0]u8 = undefined;
+    var writer = try gci.WriterString.init(&buffer);
+
+    try context.arrayOpen();
+    const view = try context.stringView(writer.interface());
+    try testing.expectEqualStrings("key", view.?);
+    try context.arrayClose();
+}
@@ -1,5 +1,7 @@
-const testing = @import("std").testing;
-const lib = @import("../../internal.zig").lib;
+const std = @import("std");
+const testing = std.testing;
+const internal = @import("../../internal.zig");
+const lib = internal.lib;
 
 test "context init" {
     var reader: lib.GciReaderString = undefined;
@@ -62,6 +64,100 @@ test "context depth negative" {
     try testing.expectEqual(@as(c_uint, lib.CON_ERROR_BUFFER), init_err);
 }
 
+test "context init buffer" {
+    var reader: lib.GciReaderString = undefined;
+    var depth: [0]lib.ConContainer = undefined;
+    var read_buffer: [4]u8 = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init_buffer(
+        &context,
+        lib.gci_reader_string_interface(&reader),
+        &depth,
+        0,
+        &read_buffer,
+        read_buffer.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+}
+
+test "context init buffer null" {
+    var reader: lib.GciReaderString = undefined;
+    var depth: [0]lib.ConContainer = undefined;
+    var read_buffer: [4]u8 = undefined;
+    const init_err = lib.con_deserialize_init_buffer(
+        null,
+        lib.gci_reader_string_interface(&reader),
+        &depth,
+        0,
+        &read_buffer,
+        read_buffer.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), init_err);
+}
+
+test "context read buffer null, length positive" {
+    var reader: lib.GciReaderString = undefined;
+    var depth: [0]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init_buffer(
+        &context,
+        lib.gci_reader_string_interface(&reader),
+        &depth,
+        0,
+        null,
+        1,
+    );
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), init_err);
+}
+
+test "context read buffer null, length zero" {
+    var reader: lib.GciReaderString = undefined;
+    var depth: [0]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init_buffer(
+        &context,
+        lib.gci_reader_string_interface(&reader),
+        &depth,
+        0,
+        null,
+        0,
+    );
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+}
+
+test "context depth allocator" {
+    var reader: lib.GciReaderString = undefined;
+    var depth: [1]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init(&context, lib.gci_reader_string_interface(&reader), &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+    try testing.expectEqual(1, context.depth_stack.size);
+
+    const allocator_err = lib.con_deserialize_depth_allocator(&context, internal.allocatorInterface(&testing.allocator));
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), allocator_err);
+    try testing.expectEqual(@bitSizeOf(lib.ConContainer), context.depth_stack.size);
+
+    const deinit_err = lib.con_deserialize_deinit(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), deinit_err);
+}
+
+test "context depth allocator null" {
+    var reader: lib.GciReaderString = undefined;
+    var depth: [1]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    _ = lib.con_deserialize_init(&context, lib.gci_reader_string_interface(&reader), &depth, depth.len);
+
+    const allocator = internal.allocatorInterface(&testing.allocator);
+    const err1 = lib.con_deserialize_depth_allocator(null, allocator);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err1);
+
+    const err2 = lib.con_deserialize_depth_allocator(&context, .{ .context = null, .resize = null });
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err2);
+
+    const err3 = lib.con_deserialize_deinit(null);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err3);
+}
+
 // Section: Next ---------------------------------------------------------------
 
 test "next empty" {
@@ -836,8 +932,63 @@ test "string escaped" {
 
     const err = lib.con_deserialize_string(&context, lib.gci_writer_string_interface(&writer));
     try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), err);
-    try testing.expectEqual(10, writer.current);
-    try testing.expectEqualStrings("\"\\/\x08\x0c\n\r\t\x12\xf4", buffer[0..10]);
+    try testing.expectEqual(11, writer.current);
+    try testing.expectEqualStrings("\"\\/\x08\x0c\n\r\t\xe1\x8b\xb4", buffer[0..11]);
+}
+
+test "string unicode" {
+    const data = "\"\\u00e9\\ud83d\\ude00\"";
+    var reader: lib.GciReaderString = undefined;
+    const ir_err = lib.gci_reader_string_init(&reader, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), ir_err);
+
+    var depth: [0]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init(&context, lib.gci_reader_string_interface(&reader), &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    var buffer: [8]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    const iw_err = lib.gci_writer_string_init(&writer, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), iw_err);
+
+    const err = lib.con_deserialize_string(&context, lib.gci_writer_string_interface(&writer));
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), err);
+    try testing.expectEqual(6, writer.current);
+    try testing.expectEqualStrings("\xc3\xa9\xf0\x9f\x98\x80", buffer[0..6]);
+}
+
+test "string surrogate invalid" {
+    var reader: lib.GciReaderString = undefined;
+    var buffer: [5]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+
+    var depth: [0]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+
+    const data1 = "\"1\\ude00\"";
+    const ir1_err = lib.gci_reader_string_init(&reader, data1, data1.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), ir1_err);
+    const iw1_err = lib.gci_writer_string_init(&writer, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), iw1_err);
+    const init1_err = lib.con_deserialize_init(&context, lib.gci_reader_string_interface(&reader), &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init1_err);
+    const err1 = lib.con_deserialize_string(&context, lib.gci_writer_string_interface(&writer));
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_SURROGATE), err1);
+    try testing.expectEqual(1, writer.current);
+    try testing.expectEqualStrings("1", buffer[0..1]);
+
+    const data2 = "\"2\\ud83d\\u0041\"";
+    const ir2_err = lib.gci_reader_string_init(&reader, data2, data2.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), ir2_err);
+    const iw2_err = lib.gci_writer_string_init(&writer, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), iw2_err);
+    const init2_err = lib.con_deserialize_init(&context, lib.gci_reader_string_interface(&reader), &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init2_err);
+    const err2 = lib.con_deserialize_string(&context, lib.gci_writer_string_interface(&writer));
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_SURROGATE), err2);
+    try testing.expectEqual(1, writer.current);
+    try testing.expectEqualStrings("2", buffer[0..1]);
 }
 
 test "string invalid" {
@@ -2976,6 +3127,647 @@ test "dict complete" {
     try testing.expectEqual(@as(c_uint, lib.CON_ERROR_COMPLETE), err);
 }
 
+// Section: Read buffer --------------------------------------------------------
+
+test "read buffer values" {
+    const data = "[\"ab\", 12 ,true,null]";
+    var reader: lib.GciReaderString = undefined;
+    const ir_err = lib.gci_reader_string_init(&reader, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), ir_err);
+
+    var depth: [1]lib.ConContainer = undefined;
+    var read_buffer: [5]u8 = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init_buffer(
+        &context,
+        lib.gci_reader_string_interface(&reader),
+        &depth,
+        depth.len,
+        &read_buffer,
+        read_buffer.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const open_err = lib.con_deserialize_array_open(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), open_err);
+
+    var buffer: [2]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+
+    const iw1_err = lib.gci_writer_string_init(&writer, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), iw1_err);
+    const str_err = lib.con_deserialize_string(&context, lib.gci_writer_string_interface(&writer));
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), str_err);
+    try testing.expectEqualStrings("ab", &buffer);
+
+    const iw2_err = lib.gci_writer_string_init(&writer, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), iw2_err);
+    const num_err = lib.con_deserialize_number(&context, lib.gci_writer_string_interface(&writer));
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), num_err);
+    try testing.expectEqualStrings("12", &buffer);
+
+    var value: bool = undefined;
+    const bool_err = lib.con_deserialize_bool(&context, &value);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), bool_err);
+    try testing.expectEqual(true, value);
+
+    const null_err = lib.con_deserialize_null(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), null_err);
+
+    const close_err = lib.con_deserialize_array_close(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), close_err);
+}
+
+test "read buffer string escaped" {
+    const data = "\"a\\\"bc\\\\de\\nfgh\"";
+    var reader: lib.GciReaderString = undefined;
+    const ir_err = lib.gci_reader_string_init(&reader, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), ir_err);
+
+    var depth: [0]lib.ConContainer = undefined;
+    var read_buffer: [4]u8 = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init_buffer(
+        &context,
+        lib.gci_reader_string_interface(&reader),
+        &depth,
+        depth.len,
+        &read_buffer,
+        read_buffer.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    var buffer: [11]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    const iw_err = lib.gci_writer_string_init(&writer, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), iw_err);
+
+    const str_err = lib.con_deserialize_string(&context, lib.gci_writer_string_interface(&writer));
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), str_err);
+    try testing.expectEqualStrings("a\"bc\\de\nfgh", &buffer);
+}
+
+test "read buffer string reader fail" {
+    const data = "\"abcdef";
+    var reader: lib.GciReaderString = undefined;
+    const ir_err = lib.gci_reader_string_init(&reader, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), ir_err);
+
+    var depth: [0]lib.ConContainer = undefined;
+    var read_buffer: [4]u8 = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init_buffer(
+        &context,
+        lib.gci_reader_string_interface(&reader),
+        &depth,
+        depth.len,
+        &read_buffer,
+        read_buffer.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    var buffer: [6]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    const iw_err = lib.gci_writer_string_init(&writer, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), iw_err);
+
+    const str_err = lib.con_deserialize_string(&context, lib.gci_writer_string_interface(&writer));
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_READER), str_err);
+    try testing.expectEqualStrings("abcdef", &buffer);
+}
+
+test "read buffer reader fail" {
+    const data = "[1,2]";
+    var r: lib.GciReaderString = undefined;
+    const i1_err = lib.gci_reader_string_init(&r, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), i1_err);
+
+    var reader: lib.GciReaderFail = undefined;
+    const i2_err = lib.gci_reader_fail_init(
+        &reader,
+        lib.gci_reader_string_interface(&r),
+        3,
+    );
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), i2_err);
+
+    var depth: [1]lib.ConContainer = undefined;
+    var read_buffer: [16]u8 = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init_buffer(
+        &context,
+        lib.gci_reader_fail_interface(&reader),
+        &depth,
+        depth.len,
+        &read_buffer,
+        read_buffer.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const open_err = lib.con_deserialize_array_open(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), open_err);
+
+    var buffer: [1]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    const iw_err = lib.gci_writer_string_init(&writer, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), iw_err);
+
+    const num_err = lib.con_deserialize_number(&context, lib.gci_writer_string_interface(&writer));
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), num_err);
+
+    var etype: lib.ConDeserializeType = undefined;
+    const next_err = lib.con_deserialize_next(&context, &etype);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_READER), next_err);
+}
+
+// Section: Number conversion --------------------------------------------------
+
+test "int64" {
+    const data = "[-12, 9223372036854775807]";
+    var reader: lib.GciReaderString = undefined;
+    const ir_err = lib.gci_reader_string_init(&reader, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), ir_err);
+
+    var depth: [1]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init(&context, lib.gci_reader_string_interface(&reader), &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const open_err = lib.con_deserialize_array_open(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), open_err);
+
+    var value: i64 = undefined;
+
+    const int1_err = lib.con_deserialize_int64(&context, &value);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), int1_err);
+    try testing.expectEqual(-12, value);
+
+    const int2_err = lib.con_deserialize_int64(&context, &value);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), int2_err);
+    try testing.expectEqual(std.math.maxInt(i64), value);
+
+    const close_err = lib.con_deserialize_array_close(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), close_err);
+}
+
+test "int64 null" {
+    const data = "1";
+    var reader: lib.GciReaderString = undefined;
+    const ir_err = lib.gci_reader_string_init(&reader, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), ir_err);
+
+    var depth: [0]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init(&context, lib.gci_reader_string_interface(&reader), &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const err = lib.con_deserialize_int64(&context, null);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err);
+}
+
+test "int64 overflow" {
+    const data = "[-9223372036854775809, 1]";
+    var reader: lib.GciReaderString = undefined;
+    const ir_err = lib.gci_reader_string_init(&reader, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), ir_err);
+
+    var depth: [1]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init(&context, lib.gci_reader_string_interface(&reader), &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const open_err = lib.con_deserialize_array_open(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), open_err);
+
+    var value: i64 = undefined;
+
+    const int1_err = lib.con_deserialize_int64(&context, &value);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OVERFLOW), int1_err);
+
+    const int2_err = lib.con_deserialize_int64(&context, &value);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), int2_err);
+    try testing.expectEqual(1, value);
+
+    const close_err = lib.con_deserialize_array_close(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), close_err);
+}
+
+test "uint64" {
+    const data = "[18446744073709551615, 18446744073709551616, -0, 2e1]";
+    var reader: lib.GciReaderString = undefined;
+    const ir_err = lib.gci_reader_string_init(&reader, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), ir_err);
+
+    var depth: [1]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init(&context, lib.gci_reader_string_interface(&reader), &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const open_err = lib.con_deserialize_array_open(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), open_err);
+
+    var value: u64 = undefined;
+
+    const uint1_err = lib.con_deserialize_uint64(&context, &value);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), uint1_err);
+    try testing.expectEqual(std.math.maxInt(u64), value);
+
+    const uint2_err = lib.con_deserialize_uint64(&context, &value);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OVERFLOW), uint2_err);
+
+    const uint3_err = lib.con_deserialize_uint64(&context, &value);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), uint3_err);
+    try testing.expectEqual(0, value);
+
+    const uint4_err = lib.con_deserialize_uint64(&context, &value);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_TYPE), uint4_err);
+
+    const close_err = lib.con_deserialize_array_close(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), close_err);
+}
+
+test "double" {
+    const data = "[1.7976931348623157e308, 5e-324, -0.0, 1e23]";
+    var reader: lib.GciReaderString = undefined;
+    const ir_err = lib.gci_reader_string_init(&reader, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), ir_err);
+
+    var depth: [1]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init(&context, lib.gci_reader_string_interface(&reader), &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const open_err = lib.con_deserialize_array_open(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), open_err);
+
+    var value: f64 = undefined;
+
+    const double1_err = lib.con_deserialize_double(&context, &value);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), double1_err);
+    try testing.expectEqual(std.math.floatMax(f64), value);
+
+    const double2_err = lib.con_deserialize_double(&context, &value);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), double2_err);
+    try testing.expectEqual(std.math.floatTrueMin(f64), value);
+
+    const double3_err = lib.con_deserialize_double(&context, &value);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), double3_err);
+    try testing.expect(std.math.signbit(value));
+    try testing.expectEqual(0.0, value);
+
+    const double4_err = lib.con_deserialize_double(&context, &value);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), double4_err);
+    try testing.expectEqual(1e23, value);
+
+    const close_err = lib.con_deserialize_array_close(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), close_err);
+}
+
+test "double comma missing" {
+    const data = "[1 2]";
+    var reader: lib.GciReaderString = undefined;
+    const ir_err = lib.gci_reader_string_init(&reader, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), ir_err);
+
+    var depth: [1]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init(&context, lib.gci_reader_string_interface(&reader), &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const open_err = lib.con_deserialize_array_open(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), open_err);
+
+    var value: f64 = undefined;
+
+    const double1_err = lib.con_deserialize_double(&context, &value);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), double1_err);
+    try testing.expectEqual(1.0, value);
+
+    const double2_err = lib.con_deserialize_double(&context, &value);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_COMMA_MISSING), double2_err);
+}
+
+test "double overflow" {
+    const data = "-1.8e308";
+    var reader: lib.GciReaderString = undefined;
+    const ir_err = lib.gci_reader_string_init(&reader, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), ir_err);
+
+    var depth: [0]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init(&context, lib.gci_reader_string_interface(&reader), &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    var value: f64 = undefined;
+    const err = lib.con_deserialize_double(&context, &value);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OVERFLOW), err);
+}
+
+// Section: Views --------------------------------------------------------------
+
+test "context init memory" {
+    const data = "1";
+    var depth: [0]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init_memory(&context, data, data.len, &depth, 0);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+}
+
+test "context init memory null" {
+    var depth: [0]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init_memory(&context, null, 1, &depth, 0);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), init_err);
+}
+
+test "view string" {
+    const data = "[\"abc\",\"d\\\"e\"]";
+    var depth: [1]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init_memory(&context, data, data.len, &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const open_err = lib.con_deserialize_array_open(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), open_err);
+
+    var buffer: [3]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    const iw_err = lib.gci_writer_string_init(&writer, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), iw_err);
+
+    var view: [*c]const u8 = undefined;
+    var view_size: usize = undefined;
+
+    const str1_err = lib.con_deserialize_string_view(&context, &view, &view_size, lib.gci_writer_string_interface(&writer));
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), str1_err);
+    try testing.expectEqual(data.ptr + 2, view);
+    try testing.expectEqualStrings("abc", view[0..view_size]);
+    try testing.expectEqual(0, writer.current);
+
+    const str2_err = lib.con_deserialize_string_view(&context, &view, &view_size, lib.gci_writer_string_interface(&writer));
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), str2_err);
+    try testing.expectEqual(null, view);
+    try testing.expectEqualStrings("d\"e", &buffer);
+
+    const close_err = lib.con_deserialize_array_close(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), close_err);
+}
+
+test "view string null" {
+    const data = "\"abc\"";
+    var depth: [0]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init_memory(&context, data, data.len, &depth, 0);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    var writer: lib.GciWriterString = undefined;
+    var view_size: usize = undefined;
+    const str_err = lib.con_deserialize_string_view(&context, null, &view_size, lib.gci_writer_string_interface(&writer));
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), str_err);
+}
+
+test "view string type" {
+    const data = "1";
+    var depth: [0]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init_memory(&context, data, data.len, &depth, 0);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    var writer: lib.GciWriterString = undefined;
+    var view: [*c]const u8 = undefined;
+    var view_size: usize = undefined;
+    const str_err = lib.con_deserialize_string_view(&context, &view, &view_size, lib.gci_writer_string_interface(&writer));
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_TYPE), str_err);
+}
+
+test "view dict key and number" {
+    const data = "{\"k\" : 0.5 , \"m\":1}";
+    var depth: [1]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init_memory(&context, data, data.len, &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const open_err = lib.con_deserialize_dict_open(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), open_err);
+
+    var buffer: [0]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    const iw_err = lib.gci_writer_string_init(&writer, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), iw_err);
+    const interface = lib.gci_writer_string_interface(&writer);
+
+    var view: [*c]const u8 = undefined;
+    var view_size: usize = undefined;
+
+    const key1_err = lib.con_deserialize_dict_key_view(&context, &view, &view_size, interface);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), key1_err);
+    try testing.expectEqualStrings("k", view[0..view_size]);
+
+    const num1_err = lib.con_deserialize_number_view(&context, &view, &view_size, interface);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), num1_err);
+    try testing.expectEqualStrings("0.5", view[0..view_size]);
+
+    const key2_err = lib.con_deserialize_dict_key_view(&context, &view, &view_size, interface);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), key2_err);
+    try testing.expectEqualStrings("m", view[0..view_size]);
+
+    const num2_err = lib.con_deserialize_number_view(&context, &view, &view_size, interface);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), num2_err);
+    try testing.expectEqualStrings("1", view[0..view_size]);
+
+    const close_err = lib.con_deserialize_dict_close(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), close_err);
+}
+
+test "view number not terminated" {
+    const data = "[1.]";
+    var depth: [1]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init_memory(&context, data, data.len, &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const open_err = lib.con_deserialize_array_open(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), open_err);
+
+    var writer: lib.GciWriterString = undefined;
+    var view: [*c]const u8 = undefined;
+    var view_size: usize = undefined;
+    const num_err = lib.con_deserialize_number_view(&context, &view, &view_size, lib.gci_writer_string_interface(&writer));
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NOT_NUMBER), num_err);
+}
+
+// Section: Skip ---------------------------------------------------------------
+
+test "skip values" {
+    const data = "[{\"a\": [\"]\", {}]}, \"\\\"\", 1e2, false, null, 7]";
+    var reader: lib.GciReaderString = undefined;
+    const ir_err = lib.gci_reader_string_init(&reader, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), ir_err);
+
+    var depth: [1]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init(&context, lib.gci_reader_string_interface(&reader), &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const open_err = lib.con_deserialize_array_open(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), open_err);
+
+    for (0..5) |_| {
+        const skip_err = lib.con_deserialize_skip(&context);
+        try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), skip_err);
+    }
+
+    var buffer: [1]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    const iw_err = lib.gci_writer_string_init(&writer, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), iw_err);
+
+    const num_err = lib.con_deserialize_number(&context, lib.gci_writer_string_interface(&writer));
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), num_err);
+    try testing.expectEqualStrings("7", &buffer);
+
+    const skip_err = lib.con_deserialize_skip(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_TYPE), skip_err);
+
+    const close_err = lib.con_deserialize_array_close(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), close_err);
+}
+
+test "skip key" {
+    const data = "{\"a\": 1}";
+    var depth: [1]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init_memory(&context, data, data.len, &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const open_err = lib.con_deserialize_dict_open(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), open_err);
+
+    const skip_err = lib.con_deserialize_skip(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_KEY), skip_err);
+}
+
+test "skip not closed" {
+    const data = "{\"a\": [\"}\"}";
+    var depth: [0]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init_memory(&context, data, data.len, &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const skip_err = lib.con_deserialize_skip(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_READER), skip_err);
+}
+
+// Section: Key match ----------------------------------------------------------
+
+test "keys init null" {
+    var order: [1]usize = undefined;
+    var keys: lib.ConDeserializeKeys = undefined;
+
+    const names = [_][*c]const u8{null};
+    const init_err = lib.con_deserialize_keys_init(&keys, &names, &order, names.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), init_err);
+
+    const empty_err = lib.con_deserialize_keys_init(&keys, null, null, 0);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), empty_err);
+}
+
+test "dict key match" {
+    const data = "{\"x\": [\"a\"], \"b\": true, \"a\": null}";
+    var reader: lib.GciReaderString = undefined;
+    const ir_err = lib.gci_reader_string_init(&reader, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), ir_err);
+
+    var depth: [1]lib.ConContainer = undefined;
+    var read_buffer: [4]u8 = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init_buffer(&context, lib.gci_reader_string_interface(&reader), &depth, depth.len, &read_buffer, read_buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const names = [_][*c]const u8{ "a", "b" };
+    var order: [names.len]usize = undefined;
+    var keys: lib.ConDeserializeKeys = undefined;
+    const keys_err = lib.con_deserialize_keys_init(&keys, &names, &order, names.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), keys_err);
+
+    const open_err = lib.con_deserialize_dict_open(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), open_err);
+
+    var index: usize = undefined;
+    const match1_err = lib.con_deserialize_dict_key_match(&context, &keys, &index);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), match1_err);
+    try testing.expectEqual(std.math.maxInt(usize), index);
+
+    const match2_err = lib.con_deserialize_dict_key_match(&context, &keys, &index);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), match2_err);
+    try testing.expectEqual(1, index);
+
+    var value: bool = undefined;
+    const bool_err = lib.con_deserialize_bool(&context, &value);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), bool_err);
+
+    const match3_err = lib.con_deserialize_dict_key_match(&context, &keys, &index);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), match3_err);
+    try testing.expectEqual(0, index);
+
+    const null_err = lib.con_deserialize_null(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), null_err);
+
+    const close_err = lib.con_deserialize_dict_close(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), close_err);
+}
+
+// Section: Record -------------------------------------------------------------
+
+test "record" {
+    const data = "[1]\n{}\n";
+    var reader: lib.GciReaderString = undefined;
+    const ir_err = lib.gci_reader_string_init(&reader, data, data.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), ir_err);
+
+    var depth: [1]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init(&context, lib.gci_reader_string_interface(&reader), &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    var found: bool = undefined;
+    const record1_err = lib.con_deserialize_record(&context, &found);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), record1_err);
+    try testing.expect(found);
+
+    const skip1_err = lib.con_deserialize_skip(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), skip1_err);
+
+    const complete_err = lib.con_deserialize_skip(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_COMPLETE), complete_err);
+
+    const record2_err = lib.con_deserialize_record(&context, &found);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), record2_err);
+    try testing.expect(found);
+
+    const open_err = lib.con_deserialize_dict_open(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), open_err);
+
+    const incomplete_err = lib.con_deserialize_record(&context, &found);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_INCOMPLETE), incomplete_err);
+
+    const close_err = lib.con_deserialize_dict_close(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), close_err);
+
+    const record3_err = lib.con_deserialize_record(&context, &found);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), record3_err);
+    try testing.expect(!found);
+}
+
+test "record null" {
+    var depth: [1]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init_memory(&context, "1", 1, &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const record_err = lib.con_deserialize_record(&context, null);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), record_err);
+}
+
 // Section: Integration test ---------------------------------------------------
 
 test "nested structures" {
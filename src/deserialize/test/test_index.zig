@@ -0,0 +1,182 @@
+const testing = @import("std").testing;
+const lib = @import("../../internal.zig").lib;
+
+test "index init" {
+    const data = "[1, {\"a\": null}]";
+    var tape: [8]lib.ConIndexEntry = undefined;
+    var depth: [2]usize = undefined;
+
+    var index: lib.ConIndex = undefined;
+    const init_err = lib.con_index_init(&index, data, data.len, &tape, tape.len, &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+    try testing.expectEqual(7, index.tape_length);
+
+    try testing.expectEqual(@as(c_uint, lib.CON_DESERIALIZE_TYPE_ARRAY_OPEN), tape[0].type);
+    try testing.expectEqual(0, tape[0].offset);
+    try testing.expectEqual(2, tape[0].size);
+    try testing.expectEqual(7, tape[0].next);
+
+    try testing.expectEqual(@as(c_uint, lib.CON_DESERIALIZE_TYPE_DICT_KEY), tape[3].type);
+    try testing.expectEqual(5, tape[3].offset);
+    try testing.expectEqual(3, tape[3].size);
+
+    try testing.expectEqual(@as(c_uint, lib.CON_DESERIALIZE_TYPE_NULL), tape[4].type);
+    try testing.expectEqual(10, tape[4].offset);
+    try testing.expectEqual(4, tape[4].size);
+}
+
+test "index init null" {
+    var tape: [1]lib.ConIndexEntry = undefined;
+    var depth: [1]usize = undefined;
+    var index: lib.ConIndex = undefined;
+
+    const err1 = lib.con_index_init(null, "1", 1, &tape, tape.len, &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err1);
+
+    const err2 = lib.con_index_init(&index, null, 1, &tape, tape.len, &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err2);
+
+    const err3 = lib.con_index_init(&index, "1", 1, null, 1, &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err3);
+
+    const err4 = lib.con_index_init(&index, "1", 1, &tape, tape.len, null, 1);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err4);
+}
+
+test "index init empty" {
+    var index: lib.ConIndex = undefined;
+    const err = lib.con_index_init(&index, null, 0, null, 0, null, 0);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_READER), err);
+}
+
+test "index init errors" {
+    const Case = struct { data: []const u8, err: c_uint };
+    const cases = [_]Case{
+        .{ .data = "[1", .err = lib.CON_ERROR_READER },
+        .{ .data = "\"abc", .err = lib.CON_ERROR_READER },
+        .{ .data = "]", .err = lib.CON_ERROR_CLOSED_TOO_MANY },
+        .{ .data = "[[[]]]", .err = lib.CON_ERROR_TOO_DEEP },
+        .{ .data = "1 2", .err = lib.CON_ERROR_COMPLETE },
+        .{ .data = "{\"a\": 1 \"b\": 2}", .err = lib.CON_ERROR_COMMA_MISSING },
+        .{ .data = "[1,,2]", .err = lib.CON_ERROR_COMMA_MULTIPLE },
+        .{ .data = "[1,]", .err = lib.CON_ERROR_COMMA_TRAILING },
+        .{ .data = "[,1]", .err = lib.CON_ERROR_COMMA_UNEXPECTED },
+        .{ .data = "[}", .err = lib.CON_ERROR_NOT_DICT },
+        .{ .data = "[01]", .err = lib.CON_ERROR_INVALID_JSON },
+        .{ .data = "[nul]", .err = lib.CON_ERROR_INVALID_JSON },
+        .{ .data = "[\"\\u12g4\"]", .err = lib.CON_ERROR_INVALID_JSON },
+    };
+
+    var tape: [8]lib.ConIndexEntry = undefined;
+    var depth: [2]usize = undefined;
+    var index: lib.ConIndex = undefined;
+    for (cases) |case| {
+        const err = lib.con_index_init(&index, case.data.ptr, case.data.len, &tape, tape.len, &depth, depth.len);
+        try testing.expectEqual(case.err, err);
+    }
+}
+
+test "index array get" {
+    const data = "[[1, [2]], {}, 3]";
+    var tape: [16]lib.ConIndexEntry = undefined;
+    var depth: [3]usize = undefined;
+
+    var index: lib.ConIndex = undefined;
+    const init_err = lib.con_index_init(&index, data, data.len, &tape, tape.len, &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    var entry: usize = undefined;
+    const get1_err = lib.con_index_array_get(&index, 0, 2, &entry);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), get1_err);
+    try testing.expectEqual(9, entry);
+    try testing.expectEqual(@as(c_uint, lib.CON_DESERIALIZE_TYPE_NUMBER), tape[entry].type);
+
+    const get2_err = lib.con_index_array_get(&index, 0, 3, &entry);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), get2_err);
+    try testing.expectEqual(lib.CON_INDEX_NONE, entry);
+
+    const get3_err = lib.con_index_array_get(&index, 7, 0, &entry);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NOT_ARRAY), get3_err);
+
+    const get4_err = lib.con_index_array_get(&index, 11, 0, &entry);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_BUFFER), get4_err);
+
+    const get5_err = lib.con_index_array_get(&index, 0, 0, null);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), get5_err);
+}
+
+test "index dict get" {
+    const data = "{\"a\": 1, \"b\\n\": 2, \"a\": 3}";
+    var tape: [8]lib.ConIndexEntry = undefined;
+    var depth: [1]usize = undefined;
+
+    var index: lib.ConIndex = undefined;
+    const init_err = lib.con_index_init(&index, data, data.len, &tape, tape.len, &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    var entry: usize = undefined;
+    const get1_err = lib.con_index_dict_get(&index, 0, "a", 1, &entry);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), get1_err);
+    try testing.expectEqual(2, entry);
+
+    const get2_err = lib.con_index_dict_get(&index, 0, "b\n", 2, &entry);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), get2_err);
+    try testing.expectEqual(4, entry);
+
+    const get3_err = lib.con_index_dict_get(&index, 0, "b", 1, &entry);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), get3_err);
+    try testing.expectEqual(lib.CON_INDEX_NONE, entry);
+
+    const get4_err = lib.con_index_dict_get(&index, 2, "a", 1, &entry);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NOT_DICT), get4_err);
+
+    const get5_err = lib.con_index_dict_get(&index, 0, null, 0, &entry);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), get5_err);
+}
+
+test "index dict get surrogate" {
+    const data = "{\"\\ud800\": 1}";
+    var tape: [4]lib.ConIndexEntry = undefined;
+    var depth: [1]usize = undefined;
+
+    var index: lib.ConIndex = undefined;
+    const init_err = lib.con_index_init(&index, data, data.len, &tape, tape.len, &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    var entry: usize = undefined;
+    const get_err = lib.con_index_dict_get(&index, 0, "a", 1, &entry);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_SURROGATE), get_err);
+}
+
+test "index deserialize" {
+    const data = "[\"x\", [true]]";
+    var tape: [8]lib.ConIndexEntry = undefined;
+    var depth: [2]usize = undefined;
+
+    var index: lib.ConIndex = undefined;
+    const init_err = lib.con_index_init(&index, data, data.len, &tape, tape.len, &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    var container: [1]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const deserialize_err = lib.con_index_deserialize(&index, 2, &context, &container, container.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), deserialize_err);
+    try testing.expectEqual(6, context.read_buffer_length);
+
+    const open_err = lib.con_deserialize_array_open(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), open_err);
+
+    var value: bool = undefined;
+    const bool_err = lib.con_deserialize_bool(&context, &value);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), bool_err);
+    try testing.expect(value);
+
+    const close_err = lib.con_deserialize_array_close(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), close_err);
+
+    const type_err = lib.con_index_deserialize(&index, 4, &context, &container, container.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_TYPE), type_err);
+
+    const buffer_err = lib.con_index_deserialize(&index, 6, &context, &container, container.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_BUFFER), buffer_err);
+}
@@ -0,0 +1,175 @@
+const testing = @import("std").testing;
+const lib = @import("../../internal.zig").lib;
+
+test "push init" {
+    var depth: [1]lib.ConContainer = undefined;
+    var out: [1]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    _ = lib.gci_writer_string_init(&writer, &out, out.len);
+
+    var context: lib.ConPush = undefined;
+    const err = lib.con_push_init(&context, lib.gci_writer_string_interface(&writer), &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), err);
+    try testing.expectEqual(0, context.depth);
+    try testing.expectEqual(0, context.data_size);
+}
+
+test "push init null" {
+    var out: [1]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    _ = lib.gci_writer_string_init(&writer, &out, out.len);
+    const interface = lib.gci_writer_string_interface(&writer);
+
+    var depth: [1]lib.ConContainer = undefined;
+    var context: lib.ConPush = undefined;
+
+    const err1 = lib.con_push_init(null, interface, &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err1);
+
+    const err2 = lib.con_push_init(&context, interface, null, 1);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err2);
+
+    const err3 = lib.con_push_init(&context, interface, &depth, -1);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_BUFFER), err3);
+}
+
+test "push feed" {
+    var out: [1]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    _ = lib.gci_writer_string_init(&writer, &out, out.len);
+
+    var depth: [1]lib.ConContainer = undefined;
+    var context: lib.ConPush = undefined;
+    _ = lib.con_push_init(&context, lib.gci_writer_string_interface(&writer), &depth, depth.len);
+
+    const err1 = lib.con_push_feed(null, "[", 1);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err1);
+
+    const err2 = lib.con_push_feed(&context, null, 1);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err2);
+
+    const err3 = lib.con_push_feed(&context, "[]", 2);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), err3);
+
+    const err4 = lib.con_push_feed(&context, "[]", 2);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_BUFFER), err4);
+
+    var token_type: lib.ConDeserializeType = undefined;
+    const next1_err = lib.con_push_next(&context, &token_type);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), next1_err);
+    try testing.expectEqual(@as(c_uint, lib.CON_DESERIALIZE_TYPE_ARRAY_OPEN), token_type);
+
+    const next2_err = lib.con_push_next(&context, &token_type);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), next2_err);
+    try testing.expectEqual(@as(c_uint, lib.CON_DESERIALIZE_TYPE_ARRAY_CLOSE), token_type);
+
+    const finish_err = lib.con_push_finish(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), finish_err);
+
+    const err5 = lib.con_push_feed(&context, "[]", 2);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_READER), err5);
+
+    const err6 = lib.con_push_finish(null);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err6);
+}
+
+test "push next null" {
+    var out: [1]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    _ = lib.gci_writer_string_init(&writer, &out, out.len);
+
+    var depth: [1]lib.ConContainer = undefined;
+    var context: lib.ConPush = undefined;
+    _ = lib.con_push_init(&context, lib.gci_writer_string_interface(&writer), &depth, depth.len);
+
+    var token_type: lib.ConDeserializeType = undefined;
+
+    const err1 = lib.con_push_next(null, &token_type);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err1);
+
+    const err2 = lib.con_push_next(&context, null);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err2);
+
+    const err3 = lib.con_push_record(null);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err3);
+}
+
+test "push escape across chunks" {
+    const chunks = [_][]const u8{ "\"a\\", "u0", "0e", "9\\ud8", "3d\\", "ude00\\", "n\"" };
+    const expected = "a\xc3\xa9\xf0\x9f\x98\x80\n";
+
+    var out: [expected.len]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    _ = lib.gci_writer_string_init(&writer, &out, out.len);
+
+    var context: lib.ConPush = undefined;
+    _ = lib.con_push_init(&context, lib.gci_writer_string_interface(&writer), null, 0);
+
+    var token_type: lib.ConDeserializeType = undefined;
+    for (chunks, 0..) |chunk, i| {
+        const feed_err = lib.con_push_feed(&context, chunk.ptr, chunk.len);
+        try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), feed_err);
+
+        const err = lib.con_push_next(&context, &token_type);
+        if (i == chunks.len - 1) {
+            try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), err);
+        } else {
+            try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NEED_INPUT), err);
+        }
+    }
+
+    try testing.expectEqual(@as(c_uint, lib.CON_DESERIALIZE_TYPE_STRING), token_type);
+    try testing.expectEqualStrings(expected, &out);
+}
+
+test "push errors" {
+    const Case = struct { data: []const u8, err: c_uint };
+    const cases = [_]Case{
+        .{ .data = "[1,]", .err = lib.CON_ERROR_COMMA_TRAILING },
+        .{ .data = "[1 2]", .err = lib.CON_ERROR_COMMA_MISSING },
+        .{ .data = "[tru]", .err = lib.CON_ERROR_INVALID_JSON },
+        .{ .data = "[truex]", .err = lib.CON_ERROR_INVALID_JSON },
+        .{ .data = "[1.]", .err = lib.CON_ERROR_INVALID_JSON },
+        .{ .data = "{\"a\" 1}", .err = lib.CON_ERROR_INVALID_JSON },
+        .{ .data = "{1: 2}", .err = lib.CON_ERROR_KEY },
+        .{ .data = "[\"\\x\"]", .err = lib.CON_ERROR_INVALID_JSON },
+        .{ .data = "[\"\\udc00\"]", .err = lib.CON_ERROR_SURROGATE },
+        .{ .data = "[\"\\ud800a\"]", .err = lib.CON_ERROR_SURROGATE },
+        .{ .data = "[[]]", .err = lib.CON_ERROR_TOO_DEEP },
+        .{ .data = "[}", .err = lib.CON_ERROR_NOT_DICT },
+        .{ .data = "[1", .err = lib.CON_ERROR_READER },
+        .{ .data = "[1] 2", .err = lib.CON_ERROR_COMPLETE },
+        .{ .data = "01", .err = lib.CON_ERROR_INVALID_JSON },
+        .{ .data = "falsenul", .err = lib.CON_ERROR_INVALID_JSON },
+        .{ .data = "[1x]", .err = lib.CON_ERROR_INVALID_JSON },
+    };
+
+    for (cases) |case| {
+        var out: [8]u8 = undefined;
+        var writer: lib.GciWriterString = undefined;
+        _ = lib.gci_writer_string_init(&writer, &out, out.len);
+
+        var depth: [1]lib.ConContainer = undefined;
+        var context: lib.ConPush = undefined;
+        _ = lib.con_push_init(&context, lib.gci_writer_string_interface(&writer), &depth, depth.len);
+
+        // One byte at a time, the error must not depend on where chunks end.
+        var position: usize = 0;
+        var token_type: lib.ConDeserializeType = undefined;
+        const err = while (true) {
+            const next_err = lib.con_push_next(&context, &token_type);
+            if (next_err == lib.CON_ERROR_NEED_INPUT) {
+                if (position < case.data.len) {
+                    _ = lib.con_push_feed(&context, case.data.ptr + position, 1);
+                    position += 1;
+                } else {
+                    _ = lib.con_push_finish(&context);
+                }
+            } else if (next_err != lib.CON_ERROR_OK) {
+                break next_err;
+            }
+        };
+
+        try testing.expectEqual(case.err, err);
+    }
+}
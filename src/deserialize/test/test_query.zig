@@ -0,0 +1,159 @@
+const testing = @import("std").testing;
+const lib = @import("../../internal.zig").lib;
+
+test "query init" {
+    const pointer = "/items/0/a~1b/-";
+    var segments: [4]lib.ConQuerySegment = undefined;
+
+    var query: lib.ConQuery = undefined;
+    const err = lib.con_query_init(&query, pointer, pointer.len, &segments, segments.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), err);
+    try testing.expectEqual(4, query.segments_length);
+
+    try testing.expectEqual(5, segments[0].token_size);
+    try testing.expectEqual(lib.CON_QUERY_NONE, segments[0].index);
+    try testing.expectEqual(0, segments[1].index);
+    try testing.expectEqual(5, segments[2].token_size);
+    try testing.expectEqual(lib.CON_QUERY_NONE, segments[3].index);
+}
+
+test "query init empty" {
+    var query: lib.ConQuery = undefined;
+    const err = lib.con_query_init(&query, null, 0, null, 0);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), err);
+    try testing.expectEqual(0, query.segments_length);
+}
+
+test "query init null" {
+    var segments: [1]lib.ConQuerySegment = undefined;
+    var query: lib.ConQuery = undefined;
+
+    const err1 = lib.con_query_init(null, "/a", 2, &segments, segments.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err1);
+
+    const err2 = lib.con_query_init(&query, null, 2, &segments, segments.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err2);
+
+    const err3 = lib.con_query_init(&query, "/a", 2, null, 1);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err3);
+}
+
+test "query init errors" {
+    const Case = struct { pointer: []const u8, err: c_uint };
+    const cases = [_]Case{
+        .{ .pointer = "a", .err = lib.CON_ERROR_QUERY },
+        .{ .pointer = "/a~", .err = lib.CON_ERROR_QUERY },
+        .{ .pointer = "/a~2", .err = lib.CON_ERROR_QUERY },
+        .{ .pointer = "/a/b/c", .err = lib.CON_ERROR_BUFFER },
+    };
+
+    for (cases) |case| {
+        var segments: [2]lib.ConQuerySegment = undefined;
+        var query: lib.ConQuery = undefined;
+        const err = lib.con_query_init(&query, case.pointer.ptr, case.pointer.len, &segments, segments.len);
+        try testing.expectEqual(case.err, err);
+    }
+}
+
+test "query next" {
+    const data = "[{\"id\": 7, \"x\": [1]}, [2], {\"id\": 8}]";
+    var depth: [3]lib.ConContainer = undefined;
+
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init_memory(&context, data, data.len, &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const pointer = "/*/id";
+    var segments: [2]lib.ConQuerySegment = undefined;
+    var query: lib.ConQuery = undefined;
+    const query_err = lib.con_query_init(&query, pointer, pointer.len, &segments, segments.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), query_err);
+
+    var found: bool = undefined;
+    var value: i64 = undefined;
+
+    const next1_err = lib.con_query_next(&query, &context, &found);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), next1_err);
+    try testing.expect(found);
+
+    const int1_err = lib.con_deserialize_int64(&context, &value);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), int1_err);
+    try testing.expectEqual(7, value);
+
+    const next2_err = lib.con_query_next(&query, &context, &found);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), next2_err);
+    try testing.expect(found);
+
+    const int2_err = lib.con_deserialize_int64(&context, &value);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), int2_err);
+    try testing.expectEqual(8, value);
+
+    const next3_err = lib.con_query_next(&query, &context, &found);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), next3_err);
+    try testing.expect(!found);
+    try testing.expectEqual(0, context.depth);
+
+    const next4_err = lib.con_query_next(&query, &context, &found);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), next4_err);
+    try testing.expect(!found);
+}
+
+test "query next null" {
+    var depth: [1]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    _ = lib.con_deserialize_init_memory(&context, "[]", 2, &depth, depth.len);
+
+    var query: lib.ConQuery = undefined;
+    _ = lib.con_query_init(&query, null, 0, null, 0);
+
+    var found: bool = undefined;
+
+    const err1 = lib.con_query_next(null, &context, &found);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err1);
+
+    const err2 = lib.con_query_next(&query, null, &found);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err2);
+
+    const err3 = lib.con_query_next(&query, &context, null);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err3);
+}
+
+test "query next incomplete" {
+    const data = "{\"a\": 1, \"b\": 2}";
+    var depth: [1]lib.ConContainer = undefined;
+
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init_memory(&context, data, data.len, &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const pointer = "/*";
+    var segments: [1]lib.ConQuerySegment = undefined;
+    var query: lib.ConQuery = undefined;
+    _ = lib.con_query_init(&query, pointer, pointer.len, &segments, segments.len);
+
+    var found: bool = undefined;
+    const next1_err = lib.con_query_next(&query, &context, &found);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), next1_err);
+    try testing.expect(found);
+
+    const next2_err = lib.con_query_next(&query, &context, &found);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_INCOMPLETE), next2_err);
+}
+
+test "query next invalid json" {
+    const data = "[{\"a\": tru}]";
+    var depth: [2]lib.ConContainer = undefined;
+
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init_memory(&context, data, data.len, &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const pointer = "/0/b";
+    var segments: [2]lib.ConQuerySegment = undefined;
+    var query: lib.ConQuery = undefined;
+    _ = lib.con_query_init(&query, pointer, pointer.len, &segments, segments.len);
+
+    var found: bool = undefined;
+    const err = lib.con_query_next(&query, &context, &found);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_INVALID_JSON), err);
+}
@@ -291,3 +291,160 @@ test "comment reader half comment clear error" {
     try testing.expectEqual(2, length2);
     try testing.expectEqualStrings("/1", buffer[0..2]);
 }
+
+test "map init" {
+    var dir = testing.tmpDir(.{});
+    defer dir.cleanup();
+    try dir.dir.writeFile(.{ .sub_path = "map.json", .data = "[]" });
+
+    const file = try dir.dir.openFile("map.json", .{});
+    defer file.close();
+
+    var context: lib.ConReaderMap = undefined;
+    const init_err = lib.con_reader_map_init(&context, file.handle);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+    try testing.expectEqual(2, context.data_size);
+
+    _ = lib.con_reader_map_interface(&context);
+
+    const deinit_err = lib.con_reader_map_deinit(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), deinit_err);
+}
+
+test "map init null" {
+    const init_err = lib.con_reader_map_init(null, 0);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), init_err);
+
+    const deinit_err = lib.con_reader_map_deinit(null);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), deinit_err);
+}
+
+test "map init invalid file" {
+    var context: lib.ConReaderMap = undefined;
+    const init_err = lib.con_reader_map_init(&context, -1);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_READER), init_err);
+}
+
+test "map read" {
+    var dir = testing.tmpDir(.{});
+    defer dir.cleanup();
+    try dir.dir.writeFile(.{ .sub_path = "map.json", .data = "12" });
+
+    const file = try dir.dir.openFile("map.json", .{});
+    defer file.close();
+
+    var context: lib.ConReaderMap = undefined;
+    const init_err = lib.con_reader_map_init(&context, file.handle);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+    defer _ = lib.con_reader_map_deinit(&context);
+    const reader = lib.con_reader_map_interface(&context);
+
+    var buffer: [3]u8 = undefined;
+    const length1 = lib.gci_reader_read(reader, &buffer, buffer.len);
+    try testing.expectEqual(2, length1);
+    try testing.expectEqualStrings("12", buffer[0..2]);
+
+    const length2 = lib.gci_reader_read(reader, &buffer, buffer.len);
+    try testing.expectEqual(0, length2);
+}
+
+test "map take" {
+    var dir = testing.tmpDir(.{});
+    defer dir.cleanup();
+    try dir.dir.writeFile(.{ .sub_path = "map.json", .data = "[1]" });
+
+    const file = try dir.dir.openFile("map.json", .{});
+    defer file.close();
+
+    var context: lib.ConReaderMap = undefined;
+    const init_err = lib.con_reader_map_init(&context, file.handle);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+    defer _ = lib.con_reader_map_deinit(&context);
+    const reader = lib.con_reader_map_interface(&context);
+
+    var buffer: [1]u8 = undefined;
+    const length = lib.gci_reader_read(reader, &buffer, buffer.len);
+    try testing.expectEqual(1, length);
+
+    var data: [*c]const u8 = undefined;
+    var data_size: usize = undefined;
+    try testing.expect(lib.con_reader_map_take(reader, &data, &data_size));
+    try testing.expectEqualStrings("1]", data[0..data_size]);
+    try testing.expectEqual(3, context.position);
+
+    var c: lib.GciReaderString = undefined;
+    const i_err = lib.gci_reader_string_init(&c, "", 0);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), i_err);
+    try testing.expect(!lib.con_reader_map_take(lib.gci_reader_string_interface(&c), &data, &data_size));
+}
+
+test "map comment" {
+    const d = "[  //:(\n \"k //:)\",1/]";
+    var dir = testing.tmpDir(.{});
+    defer dir.cleanup();
+    try dir.dir.writeFile(.{ .sub_path = "map.json", .data = d });
+
+    const file = try dir.dir.openFile("map.json", .{});
+    defer file.close();
+
+    var map: lib.ConReaderMap = undefined;
+    const i_err = lib.con_reader_map_init(&map, file.handle);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), i_err);
+    defer _ = lib.con_reader_map_deinit(&map);
+
+    var context: lib.ConReaderComment = undefined;
+    const init_err = lib.con_reader_comment_init(
+        &context,
+        lib.con_reader_map_interface(&map),
+    );
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+    const reader = lib.con_reader_comment_interface(&context);
+
+    var buffer: [17]u8 = undefined;
+    const length = lib.gci_reader_read(reader, &buffer, buffer.len);
+    try testing.expectEqual(17, length);
+    try testing.expectEqualStrings("[  \n \"k //:)\",1/]", &buffer);
+}
+
+test "map release deserialize" {
+    // `[0,0,...,0]` spanning more than one release step.
+    const count = lib.CON_READER_MAP_RELEASE;
+    const d = try testing.allocator.alloc(u8, 2 * count + 1);
+    defer testing.allocator.free(d);
+    d[0] = '[';
+    for (0..count) |i| {
+        d[2 * i + 1] = '0';
+        d[2 * i + 2] = ',';
+    }
+    d[d.len - 1] = ']';
+
+    var dir = testing.tmpDir(.{});
+    defer dir.cleanup();
+    try dir.dir.writeFile(.{ .sub_path = "map.json", .data = d });
+
+    const file = try dir.dir.openFile("map.json", .{});
+    defer file.close();
+
+    var map: lib.ConReaderMap = undefined;
+    const i_err = lib.con_reader_map_init(&map, file.handle);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), i_err);
+    defer _ = lib.con_reader_map_deinit(&map);
+
+    var depth: [1]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init(&context, lib.con_reader_map_interface(&map), &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+    try testing.expectEqual(0, map.released);
+
+    const open_err = lib.con_deserialize_array_open(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), open_err);
+
+    for (0..count) |_| {
+        const err = lib.con_deserialize_skip(&context);
+        try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), err);
+    }
+
+    const close_err = lib.con_deserialize_array_close(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), close_err);
+    try testing.expect(map.released >= lib.CON_READER_MAP_RELEASE);
+}
@@ -1,3 +1,5 @@
+const std = @import("std");
+
 pub const lib = @cImport({
     @cInclude("gci_interface_writer.h");
     @cInclude("gci_interface_reader.h");
@@ -7,6 +9,10 @@ pub const lib = @cImport({
     @cInclude("con_writer.h");
     @cInclude("con_deserialize.h");
     @cInclude("con_reader.h");
+    @cInclude("con_index.h");
+    @cInclude("con_query.h");
+    @cInclude("con_push.h");
+    @cInclude("con_value.h");
     @cInclude("con_common.h");
 });
 
@@ -32,6 +38,30 @@ pub fn enumToError(err: lib.ConError) !void {
         lib.CON_ERROR_COMMA_UNEXPECTED => return error.CommaUnexpected,
         lib.CON_ERROR_TYPE => return error.Type,
         lib.CON_ERROR_STATE_UNKNOWN => return error.StateUnknown,
+        lib.CON_ERROR_OVERFLOW => return error.Overflow,
+        lib.CON_ERROR_SURROGATE => return error.Surrogate,
+        lib.CON_ERROR_INCOMPLETE => return error.Incomplete,
+        lib.CON_ERROR_QUERY => return error.Query,
+        lib.CON_ERROR_NEED_INPUT => return error.NeedInput,
         else => return error.Unknown,
     }
 }
+
+// Wraps `allocator` for C functions which grow memory, `allocator` must stay
+// valid as long as the memory is used.
+pub fn allocatorInterface(allocator: *const std.mem.Allocator) lib.ConInterfaceAllocator {
+    return .{ .context = allocator, .resize = allocatorResize };
+}
+
+fn allocatorResize(context: ?*const anyopaque, memory: ?*anyopaque, size: usize, new_size: usize) callconv(.C) ?*anyopaque {
+    const allocator: *const std.mem.Allocator = @ptrCast(@alignCast(context));
+    const old: []u8 = if (memory) |m| @as([*]u8, @ptrCast(m))[0..size] else &.{};
+
+    if (new_size == 0) {
+        allocator.free(old);
+        return null;
+    }
+
+    const new = allocator.realloc(old, new_size) catch return null;
+    return new.ptr;
+}
@@ -2,41 +2,64 @@
 #define CON_SERIALIZE_H
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <con_common.h>
 #include <gci_interface_writer.h>
 
 // Context struct representing a single JSON element. Any items are written
-// immediately to the `writer`. With one `struct ConSerialize` only a single
-// element may be written, if one attempts to write invalid JSON
-// or multiple elements errors will be raised (returned).
+// immediately to the `writer` unless a write buffer is supplied, in which case
+// items are collected in the buffer and written in large chunks. With one
+// `struct ConSerialize` only a single element may be written, if one attempts
+// to write invalid JSON or multiple elements errors will be raised (returned).
 //
 // Only writes minified JSON, to write un-minified JSON one can use the
 // specific writer `struct ConWriterIndent`.
 //
+// A call which returns `CON_ERROR_WRITER` because the writer accepted only part
+// of the data, e.g. a non blocking socket which would block, leaves the context
+// as it was before the call apart from `token_written`. Repeating the call with
+// the same arguments once the writer accepts data again writes the rest of the
+// token and nothing twice, no other call may be made in between. With a write
+// buffer the output held in memory is bounded by its size.
+//
 // Fields:
 //  writer:             A valid writer, see `con_writer.h`.
 //  depth:              Current depth of nested containers.
-//  depth_buffer:       Pointer to at least as many items as specified by
-//                      `depth_buffer_size`, owned by this struct.
-//  depth_buffer_size:  A non-negative number specifying at most how many items
-//                      `depth_buffer` points to.
+//  depth_stack:        Containers which are open, packed to one bit per level
+//                      in the depth buffer passed at initialization, see
+//                      `struct ConDepth`.
+//  write_buffer:       Pointer to at least as many bytes as specified by
+//                      `write_buffer_size`, owned by this struct. Written
+//                      items are collected here before being written.
+//  write_buffer_size:  Amount of bytes `write_buffer` points to, if 0 items are
+//                      written to the `writer` immediately.
+//  write_buffer_length: Amount of bytes in `write_buffer` which have not yet
+//                      been written to the `writer`.
+//  token_written:      Amount of bytes of the token whose call failed which
+//                      were written before it failed, 0 if the last call did
+//                      not fail writing.
 //
 // Invariants:
-//  depth:              0 <= depth <= depth_buffer_size
-//  depth_buffer:       If depth_buffer_size > 0:
-//                          Non-null, points to at least as many items as
-//                          specified by `depth_buffer_size`
-//                      If `depth_buffer_size` == 0:
+//  depth:              0 <= depth <= depth_stack.size
+//  write_buffer:       If write_buffer_size > 0:
+//                          Non-null, points to at least as many bytes as
+//                          specified by `write_buffer_size`
+//                      If `write_buffer_size` == 0:
 //                          May be null or even invalid, will never be read from
 //                          or written to.
-//  depth_buffer_size:  0 <= `depth_buffer_size`.
+//  write_buffer_length: 0 <= write_buffer_length <= write_buffer_size
 //  state:              Managed internally, do not modify.
+//  token_offset:       Managed internally, do not modify.
 struct ConSerialize {
     struct GciInterfaceWriter writer;
     size_t depth;
-    enum ConContainer *depth_buffer;
-    int depth_buffer_size;
+    struct ConDepth depth_stack;
+    char *write_buffer;
+    size_t write_buffer_size;
+    size_t write_buffer_length;
     enum ConState state;
+    size_t token_written;
+    size_t token_offset;
 };
 
 // Initializes a serialization context which can then be used to write JSON
@@ -66,10 +89,84 @@ enum ConError con_serialize_init(
     int depth_buffer_size
 );
 
+// Initializes a serialization context which collects written items in
+// `write_buffer` and only writes to `writer` once the buffer is full. Since
+// items may remain in the buffer `con_serialize_flush` must be called once
+// done writing. Note that `CON_ERROR_WRITER` may be returned by any call which
+// writes data, even if the failed data belonged to a previous item.
+//
+// Params:
+//  context:            Valid pointer to single item.
+//  writer:             A writer, see `con_writer.h`. If call succeeds the
+//                      context this writer came from is owned by this `context`
+//  depth_buffer:       May be null if `depth_buffer_size` is 0, must otherwise
+//                      be valid pointer to as many items (or more) as specified.
+//                      by `depth_buffer_size`. If call succeeds this pointer
+//                      is owned by `context`.
+//  depth_buffer_size:  must be equal to or smaller than actual length
+//                      of passed in parameter `depth_buffer`.
+//  write_buffer:       May be null if `write_buffer_size` is 0, must otherwise
+//                      be valid pointer to as many bytes (or more) as specified
+//                      by `write_buffer_size`. If call succeeds this pointer is
+//                      owned by `context`.
+//  write_buffer_size:  must be equal to or smaller than actual length of
+//                      passed in parameter `write_buffer`.
+//
+// Return:
+//  CON_ERROR_OK:       Call succeeded.
+//  CON_ERROR_NULL:     Returned in the following situations:
+//      1. `context` is null.
+//      2. `depth_buffer` is null.
+//      3. `write_buffer` is null.
+//  CON_ERROR_BUFFER:   `depth_buffer_size` is negative.
+enum ConError con_serialize_init_buffer(
+    struct ConSerialize *context,
+    struct GciInterfaceWriter writer,
+    enum ConContainer *depth_buffer,
+    int depth_buffer_size,
+    char *write_buffer,
+    size_t write_buffer_size
+);
+
+// Lets the depth stack of `context` grow with `allocator` instead of returning
+// `CON_ERROR_TOO_DEEP` once it is full, for input of unknown depth. The depth
+// buffer passed at initialization is then used as initial storage at one bit
+// per level, e.g. a 4 byte item holds 32 levels, and memory is only allocated
+// for deeper nesting. `con_serialize_deinit` must be called to free it.
+//
+// Params:
+//  context:    Valid pointer to single item.
+//  allocator:  An allocator, see `struct ConInterfaceAllocator`. Its context
+//              must stay valid until `context` is deinitialized.
+//
+// Return:
+//  CON_ERROR_OK:       Call succeeded.
+//  CON_ERROR_NULL:     `context` or `allocator.resize` is null.
+//  CON_ERROR_BUFFER:   The depth stack already grew with another allocator.
+enum ConError con_serialize_depth_allocator(struct ConSerialize *context, struct ConInterfaceAllocator allocator);
+
+// Frees memory the depth stack of `context` allocated, `context` may not be
+// used afterwards. Does nothing if it has no allocator.
+//
+// Return:
+//  CON_ERROR_OK:       Call succeeded.
+//  CON_ERROR_NULL:     `context` is null.
+enum ConError con_serialize_deinit(struct ConSerialize *context);
+
+// Writes any data collected in the write buffer to the writer. If the writer
+// only accepts part of the data the rest is kept so that the call may be
+// retried. Does nothing if the context has no write buffer.
+//
+// Return:
+//  CON_ERROR_OK:       Call succeeded.
+//  CON_ERROR_WRITER:   Failed to write data.
+enum ConError con_serialize_flush(struct ConSerialize *context);
+
 // Return:
 //  CON_ERROR_OK:       Call succeeded.
 //  CON_ERROR_WRITER:   Failed to write data.
-//  CON_ERROR_TOO_DEEP: Opened too many containers.
+//  CON_ERROR_TOO_DEEP: Opened too many containers, or the depth stack failed to
+//                      grow.
 //  CON_ERROR_COMPLETE: JSON already complete.
 //  CON_ERROR_KEY:      Missing dictionary key before this element.
 enum ConError con_serialize_array_open(struct ConSerialize *context);
@@ -84,7 +181,8 @@ enum ConError con_serialize_array_close(struct ConSerialize *context);
 // Return:
 //  CON_ERROR_OK:       Call succeeded.
 //  CON_ERROR_WRITER:   Failed to write data.
-//  CON_ERROR_TOO_DEEP: Opened too many containers.
+//  CON_ERROR_TOO_DEEP: Opened too many containers, or the depth stack failed to
+//                      grow.
 //  CON_ERROR_COMPLETE: JSON already complete.
 //  CON_ERROR_KEY:      Missing dictionary key before this element.
 enum ConError con_serialize_dict_open(struct ConSerialize *context);
@@ -107,6 +205,18 @@ enum ConError con_serialize_dict_close(struct ConSerialize *context);
 //  CON_ERROR_NOT_DICT: Current container is not a dict.
 enum ConError con_serialize_dict_key(struct ConSerialize *context, char const *key, size_t key_size);
 
+// Writes `key` like `con_serialize_dict_key` but escapes it while writing so
+// any UTF-8 may be passed, `"`, `\` and control characters are written as
+// escape sequences and everything else is copied as is.
+//
+// Return:
+//  CON_ERROR_OK:       Call succeeded.
+//  CON_ERROR_NULL:     `key` is null.
+//  CON_ERROR_WRITER:   Failed to write data.
+//  CON_ERROR_VALUE:    Key has already been written, expected a value.
+//  CON_ERROR_NOT_DICT: Current container is not a dict.
+enum ConError con_serialize_dict_key_escape(struct ConSerialize *context, char const *key, size_t key_size);
+
 // Note: the number to be written is not verified to be valid JSON
 //
 // Return:
@@ -118,6 +228,37 @@ enum ConError con_serialize_dict_key(struct ConSerialize *context, char const *k
 //  CON_ERROR_NOT_NUMBER:   `number` is an empty string.
 enum ConError con_serialize_number(struct ConSerialize *context, char const *number, size_t number_size);
 
+// Formats `value` directly into the output, no validation is needed.
+//
+// Return:
+//  CON_ERROR_OK:           Call succeeded.
+//  CON_ERROR_WRITER:       Failed to write data.
+//  CON_ERROR_COMPLETE:     JSON already complete.
+//  CON_ERROR_KEY:          Missing dictionary key before this element.
+enum ConError con_serialize_int64(struct ConSerialize *context, int64_t value);
+
+// Formats `value` directly into the output, no validation is needed.
+//
+// Return:
+//  CON_ERROR_OK:           Call succeeded.
+//  CON_ERROR_WRITER:       Failed to write data.
+//  CON_ERROR_COMPLETE:     JSON already complete.
+//  CON_ERROR_KEY:          Missing dictionary key before this element.
+enum ConError con_serialize_uint64(struct ConSerialize *context, uint64_t value);
+
+// Formats `value` directly into the output using the shortest digits which
+// read back as the same double, for example `0.1` rather than
+// `0.10000000000000001`. Very large and small values use an exponent.
+//
+// Return:
+//  CON_ERROR_OK:           Call succeeded.
+//  CON_ERROR_WRITER:       Failed to write data.
+//  CON_ERROR_COMPLETE:     JSON already complete.
+//  CON_ERROR_KEY:          Missing dictionary key before this element.
+//  CON_ERROR_NOT_NUMBER:   `value` is infinite or NaN, which JSON cannot
+//                          represent.
+enum ConError con_serialize_double(struct ConSerialize *context, double value);
+
 // Note the string to be written is not changed in any way, i.e. new lines will
 // not be converted to their corrsponding escape sequence.
 //
@@ -129,6 +270,18 @@ enum ConError con_serialize_number(struct ConSerialize *context, char const *num
 //  CON_ERROR_KEY:      Missing dictionary key before this element.
 enum ConError con_serialize_string(struct ConSerialize *context, char const *string, size_t string_size);
 
+// Writes `string` like `con_serialize_string` but escapes it while writing so
+// any UTF-8 may be passed, `"`, `\` and control characters are written as
+// escape sequences and everything else is copied as is.
+//
+// Return:
+//  CON_ERROR_OK:       Call succeeded.
+//  CON_ERROR_NULL:     `string` is null.
+//  CON_ERROR_WRITER:   Failed to write data.
+//  CON_ERROR_COMPLETE: JSON already complete.
+//  CON_ERROR_KEY:      Missing dictionary key before this element.
+enum ConError con_serialize_string_escape(struct ConSerialize *context, char const *string, size_t string_size);
+
 // Return:
 //  CON_ERROR_OK:       Call succeeded.
 //  CON_ERROR_WRITER:   Failed to write data.
@@ -143,6 +296,16 @@ enum ConError con_serialize_bool(struct ConSerialize *context, bool value);
 //  CON_ERROR_KEY:      Missing dictionary key before this element.
 enum ConError con_serialize_null(struct ConSerialize *context);
 
+// Ends a complete element with a newline and resets the context so that another
+// element may be written, producing newline delimited JSON. Nothing is written
+// before the first element.
+//
+// Return:
+//  CON_ERROR_OK:           Call succeeded.
+//  CON_ERROR_WRITER:       Failed to write data.
+//  CON_ERROR_INCOMPLETE:   Current element is not complete.
+enum ConError con_serialize_record(struct ConSerialize *context);
+
 enum ConError con_serialize_check_number(char const *num, size_t num_size, size_t *first_error);
 
 enum ConError con_serialize_check_string(char const *string, size_t string_size, size_t *first_error);
@@ -3,17 +3,99 @@
 #include <gci_interface_writer.h>
 #include <con_common.h>
 
-// A writer that converts minfied JSON to indented JSON. Note that this writer
-// will destroy any buffering since every write will be broken up into single
-// writes. Therefore this should not be the inner writer to a buffered writer,
-// the inner writer of this writer should be buffered if anything.
+// Maximum amount of bytes of an array which a `struct ConWriterIndent` holds
+// back to decide whether it fits on one line, see `array_width`.
+#define CON_WRITER_INDENT_WINDOW 128
+
+// How a `struct ConWriterIndent` lays out its output.
+//
+// Fields:
+//  indent_width:   Amount of characters per level of indentation.
+//  tabs:           Indent with tabs instead of spaces.
+//  array_width:    Arrays which only contain numbers, strings, bools or null
+//                  and are at most this many bytes long when minified are
+//                  written on one line, e.g. `[1, 2, 3]`. At most
+//                  `CON_WRITER_INDENT_WINDOW`, 0 puts every item on its own
+//                  line.
+//  key_width:      Keys, including their quotes, shorter than this are padded
+//                  with spaces after their `:` so that the values of a
+//                  dictionary line up. Keys are not reordered, 0 writes a
+//                  single space after every `:`.
+struct ConWriterIndentStyle {
+    size_t indent_width;
+    bool tabs;
+    size_t array_width;
+    size_t key_width;
+};
+
+// Style used by `con_writer_indent_init`, two spaces per level and one item
+// per line.
+struct ConWriterIndentStyle con_writer_indent_style_default(void);
+
+// Style which spends as few bytes as possible while staying readable, a tab
+// per level and short arrays of scalars on one line.
+struct ConWriterIndentStyle con_writer_indent_style_compact(void);
+
+// Whitespace a `struct ConWriterIndent` owes in front of the next byte.
+enum ConWriterIndentPending {
+    CON_WRITER_INDENT_PENDING_NONE      = 0,    // nothing
+    CON_WRITER_INDENT_PENDING_SPACE     = 1,    // spaces after `:`
+    CON_WRITER_INDENT_PENDING_ITEM      = 2,    // a space after `,` on one line
+    CON_WRITER_INDENT_PENDING_NEWLINE   = 3,    // a new line and indentation
+    CON_WRITER_INDENT_PENDING_DONE      = 4,    // already written
+};
+
+// What a `struct ConWriterIndent` does with the bytes in its window.
+enum ConWriterIndentWindow {
+    CON_WRITER_INDENT_WINDOW_NONE       = 0,    // window is not used
+    CON_WRITER_INDENT_WINDOW_COLLECT    = 1,    // holding back an array
+    CON_WRITER_INDENT_WINDOW_LINE       = 2,    // writing it on one line
+    CON_WRITER_INDENT_WINDOW_LINES      = 3,    // writing it one item per line
+};
+
+// A writer that converts minfied JSON to indented JSON. Runs of bytes which
+// are copied as is, e.g. the body of a string or a number, are passed on in
+// a single write and a new line with its indentation is written at once, so
+// the amount of writes is proportional to the amount of tokens and not to
+// the amount of bytes. Whitespace is only written once the byte following it
+// is known. If the inner writer fails part way the bytes which were written
+// are reported and writing may resume at the first byte which was not.
+//
+// Output is written as input arrives, except for arrays while `array_width`
+// is not 0. Those are held back in `window` until they close, contain a
+// container or grow past `array_width`, all bytes held back are reported as
+// written.
+//
+// Fields:
+//  writer:             Receives the indented JSON.
+//  style:              Layout of the output, see `struct ConWriterIndentStyle`.
+//  state:              Managed internally, do not modify.
+//  depth:              Managed internally, do not modify.
+//  pending:            Managed internally, do not modify.
+//  pending_written:    Managed internally, do not modify.
+//  key_size:           Managed internally, do not modify.
+//  window:             Managed internally, do not modify.
+//  window_size:        Managed internally, do not modify.
+//  window_offset:      Managed internally, do not modify.
+//  window_state:       Managed internally, do not modify.
+//  window_char:        Managed internally, do not modify.
 struct ConWriterIndent {
     struct GciInterfaceWriter writer;
+    struct ConWriterIndentStyle style;
     struct ConStateChar state;
     size_t depth;
+    enum ConWriterIndentPending pending;
+    size_t pending_written;
+    size_t key_size;
+    char window[CON_WRITER_INDENT_WINDOW];
+    size_t window_size;
+    size_t window_offset;
+    enum ConWriterIndentWindow window_state;
+    struct ConStateChar window_char;
 };
 
-// Initializes a `struct ConWriterIndent`
+// Initializes a `struct ConWriterIndent` with the default style, see
+// `con_writer_indent_style_default`.
 //
 // Params:
 //  context:    Single items pointer to `struct ConWriterIndent`.
@@ -27,6 +109,24 @@ enum ConError con_writer_indent_init(
     struct GciInterfaceWriter writer
 );
 
+// Initializes a `struct ConWriterIndent` which lays out its output in `style`.
+//
+// Params:
+//  context:    Single items pointer to `struct ConWriterIndent`.
+//  writer:     Valid write struct, owned by `context` if call succeeds.
+//  style:      Layout of the output, see `struct ConWriterIndentStyle`.
+//
+// Return:
+//  CON_ERROR_OK:       Call succeeded.
+//  CON_ERROR_NULL:     `context` is null.
+//  CON_ERROR_BUFFER:   `style.array_width` is larger than
+//                      `CON_WRITER_INDENT_WINDOW`.
+enum ConError con_writer_indent_init_style(
+    struct ConWriterIndent *context,
+    struct GciInterfaceWriter writer,
+    struct ConWriterIndentStyle style
+);
+
 // Makes a writer interface from an already initialized `struct ConWriterIndent`
 // the returned writer owns the passed in `context`.
 struct GciInterfaceWriter con_writer_indent_interface(struct ConWriterIndent *context);
@@ -1,123 +1,187 @@
 #include <assert.h>
 #include <ctype.h>
+#include <math.h>
+#include <string.h>
 #include <utils.h>
 #include "con_serialize.h"
 
 static inline enum ConError con_serialize_comma(struct ConSerialize *context, enum ConState state);
 static inline enum ConContainer con_serialize_container_current(struct ConSerialize *context);
+static inline enum ConError con_serialize_internal_write(struct ConSerialize *context, char const *data, size_t data_size);
+static inline enum ConError con_serialize_internal_output(struct ConSerialize *context, char const *data, size_t data_size, size_t *written);
+static inline void con_serialize_token_end(struct ConSerialize *context);
+static inline enum ConError con_serialize_number_unchecked(struct ConSerialize *context, char const *number, size_t number_size);
+static inline enum ConError con_serialize_escaped(struct ConSerialize *context, char const *string, size_t string_size);
 
 enum ConError con_serialize_init(
     struct ConSerialize *context,
     struct GciInterfaceWriter writer,
     enum ConContainer *depth_buffer,
     int depth_buffer_size
+) {
+    return con_serialize_init_buffer(context, writer, depth_buffer, depth_buffer_size, NULL, 0);
+}
+
+enum ConError con_serialize_init_buffer(
+    struct ConSerialize *context,
+    struct GciInterfaceWriter writer,
+    enum ConContainer *depth_buffer,
+    int depth_buffer_size,
+    char *write_buffer,
+    size_t write_buffer_size
 ) {
     if (context == NULL) { return CON_ERROR_NULL; }
     if (depth_buffer == NULL && depth_buffer_size > 0) { return CON_ERROR_NULL; }
+    if (write_buffer == NULL && write_buffer_size > 0) { return CON_ERROR_NULL; }
     if (depth_buffer_size < 0) { return CON_ERROR_BUFFER; }
 
     context->writer = writer;
     context->depth = 0;
-    context->depth_buffer = depth_buffer;
-    context->depth_buffer_size = depth_buffer_size;
+    con_utils_depth_init(&context->depth_stack, depth_buffer, (size_t) depth_buffer_size);
+    context->write_buffer = write_buffer;
+    context->write_buffer_size = write_buffer_size;
+    context->write_buffer_length = 0;
     context->state = con_utils_state_init();
+    context->token_written = 0;
+    context->token_offset = 0;
+
+    return CON_ERROR_OK;
+}
+
+enum ConError con_serialize_depth_allocator(struct ConSerialize *context, struct ConInterfaceAllocator allocator) {
+    if (context == NULL) { return CON_ERROR_NULL; }
+    if (allocator.resize == NULL) { return CON_ERROR_NULL; }
+    return con_utils_depth_allocator(&context->depth_stack, allocator);
+}
 
+enum ConError con_serialize_deinit(struct ConSerialize *context) {
+    if (context == NULL) { return CON_ERROR_NULL; }
+    con_utils_depth_deinit(&context->depth_stack);
+    return CON_ERROR_OK;
+}
+
+enum ConError con_serialize_flush(struct ConSerialize *context) {
+    assert(context != NULL);
+    assert(context->write_buffer_length <= context->write_buffer_size);
+    if (context->write_buffer_length == 0) { return CON_ERROR_OK; }
+
+    assert(context->write_buffer != NULL);
+    size_t length = context->write_buffer_length;
+    size_t result = gci_writer_write(context->writer, context->write_buffer, length);
+    assert(result <= length);
+
+    if (result != length) {
+        // Keep data which was not written so that flushing can be retried
+        memmove(context->write_buffer, context->write_buffer + result, length - result);
+        context->write_buffer_length = length - result;
+        return CON_ERROR_WRITER;
+    }
+
+    context->write_buffer_length = 0;
     return CON_ERROR_OK;
 }
 
 enum ConError con_serialize_array_open(struct ConSerialize *context) {
     assert(context != NULL);
 
-    assert(context->depth_buffer_size >= 0);
-    assert(0 <= context->depth && context->depth <= (size_t) context->depth_buffer_size);
-    if (context->depth >= (size_t) context->depth_buffer_size) { return CON_ERROR_TOO_DEEP; }
+    assert(context->depth <= context->depth_stack.size);
+    enum ConError depth_err = con_utils_depth_reserve(&context->depth_stack, context->depth + 1);
+    if (depth_err) { return depth_err; }
 
-    enum ConState prev = context->state;
+    enum ConState state = context->state;
     enum ConContainer current = con_serialize_container_current(context);
-    enum ConError state_err = con_utils_state_open(&context->state, current);
+    enum ConError state_err = con_utils_state_open(&state, current);
     if (state_err) { return state_err; }
 
-    enum ConError comma_err = con_serialize_comma(context, prev);
+    enum ConError comma_err = con_serialize_comma(context, context->state);
     if (comma_err) { return comma_err; }
 
-    assert(context->depth_buffer != NULL);
-    context->depth_buffer[context->depth] = CON_CONTAINER_ARRAY;
+    enum ConError write_err = con_serialize_internal_write(context, "[", 1);
+    if (write_err) { return write_err; }
+
+    con_utils_depth_set(&context->depth_stack, context->depth, CON_CONTAINER_ARRAY);
     context->depth += 1;
 
-    size_t result = gci_writer_write(context->writer, "[", 1);
-    if (result != 1) { return CON_ERROR_WRITER; }
+    context->state = state;
+    con_serialize_token_end(context);
     return CON_ERROR_OK;
 }
 
 enum ConError con_serialize_array_close(struct ConSerialize *context) {
     assert(context != NULL);
 
-    assert(context->depth_buffer_size >= 0);
-    assert(0 <= context->depth && context->depth <= (size_t) context->depth_buffer_size);
+    assert(context->depth <= context->depth_stack.size);
     if (context->depth <= 0) { return CON_ERROR_CLOSED_TOO_MANY; }
 
     enum ConContainer current = con_serialize_container_current(context);
     if (current != CON_CONTAINER_ARRAY) { return CON_ERROR_NOT_ARRAY; }
 
-    enum ConError err = con_utils_state_close(&context->state, current);
+    enum ConState state = context->state;
+    enum ConError err = con_utils_state_close(&state, current);
     if (err) { return err; }
 
-    size_t result = gci_writer_write(context->writer, "]", 1);
-    if (result != 1) { return CON_ERROR_WRITER; }
+    enum ConError write_err = con_serialize_internal_write(context, "]", 1);
+    if (write_err) { return write_err; }
 
     context->depth -= 1;
 
     if (context->depth == 0) {
-        context->state = CON_STATE_COMPLETE;
+        state = CON_STATE_COMPLETE;
     }
+    context->state = state;
+    con_serialize_token_end(context);
     return CON_ERROR_OK;
 }
 
 enum ConError con_serialize_dict_open(struct ConSerialize *context) {
     assert(context != NULL);
 
-    assert(context->depth_buffer_size >= 0);
-    assert(0 <= context->depth && context->depth <= (size_t) context->depth_buffer_size);
-    if (context->depth >= (size_t) context->depth_buffer_size) { return CON_ERROR_TOO_DEEP; }
+    assert(context->depth <= context->depth_stack.size);
+    enum ConError depth_err = con_utils_depth_reserve(&context->depth_stack, context->depth + 1);
+    if (depth_err) { return depth_err; }
 
-    enum ConState prev = context->state;
+    enum ConState state = context->state;
     enum ConContainer current = con_serialize_container_current(context);
-    enum ConError state_err = con_utils_state_open(&context->state, current);
+    enum ConError state_err = con_utils_state_open(&state, current);
     if (state_err) { return state_err; }
 
-    enum ConError comma_err = con_serialize_comma(context, prev);
+    enum ConError comma_err = con_serialize_comma(context, context->state);
     if (comma_err) { return comma_err; }
 
-    assert(context->depth_buffer != NULL);
-    context->depth_buffer[context->depth] = CON_CONTAINER_DICT;
+    enum ConError write_err = con_serialize_internal_write(context, "{", 1);
+    if (write_err) { return write_err; }
+
+    con_utils_depth_set(&context->depth_stack, context->depth, CON_CONTAINER_DICT);
     context->depth += 1;
 
-    size_t result = gci_writer_write(context->writer, "{", 1);
-    if (result != 1) { return CON_ERROR_WRITER; }
+    context->state = state;
+    con_serialize_token_end(context);
     return CON_ERROR_OK;
 }
 
 enum ConError con_serialize_dict_close(struct ConSerialize *context) {
     assert(context != NULL);
 
-    assert(context->depth_buffer_size >= 0);
-    assert(0 <= context->depth && context->depth <= (size_t) context->depth_buffer_size);
+    assert(context->depth <= context->depth_stack.size);
     if (context->depth <= 0) { return CON_ERROR_CLOSED_TOO_MANY; }
 
     enum ConContainer current = con_serialize_container_current(context);
     if (current != CON_CONTAINER_DICT) { return CON_ERROR_NOT_DICT; }
 
-    enum ConError err = con_utils_state_close(&context->state, current);
+    enum ConState state = context->state;
+    enum ConError err = con_utils_state_close(&state, current);
     if (err) { return err; }
 
-    size_t result = gci_writer_write(context->writer, "}", 1);
-    if (result != 1) { return CON_ERROR_WRITER; }
+    enum ConError write_err = con_serialize_internal_write(context, "}", 1);
+    if (write_err) { return write_err; }
 
     context->depth -= 1;
 
     if (context->depth == 0) {
-        context->state = CON_STATE_COMPLETE;
+        state = CON_STATE_COMPLETE;
     }
+    context->state = state;
+    con_serialize_token_end(context);
     return CON_ERROR_OK;
 }
 
@@ -136,19 +200,50 @@ enum ConError con_serialize_dict_key(struct ConSerialize *context, char const *k
         return CON_ERROR_NOT_DICT;
     }
 
-    enum ConState prev = context->state;
-    enum ConError state_err = con_utils_state_key(&context->state, current);
+    enum ConState state = context->state;
+    enum ConError state_err = con_utils_state_key(&state, current);
     if (state_err) { return state_err; }
 
-    enum ConError comma_err = con_serialize_comma(context, prev);
+    enum ConError comma_err = con_serialize_comma(context, context->state);
     if (comma_err) { return comma_err; }
 
-    size_t result = gci_writer_write(context->writer, "\"", 1);
-    if (result != 1) { return CON_ERROR_WRITER; }
-    result = gci_writer_write(context->writer, key, key_size);
-    if (result != key_size) { return CON_ERROR_WRITER; }
-    result = gci_writer_write(context->writer, "\":", 2);
-    if (result != 2) { return CON_ERROR_WRITER; }
+    enum ConError write_err = con_serialize_internal_write(context, "\"", 1);
+    if (write_err) { return write_err; }
+    write_err = con_serialize_internal_write(context, key, key_size);
+    if (write_err) { return write_err; }
+    write_err = con_serialize_internal_write(context, "\":", 2);
+    if (write_err) { return write_err; }
+
+    context->state = state;
+    con_serialize_token_end(context);
+    return CON_ERROR_OK;
+}
+
+enum ConError con_serialize_dict_key_escape(struct ConSerialize *context, char const *key, size_t key_size) {
+    assert(context != NULL);
+    if (key == NULL) { return CON_ERROR_NULL; }
+
+    enum ConContainer current = con_serialize_container_current(context);
+    if (current != CON_CONTAINER_DICT) {
+        return CON_ERROR_NOT_DICT;
+    }
+
+    enum ConState state = context->state;
+    enum ConError state_err = con_utils_state_key(&state, current);
+    if (state_err) { return state_err; }
+
+    enum ConError comma_err = con_serialize_comma(context, context->state);
+    if (comma_err) { return comma_err; }
+
+    enum ConError write_err = con_serialize_internal_write(context, "\"", 1);
+    if (write_err) { return write_err; }
+    write_err = con_serialize_escaped(context, key, key_size);
+    if (write_err) { return write_err; }
+    write_err = con_serialize_internal_write(context, "\":", 2);
+    if (write_err) { return write_err; }
+
+    context->state = state;
+    con_serialize_token_end(context);
     return CON_ERROR_OK;
 }
 
@@ -163,18 +258,32 @@ enum ConError con_serialize_number(struct ConSerialize *context, char const *num
         if (err) { return err; }
     }
 
-    enum ConState prev = context->state;
-    enum ConContainer current = con_serialize_container_current(context);
-    enum ConError state_err = con_utils_state_next(&context->state, current);
-    if (state_err) { return state_err; }
+    return con_serialize_number_unchecked(context, number, number_size);
+}
 
-    enum ConError comma_err = con_serialize_comma(context, prev);
-    if (comma_err) { return comma_err; }
+enum ConError con_serialize_int64(struct ConSerialize *context, int64_t value) {
+    assert(context != NULL);
 
-    size_t result = gci_writer_write(context->writer, number, number_size);
-    if (result != number_size) { return CON_ERROR_WRITER; }
+    char number[CON_UTILS_FORMAT_SIZE];
+    size_t number_size = con_utils_format_int64(number, value);
+    return con_serialize_number_unchecked(context, number, number_size);
+}
 
-    return CON_ERROR_OK;
+enum ConError con_serialize_uint64(struct ConSerialize *context, uint64_t value) {
+    assert(context != NULL);
+
+    char number[CON_UTILS_FORMAT_SIZE];
+    size_t number_size = con_utils_format_uint64(number, value);
+    return con_serialize_number_unchecked(context, number, number_size);
+}
+
+enum ConError con_serialize_double(struct ConSerialize *context, double value) {
+    assert(context != NULL);
+    if (!isfinite(value)) { return CON_ERROR_NOT_NUMBER; }
+
+    char number[CON_UTILS_FORMAT_SIZE];
+    size_t number_size = con_utils_format_double(number, value);
+    return con_serialize_number_unchecked(context, number, number_size);
 }
 
 enum ConError con_serialize_string(struct ConSerialize *context, char const *string, size_t string_size) {
@@ -187,67 +296,113 @@ enum ConError con_serialize_string(struct ConSerialize *context, char const *str
         if (err) { return err; }
     }
 
-    enum ConState prev = context->state;
+    enum ConState state = context->state;
+    enum ConContainer current = con_serialize_container_current(context);
+    enum ConError state_err = con_utils_state_next(&state, current);
+    if (state_err) { return state_err; }
+
+    enum ConError comma_err = con_serialize_comma(context, context->state);
+    if (comma_err) { return comma_err; }
+
+    enum ConError write_err = con_serialize_internal_write(context, "\"", 1);
+    if (write_err) { return write_err; }
+    write_err = con_serialize_internal_write(context, string, string_size);
+    if (write_err) { return write_err; }
+    write_err = con_serialize_internal_write(context, "\"", 1);
+    if (write_err) { return write_err; }
+
+    context->state = state;
+    con_serialize_token_end(context);
+    return CON_ERROR_OK;
+}
+
+enum ConError con_serialize_string_escape(struct ConSerialize *context, char const *string, size_t string_size) {
+    assert(context != NULL);
+    if (string == NULL) { return CON_ERROR_NULL; }
+
+    enum ConState state = context->state;
     enum ConContainer current = con_serialize_container_current(context);
-    enum ConError state_err = con_utils_state_next(&context->state, current);
+    enum ConError state_err = con_utils_state_next(&state, current);
     if (state_err) { return state_err; }
 
-    enum ConError comma_err = con_serialize_comma(context, prev);
+    enum ConError comma_err = con_serialize_comma(context, context->state);
     if (comma_err) { return comma_err; }
 
-    size_t result = gci_writer_write(context->writer, "\"", 1);
-    if (result != 1) { return CON_ERROR_WRITER; }
-    result = gci_writer_write(context->writer, string, string_size);
-    if (result != string_size) { return CON_ERROR_WRITER; }
-    result = gci_writer_write(context->writer, "\"", 1);
-    if (result != 1) { return CON_ERROR_WRITER; }
+    enum ConError write_err = con_serialize_internal_write(context, "\"", 1);
+    if (write_err) { return write_err; }
+    write_err = con_serialize_escaped(context, string, string_size);
+    if (write_err) { return write_err; }
+    write_err = con_serialize_internal_write(context, "\"", 1);
+    if (write_err) { return write_err; }
 
+    context->state = state;
+    con_serialize_token_end(context);
     return CON_ERROR_OK;
 }
 
 enum ConError con_serialize_bool(struct ConSerialize *context, bool value) {
     assert(context != NULL);
-    enum ConState prev = context->state;
+    enum ConState state = context->state;
     enum ConContainer current = con_serialize_container_current(context);
-    enum ConError state_err = con_utils_state_next(&context->state, current);
+    enum ConError state_err = con_utils_state_next(&state, current);
     if (state_err) { return state_err; }
 
-    enum ConError comma_err = con_serialize_comma(context, prev);
+    enum ConError comma_err = con_serialize_comma(context, context->state);
     if (comma_err) { return comma_err; }
 
-    size_t result;
-    size_t expected;
+    enum ConError write_err;
     if (value) {
-        expected = 4;
-        result = gci_writer_write(context->writer, "true", expected);
+        write_err = con_serialize_internal_write(context, "true", 4);
     } else {
-        expected = 5;
-        result = gci_writer_write(context->writer, "false", expected);
+        write_err = con_serialize_internal_write(context, "false", 5);
     }
-    if (result != expected) { return CON_ERROR_WRITER; }
+    if (write_err) { return write_err; }
 
+    context->state = state;
+    con_serialize_token_end(context);
     return CON_ERROR_OK;
 }
 
 enum ConError con_serialize_null(struct ConSerialize *context) {
     assert(context != NULL);
-    enum ConState prev = context->state;
+    enum ConState state = context->state;
     enum ConContainer current = con_serialize_container_current(context);
-    enum ConError state_err = con_utils_state_next(&context->state, current);
+    enum ConError state_err = con_utils_state_next(&state, current);
     if (state_err) { return state_err; }
 
-    enum ConError comma_err = con_serialize_comma(context, prev);
+    enum ConError comma_err = con_serialize_comma(context, context->state);
     if (comma_err) { return comma_err; }
 
-    size_t result = gci_writer_write(context->writer, "null", 4);
-    if (result != 4) { return CON_ERROR_WRITER; }
+    enum ConError write_err = con_serialize_internal_write(context, "null", 4);
+    if (write_err) { return write_err; }
+
+    context->state = state;
+    con_serialize_token_end(context);
+    return CON_ERROR_OK;
+}
+
+enum ConError con_serialize_record(struct ConSerialize *context) {
+    assert(context != NULL);
+    if (context->state != CON_STATE_COMPLETE) { return CON_ERROR_INCOMPLETE; }
+    assert(context->depth == 0);
+
+    enum ConError write_err = con_serialize_internal_write(context, "\n", 1);
+    if (write_err) { return write_err; }
 
+    context->state = con_utils_state_init();
+    con_serialize_token_end(context);
     return CON_ERROR_OK;
 }
 
 enum ConError con_serialize_check_number(char const *number, size_t number_size, size_t *first_error) {
     enum StateNumber state = NUMBER_START;
     for (*first_error = 0; *first_error < number_size; (*first_error)++) {
+        if (state == NUMBER_WHOLE || state == NUMBER_FRACTION || state == NUMBER_EXPONENT) {
+            // digits do not change these states
+            *first_error += con_utils_digit_span(number + *first_error, number_size - *first_error);
+            if (*first_error >= number_size) { break; }
+        }
+
         state = con_utils_state_number_next(state, number[*first_error]);
         if (state == NUMBER_ERROR) { return CON_ERROR_NOT_NUMBER; }
     }
@@ -266,6 +421,10 @@ enum ConError con_serialize_check_string(char const *string, size_t string_size,
     bool escaped = false;
     for (*first_error = 0; *first_error < string_size; (*first_error)++) {
         if (!escaped) {
+            // characters which are not special are accepted as is
+            *first_error += con_utils_check_string_span(string + *first_error, string_size - *first_error);
+            if (*first_error >= string_size) { break; }
+
             escaped = string[*first_error] == '\\';
             switch (string[*first_error]) {  // unescaped
                 case '"':
@@ -320,9 +479,137 @@ enum ConError con_serialize_check_string(char const *string, size_t string_size,
 
 static inline enum ConContainer con_serialize_container_current(struct ConSerialize *context) {
     assert(context != NULL);
-    assert(context->depth_buffer_size >= 0);
-    size_t size = (size_t) context->depth_buffer_size;
-    return con_utils_container_current(context->depth_buffer, size, context->depth);
+    return con_utils_depth_current(&context->depth_stack, context->depth);
+}
+
+// Writes the part of `data` which was not written yet. A call which failed to
+// write its token completely is repeated with the same arguments, the bytes of
+// the token which were written before are counted in `token_written` and
+// skipped so writing resumes exactly where it stopped.
+static inline enum ConError con_serialize_internal_write(struct ConSerialize *context, char const *data, size_t data_size) {
+    assert(context != NULL);
+    assert(data != NULL);
+
+    size_t offset = context->token_offset;
+    context->token_offset += data_size;
+    if (context->token_written >= context->token_offset) { return CON_ERROR_OK; }
+
+    if (context->token_written > offset) {
+        size_t skip = context->token_written - offset;
+        data += skip;
+        data_size -= skip;
+        offset += skip;
+    }
+
+    size_t written = 0;
+    enum ConError err = con_serialize_internal_output(context, data, data_size, &written);
+    if (err) {
+        assert(written < data_size);
+        context->token_written = offset + written;
+        context->token_offset = 0;
+        return err;
+    }
+
+    return CON_ERROR_OK;
+}
+
+static inline enum ConError con_serialize_internal_output(struct ConSerialize *context, char const *data, size_t data_size, size_t *written) {
+    assert(context != NULL);
+    assert(data != NULL);
+    assert(written != NULL);
+
+    if (context->write_buffer_size == 0) {
+        *written = gci_writer_write(context->writer, data, data_size);
+        assert(*written <= data_size);
+        if (*written != data_size) { return CON_ERROR_WRITER; }
+        return CON_ERROR_OK;
+    }
+
+    assert(context->write_buffer != NULL);
+    assert(context->write_buffer_length <= context->write_buffer_size);
+    if (data_size > context->write_buffer_size - context->write_buffer_length) {
+        enum ConError err = con_serialize_flush(context);
+        if (err) { return err; }
+    }
+
+    if (data_size >= context->write_buffer_size) {
+        assert(context->write_buffer_length == 0);
+        *written = gci_writer_write(context->writer, data, data_size);
+        assert(*written <= data_size);
+        if (*written != data_size) { return CON_ERROR_WRITER; }
+        return CON_ERROR_OK;
+    }
+
+    memcpy(context->write_buffer + context->write_buffer_length, data, data_size);
+    context->write_buffer_length += data_size;
+    *written = data_size;
+    return CON_ERROR_OK;
+}
+
+// Called once a token is written completely.
+static inline void con_serialize_token_end(struct ConSerialize *context) {
+    assert(context != NULL);
+    assert(context->token_written <= context->token_offset);
+    context->token_written = 0;
+    context->token_offset = 0;
+}
+
+static inline enum ConError con_serialize_number_unchecked(struct ConSerialize *context, char const *number, size_t number_size) {
+    assert(context != NULL);
+    assert(number != NULL);
+
+    enum ConState state = context->state;
+    enum ConContainer current = con_serialize_container_current(context);
+    enum ConError state_err = con_utils_state_next(&state, current);
+    if (state_err) { return state_err; }
+
+    enum ConError comma_err = con_serialize_comma(context, context->state);
+    if (comma_err) { return comma_err; }
+
+    enum ConError write_err = con_serialize_internal_write(context, number, number_size);
+    if (write_err) { return write_err; }
+
+    context->state = state;
+    con_serialize_token_end(context);
+    return CON_ERROR_OK;
+}
+
+static inline enum ConError con_serialize_escaped(struct ConSerialize *context, char const *string, size_t string_size) {
+    assert(context != NULL);
+    assert(string != NULL || string_size == 0);
+
+    static char const hex[] = "0123456789abcdef";
+
+    size_t index = 0;
+    while (index < string_size) {
+        size_t run = con_utils_escape_span(string + index, string_size - index);
+        if (run > 0) {
+            enum ConError write_err = con_serialize_internal_write(context, string + index, run);
+            if (write_err) { return write_err; }
+            index += run;
+        }
+        if (index >= string_size) { break; }
+
+        unsigned char c = (unsigned char) string[index];
+        char escape[6] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF] };
+        size_t escape_size = 2;
+        switch (c) {
+            case ('"'):     escape[1] = '"'; break;
+            case ('\\'):    escape[1] = '\\'; break;
+            case ('\b'):    escape[1] = 'b'; break;
+            case ('\f'):    escape[1] = 'f'; break;
+            case ('\n'):    escape[1] = 'n'; break;
+            case ('\r'):    escape[1] = 'r'; break;
+            case ('\t'):    escape[1] = 't'; break;
+            default:        escape_size = 6; break;
+        }
+
+        enum ConError write_err = con_serialize_internal_write(context, escape, escape_size);
+        if (write_err) { return write_err; }
+        index += 1;
+    }
+
+    return CON_ERROR_OK;
 }
 
 static inline enum ConError con_serialize_comma(struct ConSerialize *context, enum ConState state) {
@@ -331,8 +618,8 @@ static inline enum ConError con_serialize_comma(struct ConSerialize *context, en
     }
 
     assert(context != NULL);
-    size_t result = gci_writer_write(context->writer, ",", 1);
-    if (result != 1) { return CON_ERROR_WRITER; }
+    enum ConError write_err = con_serialize_internal_write(context, ",", 1);
+    if (write_err) { return write_err; }
 
     return CON_ERROR_OK;
 }
@@ -6,6 +6,7 @@ const lib = internal.lib;
 
 pub const Serialize = struct {
     inner: lib.ConSerialize,
+    allocator: std.mem.Allocator = undefined,
 
     pub fn init(writer: gci.InterfaceWriter, depth: []lib.ConContainer) !Serialize {
         if (depth.len > std.math.maxInt(c_int)) {
@@ -24,8 +25,44 @@ pub const Serialize = struct {
         return context;
     }
 
+    pub fn initBuffer(writer: gci.InterfaceWriter, depth: []lib.ConContainer, buffer: []u8) !Serialize {
+        if (depth.len > std.math.maxInt(c_int)) {
+            return error.Overflow;
+        }
+
+        var context = Serialize{ .inner = undefined };
+        const err = lib.con_serialize_init_buffer(
+            &context.inner,
+            @as(*lib.GciInterfaceWriter, @ptrCast(@constCast(&writer.writer))).*,
+            depth.ptr,
+            @intCast(depth.len),
+            buffer.ptr,
+            buffer.len,
+        );
+
+        try internal.enumToError(err);
+        return context;
+    }
+
+    // Lets the depth stack grow with `allocator`, see
+    // `con_serialize_depth_allocator`. Memory is freed by `deinit`. The
+    // allocator is stored in `self` and the C context points at it, so `self`
+    // must not be moved or copied after this call.
+    pub fn depthAllocator(self: *Serialize, allocator: std.mem.Allocator) !void {
+        self.allocator = allocator;
+        const err = lib.con_serialize_depth_allocator(&self.inner, internal.allocatorInterface(&self.allocator));
+        return internal.enumToError(err);
+    }
+
     pub fn deinit(self: Serialize) void {
-        _ = self;
+        var inner = self.inner;
+        const err = lib.con_serialize_deinit(&inner);
+        std.debug.assert(err == lib.CON_ERROR_OK);
+    }
+
+    pub fn flush(self: *Serialize) !void {
+        const err = lib.con_serialize_flush(&self.inner);
+        return internal.enumToError(err);
     }
 
     pub fn arrayOpen(self: *Serialize) !void {
@@ -53,16 +90,41 @@ pub const Serialize = struct {
         return internal.enumToError(err);
     }
 
+    pub fn dictKeyEscape(self: *Serialize, key: []const u8) !void {
+        const err = lib.con_serialize_dict_key_escape(&self.inner, key.ptr, key.len);
+        return internal.enumToError(err);
+    }
+
     pub fn number(self: *Serialize, num: []const u8) !void {
         const err = lib.con_serialize_number(&self.inner, num.ptr, num.len);
         return internal.enumToError(err);
     }
 
+    pub fn int(self: *Serialize, value: i64) !void {
+        const err = lib.con_serialize_int64(&self.inner, value);
+        return internal.enumToError(err);
+    }
+
+    pub fn uint(self: *Serialize, value: u64) !void {
+        const err = lib.con_serialize_uint64(&self.inner, value);
+        return internal.enumToError(err);
+    }
+
+    pub fn float(self: *Serialize, value: f64) !void {
+        const err = lib.con_serialize_double(&self.inner, value);
+        return internal.enumToError(err);
+    }
+
     pub fn string(self: *Serialize, str: []const u8) !void {
         const err = lib.con_serialize_string(&self.inner, str.ptr, str.len);
         return internal.enumToError(err);
     }
 
+    pub fn stringEscape(self: *Serialize, str: []const u8) !void {
+        const err = lib.con_serialize_string_escape(&self.inner, str.ptr, str.len);
+        return internal.enumToError(err);
+    }
+
     pub fn @"bool"(self: *Serialize, value: bool) !void {
         const err = lib.con_serialize_bool(&self.inner, value);
         return internal.enumToError(err);
@@ -73,6 +135,87 @@ pub const Serialize = struct {
         return internal.enumToError(err);
     }
 
+    pub fn record(self: *Serialize) !void {
+        const err = lib.con_serialize_record(&self.inner);
+        return internal.enumToError(err);
+    }
+
+    // Serializes `value` with code generated for `T` at compile time. Structs
+    // become dictionaries keyed by field name, arrays and slices become arrays
+    // except `[]const u8` which becomes a string, enums become the string of
+    // their tag name and null optionals become null.
+    pub fn serializeValue(self: *Serialize, comptime T: type, value: T) !void {
+        switch (@typeInfo(T)) {
+            .Bool => return self.bool(value),
+            .Int => |info| {
+                if (info.bits > 64) {
+                    @compileError("integers wider than 64 bits are not supported: " ++ @typeName(T));
+                }
+                if (info.signedness == .signed) {
+                    return self.int(value);
+                } else {
+                    return self.uint(value);
+                }
+            },
+            .Float => |info| {
+                if (info.bits < 64) {
+                    return self.floatNarrow(value);
+                }
+                const wide: f64 = if (info.bits == 64) value else @floatCast(value);
+                return self.float(wide);
+            },
+            .Enum => return self.stringEscape(@tagName(value)),
+            .Optional => |info| {
+                if (value) |child| {
+                    return self.serializeValue(info.child, child);
+                }
+                return self.null();
+            },
+            .Array => |info| return self.serializeItems(info.child, &value),
+            .Pointer => |info| {
+                if (info.size != .Slice) {
+                    @compileError("only slices are supported: " ++ @typeName(T));
+                }
+                if (info.child == u8) {
+                    return self.stringEscape(value);
+                }
+                return self.serializeItems(info.child, value);
+            },
+            .Struct => |info| {
+                try self.dictOpen();
+                inline for (info.fields) |field| {
+                    try self.dictKeyEscape(field.name);
+                    try self.serializeValue(field.type, @field(value, field.name));
+                }
+                return self.dictClose();
+            },
+            else => @compileError("type is not supported: " ++ @typeName(T)),
+        }
+    }
+
+    // Floats narrower than a double are formatted at their own type, widening
+    // them first would write e.g. `0.1` as `0.10000000149011612`. Laid out
+    // like `con_serialize_double`.
+    fn floatNarrow(self: *Serialize, value: anytype) !void {
+        if (!std.math.isFinite(value)) {
+            return self.float(value);
+        }
+
+        const magnitude: f64 = @abs(value);
+        const plain = magnitude == 0 or (magnitude >= 1e-6 and magnitude < 1e21);
+        var buffer: [64]u8 = undefined;
+        const num = std.fmt.formatFloat(&buffer, value, .{ .mode = if (plain) .decimal else .scientific }) catch unreachable;
+        return self.number(num);
+    }
+
+    fn serializeItems(self: *Serialize, comptime T: type, items: []const T) !void {
+        try self.arrayOpen();
+        for (items) |item| {
+            try self.serializeValue(T, item);
+        }
+        return self.arrayClose();
+    }
+
     pub fn checkNumber(num: []const u8) !usize {
         var first_error: usize = undefined;
         const err = lib.con_serialize_check_number(num.ptr, num.len, &first_error);
@@ -128,6 +271,17 @@ test "context init depth buffer overflow" {
     try testing.expectError(error.Overflow, err);
 }
 
+test "context init buffer" {
+    var buffer: [0]u8 = undefined;
+    var fifo = Fifo.init(&buffer);
+    var writer = ConFifo.init(&fifo.writer());
+
+    var depth: [1]zcon.Container = undefined;
+    var write_buffer: [4]u8 = undefined;
+    const context = try Serialize.initBuffer(writer.interface(), &depth, &write_buffer);
+    defer context.deinit();
+}
+
 // Section: Values -------------------------------------------------------------
 
 test "number int-like" {
@@ -1456,6 +1610,17 @@ test "number check invalid" {
     try testing.expect(data3.len == pos3);
 }
 
+test "number check long" {
+    const data1 = "-12345678901234567890123456789012345678901234567890.5e+1234567890123456789012345678901234567890";
+    const err1 = Serialize.checkNumber(data1);
+    try testing.expectError(error.Ok, err1);
+
+    const data2 = "12345678901234567890123456789012345678901234567890.123456789012345678901234567890123456789x";
+    const pos2 = try Serialize.checkNumber(data2);
+    try testing.expectEqual(90, pos2);
+    try testing.expectEqual('x', data2[pos2]);
+}
+
 test "string check" {
     const data = "a string";
     const err = Serialize.checkString(data);
@@ -1489,6 +1654,22 @@ test "string check control code" {
     try testing.expectEqual('\t', data5[pos5]);
 }
 
+test "string check long" {
+    const data1 = "0123456789abcdef0123456789abcdef0123456789abcdef\\n0123456789abcdef\x0b\x01";
+    const err1 = Serialize.checkString(data1);
+    try testing.expectError(error.Ok, err1);
+
+    const data2 = "0123456789abcdef0123456789abcdef0123456789abcdef\\u0041\x0b0123456789abcdef\t";
+    const pos2 = try Serialize.checkString(data2);
+    try testing.expectEqual(71, pos2);
+    try testing.expectEqual('\t', data2[pos2]);
+
+    const data3 = "0123456789abcdef0123456789abcdef0123456789abcd\"";
+    const pos3 = try Serialize.checkString(data3);
+    try testing.expectEqual(46, pos3);
+    try testing.expectEqual('"', data3[pos3]);
+}
+
 test "string check unescaped quote" {
     const data = "quote: \"";
     const pos = try Serialize.checkString(data);
@@ -1530,6 +1711,453 @@ test "string check invalid escape" {
     try testing.expectEqual(',', data5[pos5]);
 }
 
+// Section: Write buffer -------------------------------------------------------
+
+test "write buffer flush" {
+    var depth: [1]zcon.Container = undefined;
+    var buffer: [13]u8 = undefined;
+    var fifo = Fifo.init(&buffer);
+    var writer = ConFifo.init(&fifo.writer());
+    var write_buffer: [16]u8 = undefined;
+    var context = try Serialize.initBuffer(writer.interface(), &depth, &write_buffer);
+    defer context.deinit();
+
+    try context.arrayOpen();
+    try context.string("a");
+    try context.number("12");
+    try context.null();
+    try context.arrayClose();
+    try testing.expectEqual(0, fifo.readableLength());
+
+    try context.flush();
+    try testing.expectEqualStrings("[\"a\",12,null]", &buffer);
+}
+
+test "write buffer full" {
+    var depth: [1]zcon.Container = undefined;
+    var buffer: [13]u8 = undefined;
+    var fifo = Fifo.init(&buffer);
+    var writer = ConFifo.init(&fifo.writer());
+    var write_buffer: [4]u8 = undefined;
+    var context = try Serialize.initBuffer(writer.interface(), &depth, &write_buffer);
+    defer context.deinit();
+
+    try context.arrayOpen();
+    try context.string("a");
+    try context.number("12");
+    try testing.expectEqual(4, fifo.readableLength());
+
+    try context.null();
+    try context.arrayClose();
+    try context.flush();
+    try testing.expectEqualStrings("[\"a\",12,null]", &buffer);
+}
+
+test "write buffer large item" {
+    var depth: [0]zcon.Container = undefined;
+    var buffer: [8]u8 = undefined;
+    var fifo = Fifo.init(&buffer);
+    var writer = ConFifo.init(&fifo.writer());
+    var write_buffer: [2]u8 = undefined;
+    var context = try Serialize.initBuffer(writer.interface(), &depth, &write_buffer);
+    defer context.deinit();
+
+    try context.string("abcdef");
+    try context.flush();
+    try testing.expectEqualStrings("\"abcdef\"", &buffer);
+}
+
+test "write buffer writer fail" {
+    var depth: [1]zcon.Container = undefined;
+    var buffer: [2]u8 = undefined;
+    var fifo = Fifo.init(&buffer);
+    var writer = ConFifo.init(&fifo.writer());
+    var write_buffer: [8]u8 = undefined;
+    var context = try Serialize.initBuffer(writer.interface(), &depth, &write_buffer);
+    defer context.deinit();
+
+    try context.arrayOpen();
+    try context.null();
+
+    const err = context.flush();
+    try testing.expectError(error.Writer, err);
+}
+
+// Section: Escaping ------------------------------------------------------------
+
+test "string escape" {
+    var depth: [0]zcon.Container = undefined;
+    var buffer: [32]u8 = undefined;
+    var fifo = Fifo.init(&buffer);
+    var writer = ConFifo.init(&fifo.writer());
+    var context = try Serialize.init(writer.interface(), &depth);
+    defer context.deinit();
+
+    try context.stringEscape("\"\\\x08\x0c\n\r\t\x01\x1f/\x7f\u{e9}");
+    try testing.expectEqualStrings("\"\\\"\\\\\\b\\f\\n\\r\\t\\u0001\\u001f/\x7f\u{e9}\"", &buffer);
+}
+
+test "string escape long" {
+    const data = "0123456789abcdef0123456789abcdef0123456789abcdef\n0123456789";
+
+    var depth: [0]zcon.Container = undefined;
+    var buffer: [data.len + 3]u8 = undefined;
+    var fifo = Fifo.init(&buffer);
+    var writer = ConFifo.init(&fifo.writer());
+    var context = try Serialize.init(writer.interface(), &depth);
+    defer context.deinit();
+
+    try context.stringEscape(data);
+    try testing.expectEqualStrings("\"" ++ data[0..48] ++ "\\n" ++ data[49..] ++ "\"", &buffer);
+}
+
+test "string escape empty" {
+    var depth: [0]zcon.Container = undefined;
+    var buffer: [2]u8 = undefined;
+    var fifo = Fifo.init(&buffer);
+    var writer = ConFifo.init(&fifo.writer());
+    var context = try Serialize.init(writer.interface(), &depth);
+    defer context.deinit();
+
+    try context.stringEscape("");
+    try testing.expectEqualStrings("\"\"", &buffer);
+}
+
+test "string escape writer fail" {
+    var depth: [0]zcon.Container = undefined;
+    var buffer: [2]u8 = undefined;
+    var fifo = Fifo.init(&buffer);
+    var writer = ConFifo.init(&fifo.writer());
+    var context = try Serialize.init(writer.interface(), &depth);
+    defer context.deinit();
+
+    const err = context.stringEscape("a\n");
+    try testing.expectError(error.Writer, err);
+    try testing.expectEqualStrings("\"a", &buffer);
+}
+
+test "dict key escape" {
+    var depth: [1]zcon.Container = undefined;
+    var buffer: [13]u8 = undefined;
+    var fifo = Fifo.init(&buffer);
+    var writer = ConFifo.init(&fifo.writer());
+    var context = try Serialize.init(writer.interface(), &depth);
+    defer context.deinit();
+
+    try context.dictOpen();
+    try context.dictKeyEscape("a\"b");
+    try context.@"null"();
+    try context.dictClose();
+    try testing.expectEqualStrings("{\"a\\\"b\":null}", &buffer);
+}
+
+test "dict key escape outside dict" {
+    var depth: [0]zcon.Container = undefined;
+    var buffer: [0]u8 = undefined;
+    var fifo = Fifo.init(&buffer);
+    var writer = ConFifo.init(&fifo.writer());
+    var context = try Serialize.init(writer.interface(), &depth);
+    defer context.deinit();
+
+    const err = context.dictKeyEscape("\n");
+    try testing.expectError(error.NotDict, err);
+}
+
+// Section: Number formatting --------------------------------------------------
+
+test "int" {
+    var depth: [1]zcon.Container = undefined;
+    var buffer: [44]u8 = undefined;
+    var fifo = Fifo.init(&buffer);
+    var writer = ConFifo.init(&fifo.writer());
+    var context = try Serialize.init(writer.interface(), &depth);
+    defer context.deinit();
+
+    try context.arrayOpen();
+    try context.int(std.math.minInt(i64));
+    try context.int(0);
+    try context.int(std.math.maxInt(i64));
+    try context.arrayClose();
+    try testing.expectEqualStrings("[-9223372036854775808,0,9223372036854775807]", &buffer);
+}
+
+test "uint" {
+    var depth: [0]zcon.Container = undefined;
+    var buffer: [20]u8 = undefined;
+    var fifo = Fifo.init(&buffer);
+    var writer = ConFifo.init(&fifo.writer());
+    var context = try Serialize.init(writer.interface(), &depth);
+    defer context.deinit();
+
+    try context.uint(std.math.maxInt(u64));
+    try testing.expectEqualStrings("18446744073709551615", &buffer);
+}
+
+test "float" {
+    var depth: [1]zcon.Container = undefined;
+    var buffer: [53]u8 = undefined;
+    var fifo = Fifo.init(&buffer);
+    var writer = ConFifo.init(&fifo.writer());
+    var context = try Serialize.init(writer.interface(), &depth);
+    defer context.deinit();
+
+    try context.arrayOpen();
+    try context.float(0.1);
+    try context.float(-2.5e-7);
+    try context.float(1e21);
+    try context.float(1e22);
+    try context.float(-0.0);
+    try context.float(5e-324);
+    try context.float(0.1 + 0.2);
+    try context.arrayClose();
+    try testing.expectEqualStrings("[0.1,-2.5e-7,1e21,1e22,-0,5e-324,0.30000000000000004]", &buffer);
+}
+
+test "float not finite" {
+    var depth: [0]zcon.Container = undefined;
+    var buffer: [0]u8 = undefined;
+    var fifo = Fifo.init(&buffer);
+    var writer = ConFifo.init(&fifo.writer());
+    var context = try Serialize.init(writer.interface(), &depth);
+    defer context.deinit();
+
+    const err1 = context.float(std.math.inf(f64));
+    try testing.expectError(error.NotNumber, err1);
+
+    const err2 = context.float(std.math.nan(f64));
+    try testing.expectError(error.NotNumber, err2);
+}
+
+test "float writer fail" {
+    var depth: [0]zcon.Container = undefined;
+    var buffer: [2]u8 = undefined;
+    var fifo = Fifo.init(&buffer);
+    var writer = ConFifo.init(&fifo.writer());
+    var context = try Serialize.init(writer.interface(), &depth);
+    defer context.deinit();
+
+    const err = context.float(1.5);
+    try testing.expectError(error.Writer, err);
+}
+
+// Section: Reflection ---------------------------------------------------------
+
+test "serialize value struct" {
+    const Kind = enum { small, large };
+    const Item = struct {
+        id: u32,
+        name: []const u8,
+        kind: Kind,
+        score: f64,
+        parent: ?i16,
+        tags: []const []const u8,
+        pair: [2]bool,
+    };
+
+    const item = Item{
+        .id = 7,
+        .name = "a\"b",
+        .kind = .large,
+        .score = 1.5,
+        .parent = null,
+        .tags = &.{ "x", "y" },
+        .pair = .{ true, false },
+    };
+    const expected = "{\"id\":7,\"name\":\"a\\\"b\",\"kind\":\"large\",\"score\":1.5,\"parent\":null,\"tags\":[\"x\",\"y\"],\"pair\":[true,false]}";
+
+    var depth: [2]zcon.Container = undefined;
+    var buffer: [expected.len]u8 = undefined;
+    var fifo = Fifo.init(&buffer);
+    var writer = ConFifo.init(&fifo.writer());
+    var context = try Serialize.init(writer.interface(), &depth);
+    defer context.deinit();
+
+    try context.serializeValue(Item, item);
+    try testing.expectEqualStrings(expected, &buffer);
+}
+
+test "serialize value numbers" {
+    const values = [_]?i8{ -3, null, 5 };
+    const ratio: f32 = 0.25;
+    const expected = "[[-3,null,5],0.25,18446744073709551615]";
+
+    var depth: [2]zcon.Container = undefined;
+    var buffer: [expected.len]u8 = undefined;
+    var fifo = Fifo.init(&buffer);
+    var writer = ConFifo.init(&fifo.writer());
+    var context = try Serialize.init(writer.interface(), &depth);
+    defer context.deinit();
+
+    try context.arrayOpen();
+    try context.serializeValue([3]?i8, values);
+    try context.serializeValue(f32, ratio);
+    try context.serializeValue(u64, std.math.maxInt(u64));
+    try context.arrayClose();
+    try testing.expectEqualStrings(expected, &buffer);
+}
+
+test "serialize value f32" {
+    const Sample = struct { ratio: f32, scale: f32 };
+    const expected = "{\"ratio\":0.1,\"scale\":-16777216}";
+
+    var depth: [1]zcon.Container = undefined;
+    var buffer: [expected.len]u8 = undefined;
+    var fifo = Fifo.init(&buffer);
+    var writer = ConFifo.init(&fifo.writer());
+    var context = try Serialize.init(writer.interface(), &depth);
+    defer context.deinit();
+
+    try context.serializeValue(Sample, .{ .ratio = 0.1, .scale = -16777216 });
+    try testing.expectEqualStrings(expected, &buffer);
+}
+
+test "serialize value writer fail" {
+    const Point = struct { x: i32, y: i32 };
+
+    var depth: [1]zcon.Container = undefined;
+    var buffer: [8]u8 = undefined;
+    var fifo = Fifo.init(&buffer);
+    var writer = ConFifo.init(&fifo.writer());
+    var context = try Serialize.init(writer.interface(), &depth);
+    defer context.deinit();
+
+    const err = context.serializeValue(Point, .{ .x = 1, .y = 2 });
+    try testing.expectError(error.Writer, err);
+}
+
+// Section: Record -------------------------------------------------------------
+
+test "record" {
+    const expected = "{\"a\":1}\n2\n[null]\n";
+
+    var depth: [1]zcon.Container = undefined;
+    var buffer: [expected.len]u8 = undefined;
+    var fifo = Fifo.init(&buffer);
+    var writer = ConFifo.init(&fifo.writer());
+    var context = try Serialize.init(writer.interface(), &depth);
+    defer context.deinit();
+
+    try context.dictOpen();
+    try context.dictKey("a");
+    try context.int(1);
+    try context.dictClose();
+    try context.record();
+
+    try context.int(2);
+    try context.record();
+
+    try context.arrayOpen();
+    try context.@"null"();
+    try context.arrayClose();
+    try context.record();
+
+    try testing.expectEqualStrings(expected, &buffer);
+}
+
+test "record incomplete" {
+    var depth: [1]zcon.Container = undefined;
+    var buffer: [1]u8 = undefined;
+    var fifo = Fifo.init(&buffer);
+    var writer = ConFifo.init(&fifo.writer());
+    var context = try Serialize.init(writer.interface(), &depth);
+    defer context.deinit();
+
+    const err1 = context.record();
+    try testing.expectError(error.Incomplete, err1);
+
+    try context.arrayOpen();
+    const err2 = context.record();
+    try testing.expectError(error.Incomplete, err2);
+}
+
+// Section: Depth stack --------------------------------------------------------
+
+test "depth allocator" {
+    const levels = 100;
+    const expected = "[{\"a\":" ** levels ++ "null" ++ "}]" ** levels;
+
+    var depth: [1]zcon.Container = undefined;
+    var buffer: [expected.len]u8 = undefined;
+    var fifo = Fifo.init(&buffer);
+    var writer = ConFifo.init(&fifo.writer());
+    var context = try Serialize.init(writer.interface(), &depth);
+    try context.depthAllocator(testing.allocator);
+    defer context.deinit();
+
+    for (0..levels) |_| {
+        try context.arrayOpen();
+        try context.dictOpen();
+        try context.dictKey("a");
+    }
+    try context.@"null"();
+    for (0..levels) |_| {
+        try context.dictClose();
+        try context.arrayClose();
+    }
+
+    try testing.expectEqualStrings(expected, &buffer);
+}
+
+test "depth allocator fail" {
+    var depth: [1]zcon.Container = undefined;
+    var buffer: [64]u8 = undefined;
+    var fifo = Fifo.init(&buffer);
+    var writer = ConFifo.init(&fifo.writer());
+    var context = try Serialize.init(writer.interface(), &depth);
+    try context.depthAllocator(testing.failing_allocator);
+    defer context.deinit();
+
+    // The initial buffer holds a bit per level before anything is allocated.
+    for (0..@bitSizeOf(zcon.Container)) |_| {
+        try context.arrayOpen();
+    }
+
+    const err = context.arrayOpen();
+    try testing.expectError(error.TooDeep, err);
+}
+
+// Section: Resume -------------------------------------------------------------
+
+test "resume after writer fail" {
+    const expected = "{\"key\":[\"value\",12,true]}";
+
+    var depth: [2]zcon.Container = undefined;
+    var buffer: [6]u8 = undefined;
+    var fifo = Fifo.init(&buffer);
+    var writer = ConFifo.init(&fifo.writer());
+    var context = try Serialize.init(writer.interface(), &depth);
+    defer context.deinit();
+
+    // The output never holds more than `buffer`, a failed call is repeated
+    // with the same arguments once the reader made room.
+    var out: [expected.len]u8 = undefined;
+    var length: usize = 0;
+    for (0..8) |step| {
+        while (true) {
+            const result: anyerror!void = switch (step) {
+                0 => context.dictOpen(),
+                1 => context.dictKey("key"),
+                2 => context.arrayOpen(),
+                3 => context.string("value"),
+                4 => context.int(12),
+                5 => context.bool(true),
+                6 => context.arrayClose(),
+                else => context.dictClose(),
+            };
+
+            if (result) |_| {
+                break;
+            } else |err| {
+                try testing.expectEqual(error.Writer, err);
+            }
+            length += fifo.read(out[length..]);
+        }
+    }
+    length += fifo.read(out[length..]);
+
+    try testing.expectEqualStrings(expected, out[0..length]);
+}
+
 // Section: Integration test ---------------------------------------------------
 
 test "nested structures" {
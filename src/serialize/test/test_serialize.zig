@@ -1,5 +1,7 @@
-const testing = @import("std").testing;
-const lib = @import("../../internal.zig").lib;
+const std = @import("std");
+const testing = std.testing;
+const internal = @import("../../internal.zig");
+const lib = internal.lib;
 
 test "context init" {
     var writer: lib.GciWriterString = undefined;
@@ -63,6 +65,85 @@ test "context depth negative" {
     try testing.expectEqual(@as(c_uint, lib.CON_ERROR_BUFFER), init_err);
 }
 
+test "context init buffer" {
+    var writer: lib.GciWriterString = undefined;
+    var depth: [0]lib.ConContainer = undefined;
+    var write_buffer: [4]u8 = undefined;
+    var context: lib.ConSerialize = undefined;
+    const init_err = lib.con_serialize_init_buffer(
+        &context,
+        lib.gci_writer_string_interface(&writer),
+        &depth,
+        0,
+        &write_buffer,
+        write_buffer.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+}
+
+test "context write buffer null, length positive" {
+    var writer: lib.GciWriterString = undefined;
+    var depth: [0]lib.ConContainer = undefined;
+    var context: lib.ConSerialize = undefined;
+    const init_err = lib.con_serialize_init_buffer(
+        &context,
+        lib.gci_writer_string_interface(&writer),
+        &depth,
+        0,
+        null,
+        1,
+    );
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), init_err);
+}
+
+test "context write buffer null, length zero" {
+    var writer: lib.GciWriterString = undefined;
+    var depth: [0]lib.ConContainer = undefined;
+    var context: lib.ConSerialize = undefined;
+    const init_err = lib.con_serialize_init_buffer(
+        &context,
+        lib.gci_writer_string_interface(&writer),
+        &depth,
+        0,
+        null,
+        0,
+    );
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+}
+
+test "context depth allocator" {
+    var writer: lib.GciWriterString = undefined;
+    var depth: [1]lib.ConContainer = undefined;
+    var context: lib.ConSerialize = undefined;
+    const init_err = lib.con_serialize_init(&context, lib.gci_writer_string_interface(&writer), &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+    try testing.expectEqual(1, context.depth_stack.size);
+
+    const allocator_err = lib.con_serialize_depth_allocator(&context, internal.allocatorInterface(&testing.allocator));
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), allocator_err);
+    try testing.expectEqual(@bitSizeOf(lib.ConContainer), context.depth_stack.size);
+
+    const deinit_err = lib.con_serialize_deinit(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), deinit_err);
+}
+
+test "context depth allocator null" {
+    var writer: lib.GciWriterString = undefined;
+    var depth: [1]lib.ConContainer = undefined;
+    var context: lib.ConSerialize = undefined;
+    _ = lib.con_serialize_init(&context, lib.gci_writer_string_interface(&writer), &depth, depth.len);
+
+    const allocator = internal.allocatorInterface(&testing.allocator);
+    const err1 = lib.con_serialize_depth_allocator(null, allocator);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err1);
+
+    const err2 = lib.con_serialize_depth_allocator(&context, .{ .context = null, .resize = null });
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err2);
+
+    const err3 = lib.con_serialize_deinit(null);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err3);
+}
+
 // Section: Values -------------------------------------------------------------
 
 test "number int-like" {
@@ -395,6 +476,38 @@ test "string second quote writer fail" {
     try testing.expectEqualStrings("\"-", &buffer);
 }
 
+test "string resume after writer fail" {
+    var buffer1: [1]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    const writer_err = lib.gci_writer_string_init(&writer, &buffer1, buffer1.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), writer_err);
+
+    var depth: [0]lib.ConContainer = undefined;
+    var context: lib.ConSerialize = undefined;
+    const init_err = lib.con_serialize_init(
+        &context,
+        lib.gci_writer_string_interface(&writer),
+        &depth,
+        depth.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const str1_err = lib.con_serialize_string(&context, "abcd", 4);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_WRITER), str1_err);
+    try testing.expectEqualStrings("\"", &buffer1);
+    try testing.expectEqual(1, context.token_written);
+    try testing.expectEqual(@as(c_uint, lib.CON_STATE_EMPTY), context.state);
+
+    var buffer2: [5]u8 = undefined;
+    _ = lib.gci_writer_string_init(&writer, &buffer2, buffer2.len);
+
+    const str2_err = lib.con_serialize_string(&context, "abcd", 4);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), str2_err);
+    try testing.expectEqualStrings("abcd\"", &buffer2);
+    try testing.expectEqual(0, context.token_written);
+    try testing.expectEqual(@as(c_uint, lib.CON_STATE_COMPLETE), context.state);
+}
+
 test "bool true" {
     var buffer: [4]u8 = undefined;
     var writer: lib.GciWriterString = undefined;
@@ -521,6 +634,188 @@ test "null writer fail" {
     try testing.expectEqual(@as(c_uint, lib.CON_ERROR_WRITER), null_err);
 }
 
+test "int64" {
+    var buffer: [20]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    const writer_err = lib.gci_writer_string_init(&writer, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), writer_err);
+
+    var depth: [0]lib.ConContainer = undefined;
+    var context: lib.ConSerialize = undefined;
+    const init_err = lib.con_serialize_init(
+        &context,
+        lib.gci_writer_string_interface(&writer),
+        &depth,
+        depth.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const num_err = lib.con_serialize_int64(&context, std.math.minInt(i64));
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), num_err);
+    try testing.expectEqualStrings("-9223372036854775808", &buffer);
+}
+
+test "uint64" {
+    var buffer: [20]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    const writer_err = lib.gci_writer_string_init(&writer, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), writer_err);
+
+    var depth: [0]lib.ConContainer = undefined;
+    var context: lib.ConSerialize = undefined;
+    const init_err = lib.con_serialize_init(
+        &context,
+        lib.gci_writer_string_interface(&writer),
+        &depth,
+        depth.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const num_err = lib.con_serialize_uint64(&context, std.math.maxInt(u64));
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), num_err);
+    try testing.expectEqualStrings("18446744073709551615", &buffer);
+}
+
+test "double" {
+    var buffer: [23]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    const writer_err = lib.gci_writer_string_init(&writer, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), writer_err);
+
+    var depth: [0]lib.ConContainer = undefined;
+    var context: lib.ConSerialize = undefined;
+    const init_err = lib.con_serialize_init(
+        &context,
+        lib.gci_writer_string_interface(&writer),
+        &depth,
+        depth.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const num_err = lib.con_serialize_double(&context, -1.7976931348623157e308);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), num_err);
+    try testing.expectEqualStrings("-1.7976931348623157e308", &buffer);
+}
+
+test "double shortest" {
+    // Grisu2 wrote a 17th digit for each of these.
+    const Case = struct { value: f64, expected: []const u8 };
+    const cases = [_]Case{
+        .{ .value = 2.7183163742986588e276, .expected = "2.718316374298659e276" },
+        .{ .value = 30892612233637952, .expected = "30892612233637950" },
+        .{ .value = 5.2702834168800707e-247, .expected = "5.270283416880071e-247" },
+        .{ .value = 4.1486621970919508e34, .expected = "4.148662197091951e34" },
+    };
+
+    for (cases) |case| {
+        var buffer: [32]u8 = undefined;
+        var writer: lib.GciWriterString = undefined;
+        _ = lib.gci_writer_string_init(&writer, &buffer, buffer.len);
+
+        var depth: [0]lib.ConContainer = undefined;
+        var context: lib.ConSerialize = undefined;
+        _ = lib.con_serialize_init(&context, lib.gci_writer_string_interface(&writer), &depth, depth.len);
+
+        const num_err = lib.con_serialize_double(&context, case.value);
+        try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), num_err);
+        try testing.expectEqualStrings(case.expected, buffer[0..writer.current]);
+    }
+}
+
+test "double not finite" {
+    var buffer: [0]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    const writer_err = lib.gci_writer_string_init(&writer, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), writer_err);
+
+    var depth: [0]lib.ConContainer = undefined;
+    var context: lib.ConSerialize = undefined;
+    const init_err = lib.con_serialize_init(
+        &context,
+        lib.gci_writer_string_interface(&writer),
+        &depth,
+        depth.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const num_err = lib.con_serialize_double(&context, -std.math.inf(f64));
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NOT_NUMBER), num_err);
+
+    const null_err = lib.con_serialize_null(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_WRITER), null_err);
+}
+
+test "string escape" {
+    var buffer: [16]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    const writer_err = lib.gci_writer_string_init(&writer, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), writer_err);
+
+    var depth: [0]lib.ConContainer = undefined;
+    var context: lib.ConSerialize = undefined;
+    const init_err = lib.con_serialize_init(
+        &context,
+        lib.gci_writer_string_interface(&writer),
+        &depth,
+        depth.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const str_err = lib.con_serialize_string_escape(&context, "a\"b\tc\x00d", 8);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), str_err);
+    try testing.expectEqualStrings("\"a\\\"b\\tc\\u0000d\"", &buffer);
+}
+
+test "string escape null" {
+    var buffer: [0]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    const writer_err = lib.gci_writer_string_init(&writer, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), writer_err);
+
+    var depth: [0]lib.ConContainer = undefined;
+    var context: lib.ConSerialize = undefined;
+    const init_err = lib.con_serialize_init(
+        &context,
+        lib.gci_writer_string_interface(&writer),
+        &depth,
+        depth.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const str_err = lib.con_serialize_string_escape(&context, null, 0);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), str_err);
+}
+
+test "dict key escape" {
+    var buffer: [8]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    const writer_err = lib.gci_writer_string_init(&writer, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), writer_err);
+
+    var depth: [1]lib.ConContainer = undefined;
+    var context: lib.ConSerialize = undefined;
+    const init_err = lib.con_serialize_init(
+        &context,
+        lib.gci_writer_string_interface(&writer),
+        &depth,
+        depth.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const open_err = lib.con_serialize_dict_open(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), open_err);
+
+    const key_err = lib.con_serialize_dict_key_escape(&context, "\n", 1);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), key_err);
+
+    const num_err = lib.con_serialize_int64(&context, 1);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), num_err);
+
+    const close_err = lib.con_serialize_dict_close(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), close_err);
+    try testing.expectEqualStrings("{\"\\n\":1}", &buffer);
+}
+
 // Section: Containers ---------------------------------------------------------
 
 test "array open" {
@@ -2490,6 +2785,139 @@ test "string check invalid escape" {
     try testing.expectEqual(',', data5[pos5]);
 }
 
+// Section: Write buffer -------------------------------------------------------
+
+test "write buffer flush" {
+    var buffer: [10]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    const writer_err = lib.gci_writer_string_init(&writer, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), writer_err);
+
+    var depth: [1]lib.ConContainer = undefined;
+    var write_buffer: [16]u8 = undefined;
+    var context: lib.ConSerialize = undefined;
+    const init_err = lib.con_serialize_init_buffer(
+        &context,
+        lib.gci_writer_string_interface(&writer),
+        &depth,
+        depth.len,
+        &write_buffer,
+        write_buffer.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const open_err = lib.con_serialize_dict_open(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), open_err);
+
+    const key_err = lib.con_serialize_dict_key(&context, "k", 1);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), key_err);
+
+    const bool_err = lib.con_serialize_bool(&context, true);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), bool_err);
+
+    const close_err = lib.con_serialize_dict_close(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), close_err);
+    try testing.expectEqual(0, writer.current);
+
+    const flush_err = lib.con_serialize_flush(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), flush_err);
+    try testing.expectEqualStrings("{\"k\":true}", &buffer);
+}
+
+test "write buffer flush writer fail" {
+    var buffer: [3]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    const writer_err = lib.gci_writer_string_init(&writer, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), writer_err);
+
+    var depth: [0]lib.ConContainer = undefined;
+    var write_buffer: [16]u8 = undefined;
+    var context: lib.ConSerialize = undefined;
+    const init_err = lib.con_serialize_init_buffer(
+        &context,
+        lib.gci_writer_string_interface(&writer),
+        &depth,
+        depth.len,
+        &write_buffer,
+        write_buffer.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const null_err = lib.con_serialize_null(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), null_err);
+
+    const flush_err = lib.con_serialize_flush(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_WRITER), flush_err);
+    try testing.expectEqual(1, context.write_buffer_length);
+    try testing.expectEqualStrings("nul", &buffer);
+}
+
+test "write buffer full writer fail" {
+    var buffer: [1]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    const writer_err = lib.gci_writer_string_init(&writer, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), writer_err);
+
+    var depth: [1]lib.ConContainer = undefined;
+    var write_buffer: [4]u8 = undefined;
+    var context: lib.ConSerialize = undefined;
+    const init_err = lib.con_serialize_init_buffer(
+        &context,
+        lib.gci_writer_string_interface(&writer),
+        &depth,
+        depth.len,
+        &write_buffer,
+        write_buffer.len,
+    );
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const open_err = lib.con_serialize_array_open(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), open_err);
+
+    const null_err = lib.con_serialize_null(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_WRITER), null_err);
+}
+
+// Section: Record -------------------------------------------------------------
+
+test "record" {
+    var buffer: [6]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    const writer_err = lib.gci_writer_string_init(&writer, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), writer_err);
+
+    var depth: [1]lib.ConContainer = undefined;
+    var context: lib.ConSerialize = undefined;
+    const init_err = lib.con_serialize_init(&context, lib.gci_writer_string_interface(&writer), &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const empty_err = lib.con_serialize_record(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_INCOMPLETE), empty_err);
+
+    const open_err = lib.con_serialize_array_open(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), open_err);
+
+    const incomplete_err = lib.con_serialize_record(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_INCOMPLETE), incomplete_err);
+
+    const close_err = lib.con_serialize_array_close(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), close_err);
+
+    const record1_err = lib.con_serialize_record(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), record1_err);
+
+    const complete_err = lib.con_serialize_record(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_INCOMPLETE), complete_err);
+
+    const bool_err = lib.con_serialize_bool(&context, true);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), bool_err);
+
+    const record2_err = lib.con_serialize_record(&context);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_WRITER), record2_err);
+
+    try testing.expectEqualStrings("[]\ntrue", &buffer);
+}
+
 // Section: Integration test ---------------------------------------------------
 
 test "nested structures" {
@@ -365,3 +365,91 @@ test "indent whitespace comma writer fail" {
     try testing.expectEqual(3, res);
     try testing.expectEqualStrings("[\n  1,\n", &b);
 }
+
+test "indent resume after writer fail" {
+    var b1: [3]u8 = undefined;
+    var c: lib.GciWriterString = undefined;
+    const i_err = lib.gci_writer_string_init(&c, &b1, b1.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), i_err);
+
+    var context: lib.ConWriterIndent = undefined;
+    const init_err = lib.con_writer_indent_init(
+        &context,
+        lib.gci_writer_string_interface(&c),
+    );
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const writer = lib.con_writer_indent_interface(&context);
+
+    const json = "[1,{\"k\":2}]";
+    const res1 = lib.gci_writer_write(writer, json, 11);
+    try testing.expectEqual(1, res1);
+    try testing.expectEqualStrings("[\n ", &b1);
+    try testing.expectEqual(2, context.pending_written);
+
+    var b2: [24]u8 = undefined;
+    _ = lib.gci_writer_string_init(&c, &b2, b2.len);
+
+    const res2 = lib.gci_writer_write(writer, json + 1, 10);
+    try testing.expectEqual(10, res2);
+    try testing.expectEqualStrings(
+        \\ 1,
+        \\  {
+        \\    "k": 2
+        \\  }
+        \\]
+    ,
+        &b2,
+    );
+}
+
+test "indent init style" {
+    var c: lib.GciWriterString = undefined;
+    var context: lib.ConWriterIndent = undefined;
+    var style = lib.con_writer_indent_style_default();
+
+    const err1 = lib.con_writer_indent_init_style(null, lib.gci_writer_string_interface(&c), style);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err1);
+
+    style.array_width = lib.CON_WRITER_INDENT_WINDOW + 1;
+    const err2 = lib.con_writer_indent_init_style(&context, lib.gci_writer_string_interface(&c), style);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_BUFFER), err2);
+
+    style.array_width = lib.CON_WRITER_INDENT_WINDOW;
+    const err3 = lib.con_writer_indent_init_style(&context, lib.gci_writer_string_interface(&c), style);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), err3);
+}
+
+test "indent style resume array after writer fail" {
+    var b1: [9]u8 = undefined;
+    var c: lib.GciWriterString = undefined;
+    const i_err = lib.gci_writer_string_init(&c, &b1, b1.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), i_err);
+
+    var style = lib.con_writer_indent_style_default();
+    style.array_width = 8;
+
+    var context: lib.ConWriterIndent = undefined;
+    const init_err = lib.con_writer_indent_init_style(
+        &context,
+        lib.gci_writer_string_interface(&c),
+        style,
+    );
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const writer = lib.con_writer_indent_interface(&context);
+
+    // The array is held back, its close is only consumed once it was written.
+    const json = "{\"a\":[1,2]}";
+    const res1 = lib.gci_writer_write(writer, json, 11);
+    try testing.expectEqual(9, res1);
+    try testing.expectEqualStrings("{\n  \"a\": ", &b1);
+    try testing.expectEqual(4, context.window_size);
+
+    var b2: [8]u8 = undefined;
+    _ = lib.gci_writer_string_init(&c, &b2, b2.len);
+
+    const res2 = lib.gci_writer_write(writer, json + 9, 2);
+    try testing.expectEqual(2, res2);
+    try testing.expectEqualStrings("[1, 2]\n}", &b2);
+}
@@ -1,18 +1,76 @@
+#include <assert.h>
+#include <ctype.h>
 #include <stdint.h>
 #include <utils.h>
 #include "con_writer.h"
 
 size_t con_writer_indent_write(void const *void_context, char const *data, size_t data_size);
+static inline size_t con_writer_indent_format(struct ConWriterIndent *context, char const *data, size_t data_size);
+static inline size_t con_writer_indent_scan(
+    struct ConStateChar *state,
+    size_t *depth,
+    enum ConWriterIndentPending *pending,
+    bool line,
+    char const *data,
+    size_t data_size
+);
+static inline size_t con_writer_indent_collect(struct ConWriterIndent *context, char const *data, size_t data_size);
+static inline bool con_writer_indent_replay(struct ConWriterIndent *context);
+static inline bool con_writer_indent_whitespace(struct ConWriterIndent *context, size_t depth);
+
+// A new line followed by `CON_WRITER_INDENT_CHUNK` characters of indentation,
+// whitespace of any size is written from these in as few writes as possible.
+#define CON_WRITER_INDENT_CHUNK 64
+static char const con_writer_indent_spaces[1 + CON_WRITER_INDENT_CHUNK] =
+    "\n                                                                ";
+static char const con_writer_indent_tabs[1 + CON_WRITER_INDENT_CHUNK] =
+    "\n\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t"
+    "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t";
+
+struct ConWriterIndentStyle con_writer_indent_style_default(void) {
+    return (struct ConWriterIndentStyle) {
+        .indent_width = 2,
+        .tabs = false,
+        .array_width = 0,
+        .key_width = 0,
+    };
+}
+
+struct ConWriterIndentStyle con_writer_indent_style_compact(void) {
+    return (struct ConWriterIndentStyle) {
+        .indent_width = 1,
+        .tabs = true,
+        .array_width = CON_WRITER_INDENT_WINDOW,
+        .key_width = 0,
+    };
+}
 
 enum ConError con_writer_indent_init(
     struct ConWriterIndent *context,
     struct GciInterfaceWriter writer
+) {
+    return con_writer_indent_init_style(context, writer, con_writer_indent_style_default());
+}
+
+enum ConError con_writer_indent_init_style(
+    struct ConWriterIndent *context,
+    struct GciInterfaceWriter writer,
+    struct ConWriterIndentStyle style
 ) {
     if (context == NULL) { return CON_ERROR_NULL; }
+    if (style.array_width > CON_WRITER_INDENT_WINDOW) { return CON_ERROR_BUFFER; }
 
     context->writer = writer;
+    context->style = style;
     context->state = con_utils_state_char_init();
     context->depth = 0;
+    context->pending = CON_WRITER_INDENT_PENDING_NONE;
+    context->pending_written = 0;
+    context->key_size = 0;
+    context->window_size = 0;
+    context->window_offset = 0;
+    context->window_state = CON_WRITER_INDENT_WINDOW_NONE;
+    context->window_char = con_utils_state_char_init();
 
     return CON_ERROR_OK;
 }
@@ -21,66 +79,293 @@ struct GciInterfaceWriter con_writer_indent_interface(struct ConWriterIndent *co
     return (struct GciInterfaceWriter) { .context=context, .write=con_writer_indent_write };
 }
 
-static inline bool con_writer_indent_whitespace(struct ConWriterIndent *context) {
-    size_t result = gci_writer_write(context->writer, "\n", 1);
-    if (result != 1) { return false; }
+size_t con_writer_indent_write(void const *void_context, char const *data, size_t data_size) {
+    assert(void_context != NULL);
+    assert(data != NULL);
+
+    struct ConWriterIndent *context = (struct ConWriterIndent*) void_context;
+
+    size_t length = 0;
+    while (true) {
+        enum ConWriterIndentWindow window = context->window_state;
+        if (window == CON_WRITER_INDENT_WINDOW_LINE || window == CON_WRITER_INDENT_WINDOW_LINES) {
+            if (!con_writer_indent_replay(context)) { break; }
+        }
+        if (length >= data_size) { break; }
 
-    for (size_t i = 0; i < context->depth; i++) {
-        result = gci_writer_write(context->writer, "  ", 2);
-        if (result != 2) { return false; }
+        if (context->window_state == CON_WRITER_INDENT_WINDOW_COLLECT) {
+            length += con_writer_indent_collect(context, data + length, data_size - length);
+            continue;
+        }
+
+        length += con_writer_indent_format(context, data + length, data_size - length);
+        if (context->window_state != CON_WRITER_INDENT_WINDOW_COLLECT && length < data_size) { break; }
     }
 
-    return true;
+    return length;
 }
 
-size_t con_writer_indent_write(void const *void_context, char const *data, size_t data_size) {
-    assert(void_context != NULL);
-    assert(data != NULL);
+// Writes `data` indented and returns the amount of bytes consumed. Stops
+// early if the inner writer fails or in front of an array which is collected
+// in the window first.
+static inline size_t con_writer_indent_format(struct ConWriterIndent *context, char const *data, size_t data_size) {
+    assert(context != NULL);
+    assert(data != NULL || data_size == 0);
 
-    struct ConWriterIndent *context = (struct ConWriterIndent*) void_context;
+    bool line = context->window_state == CON_WRITER_INDENT_WINDOW_LINE;
+    bool collect = context->style.array_width > 0 && context->window_state == CON_WRITER_INDENT_WINDOW_NONE;
 
     size_t length = 0;
     while (length < data_size) {
         char c = data[length];
 
-        if (con_utils_state_char_is_container_empty(context->state) && !con_utils_state_char_is_close(context->state, c)) {
-            bool success = con_writer_indent_whitespace(context);
-            if (!success) { break; }
-        }
+        if (!context->state.in_string && context->pending != CON_WRITER_INDENT_PENDING_DONE) {
+            if (isspace((unsigned char) c)) {
+                length += 1;
+                continue;
+            }
 
-        if (con_utils_state_char_is_close(context->state, c) && context->depth > 0) {
-            context->depth -= 1;
+            if (collect && c == '[') {
+                context->window_state = CON_WRITER_INDENT_WINDOW_COLLECT;
+                context->window_char = context->state;
+                break;
+            }
 
-            if (context->state.state != CON_STATE_FIRST) {
-                bool success = con_writer_indent_whitespace(context);
-                if (!success) { break; }
+            // A container which closes right after it opened stays on one
+            // line, any other close goes on a new line one level out.
+            size_t depth = context->depth;
+            if (c == ']' || c == '}') {
+                if (line || context->state.state == CON_STATE_FIRST) {
+                    context->pending = CON_WRITER_INDENT_PENDING_NONE;
+                } else {
+                    context->pending = CON_WRITER_INDENT_PENDING_NEWLINE;
+                }
+                depth -= depth > 0;
             }
-        } else if (con_utils_state_char_is_open(context->state, c)) {
-            if (context->depth > SIZE_MAX - 1) {
-                return length;
+
+            if (!con_writer_indent_whitespace(context, depth)) { break; }
+        }
+
+        // Scans copies so that the context only moves past what was written.
+        struct ConStateChar state = context->state;
+        size_t depth = context->depth;
+        enum ConWriterIndentPending pending = context->pending;
+        size_t run = con_writer_indent_scan(&state, &depth, &pending, line, data + length, data_size - length);
+        if (run == 0) { break; }
+
+        size_t written = gci_writer_write(context->writer, data + length, run);
+        assert(written <= run);
+
+        if (written != run) {
+            size_t rescanned = con_writer_indent_scan(
+                &context->state,
+                &context->depth,
+                &context->pending,
+                line,
+                data + length,
+                written
+            );
+            assert(rescanned == written);
+            (void) rescanned;
+            context->key_size += written;
+            return length + written;
+        }
+
+        // An array on one line has no nested containers, it ends once the
+        // depth drops.
+        if (line && depth < context->depth) {
+            context->window_state = CON_WRITER_INDENT_WINDOW_NONE;
+            line = false;
+            collect = context->style.array_width > 0;
+        }
+
+        context->state = state;
+        context->depth = depth;
+        context->pending = pending;
+        context->key_size += run;
+        length += run;
+    }
+
+    return length;
+}
+
+// Moves `state`, `depth` and `pending` past the bytes at the start of `data`
+// which are written as they are, i.e. up to the first byte which needs
+// whitespace in front of it or is whitespace which is dropped. The first byte
+// always belongs to the run since its whitespace was already written. Items
+// are separated by a space instead of a new line if `line` is set. Returns the
+// amount of bytes.
+static inline size_t con_writer_indent_scan(
+    struct ConStateChar *state,
+    size_t *depth,
+    enum ConWriterIndentPending *pending,
+    bool line,
+    char const *data,
+    size_t data_size
+) {
+    assert(state != NULL);
+    assert(depth != NULL);
+    assert(pending != NULL);
+    assert(data != NULL || data_size == 0);
+
+    size_t length = 0;
+    while (length < data_size) {
+        if (state->in_string) {
+            if (!state->escaped) {
+                length += con_utils_string_span(data + length, data_size - length);
+                if (length >= data_size) { break; }
             }
 
-            context->depth += 1;
+            con_utils_state_char_next(state, data[length]);
+            *pending = CON_WRITER_INDENT_PENDING_NONE;
+            length += 1;
+            continue;
         }
 
-        if (con_utils_state_char_is_meaningful(context->state, c)) {
-            size_t result = gci_writer_write(context->writer, &c, 1);
-            if (result != 1) { break; }
+        char c = data[length];
+        if (length > 0 && (isspace((unsigned char) c) || c == ']' || c == '}')) { break; }
+        *pending = CON_WRITER_INDENT_PENDING_NONE;
+
+        if (c == '[' || c == '{') {
+            if (*depth == SIZE_MAX) { break; }
+            *depth += 1;
+            if (!line) { *pending = CON_WRITER_INDENT_PENDING_NEWLINE; }
+        } else if (c == ']' || c == '}') {
+            *depth -= *depth > 0;
+            if (line) {
+                con_utils_state_char_next(state, c);
+                length += 1;
+                break;
+            }
+        } else if (c == ',') {
+            *pending = line ? CON_WRITER_INDENT_PENDING_ITEM : CON_WRITER_INDENT_PENDING_NEWLINE;
+        } else if (c == ':') {
+            *pending = CON_WRITER_INDENT_PENDING_SPACE;
         }
+
+        con_utils_state_char_next(state, c);
         length += 1;
 
-        if (con_utils_state_char_is_key_separator(context->state, c)) {
-            size_t result = gci_writer_write(context->writer, " ", 1);
-            if (result != 1) { break; }
+        if (*pending != CON_WRITER_INDENT_PENDING_NONE) { break; }
+    }
+
+    return length;
+}
+
+// Holds back the bytes of an array at the start of `data` in the window of
+// `context` and returns the amount of bytes consumed. Once it is known whether
+// the array fits on one line the window is marked to be replayed.
+static inline size_t con_writer_indent_collect(struct ConWriterIndent *context, char const *data, size_t data_size) {
+    assert(context != NULL);
+    assert(data != NULL || data_size == 0);
+    assert(context->window_state == CON_WRITER_INDENT_WINDOW_COLLECT);
+
+    size_t length = 0;
+    while (length < data_size) {
+        char c = data[length];
+        bool in_string = context->window_char.in_string;
+
+        if (!in_string && isspace((unsigned char) c)) {
+            length += 1;
+            continue;
         }
 
-        if (con_utils_state_char_is_item_separator(context->state, c)) {
-            bool success = con_writer_indent_whitespace(context);
-            if (!success) { break; }
+        // The byte which decides the layout is left for formatting, it is
+        // only consumed once everything in front of it was written.
+        bool close = !in_string && (c == ']' || c == '}');
+        bool nested = !in_string && context->window_size > 0 && (c == '[' || c == '{');
+        if (close && context->window_size < context->style.array_width) {
+            context->window_state = CON_WRITER_INDENT_WINDOW_LINE;
+            break;
+        } else if (close || nested || context->window_size >= context->style.array_width) {
+            context->window_state = CON_WRITER_INDENT_WINDOW_LINES;
+            break;
         }
 
-        con_utils_state_char_next(&context->state, c);
+        context->window[context->window_size] = c;
+        context->window_size += 1;
+        con_utils_state_char_next(&context->window_char, c);
+        length += 1;
     }
 
     return length;
 }
+
+// Writes the bytes in the window of `context` which were not written yet.
+// Returns whether all of them were written. An array on one line stays in
+// `CON_WRITER_INDENT_WINDOW_LINE` until its close is formatted.
+static inline bool con_writer_indent_replay(struct ConWriterIndent *context) {
+    assert(context != NULL);
+    assert(context->window_offset <= context->window_size);
+
+    char const *data = context->window + context->window_offset;
+    size_t data_size = context->window_size - context->window_offset;
+
+    context->window_offset += con_writer_indent_format(context, data, data_size);
+    if (context->window_offset != context->window_size) { return false; }
+
+    context->window_size = 0;
+    context->window_offset = 0;
+    if (context->window_state == CON_WRITER_INDENT_WINDOW_LINES) {
+        context->window_state = CON_WRITER_INDENT_WINDOW_NONE;
+    }
+    return true;
+}
+
+// Writes the whitespace `context` owes before the next byte, a new line is
+// indented by `depth` levels. Continues where a previous call stopped if the
+// writer failed part way, once all of it is written the next byte is written
+// without looking at whitespace again.
+static inline bool con_writer_indent_whitespace(struct ConWriterIndent *context, size_t depth) {
+    assert(context != NULL);
+
+    char const *buffer = con_writer_indent_spaces;
+    size_t size;
+    switch (context->pending) {
+        case (CON_WRITER_INDENT_PENDING_NONE):
+        case (CON_WRITER_INDENT_PENDING_DONE):
+            context->pending = CON_WRITER_INDENT_PENDING_DONE;
+            return true;
+        case (CON_WRITER_INDENT_PENDING_SPACE):
+            // `key_size` counts the key and its `:`.
+            size = 1;
+            if (context->key_size > 0 && context->style.key_width > context->key_size - 1) {
+                size += context->style.key_width - (context->key_size - 1);
+            }
+            break;
+        case (CON_WRITER_INDENT_PENDING_ITEM):
+            size = 1;
+            break;
+        case (CON_WRITER_INDENT_PENDING_NEWLINE):
+        default:
+            if (context->style.tabs) { buffer = con_writer_indent_tabs; }
+            assert(context->style.indent_width == 0 || depth <= (SIZE_MAX - 1) / context->style.indent_width);
+            size = 1 + context->style.indent_width * depth;
+            break;
+    }
+
+    while (context->pending_written < size) {
+        size_t offset = context->pending_written;
+        char const *chunk;
+        size_t chunk_size;
+
+        if (offset == 0 && context->pending == CON_WRITER_INDENT_PENDING_NEWLINE) {
+            chunk = buffer;
+            chunk_size = 1 + CON_WRITER_INDENT_CHUNK;
+        } else {
+            chunk = buffer + 1;
+            chunk_size = CON_WRITER_INDENT_CHUNK;
+        }
+        if (chunk_size > size - offset) { chunk_size = size - offset; }
+
+        size_t written = gci_writer_write(context->writer, chunk, chunk_size);
+        assert(written <= chunk_size);
+        context->pending_written += written;
+        if (written != chunk_size) { return false; }
+    }
+
+    context->pending = CON_WRITER_INDENT_PENDING_DONE;
+    context->pending_written = 0;
+    context->key_size = 0;
+    return true;
+}
@@ -2,6 +2,8 @@ const gci = @import("gci");
 const internal = @import("../internal.zig");
 const lib = internal.lib;
 
+pub const Style = lib.ConWriterIndentStyle;
+
 pub const Indent = struct {
     inner: lib.ConWriterIndent,
 
@@ -12,6 +14,13 @@ pub const Indent = struct {
         return self;
     }
 
+    pub fn initStyle(writer: gci.InterfaceWriter, style: Style) !Indent {
+        var self: Indent = undefined;
+        const err = lib.con_writer_indent_init_style(&self.inner, @as(*lib.GciInterfaceWriter, @ptrCast(@constCast(&writer.writer))).*, style);
+        try internal.enumToError(err);
+        return self;
+    }
+
     pub fn interface(self: *Indent) gci.InterfaceWriter {
         const temp: gci.InterfaceWriter = undefined;
         return .{ .writer = @as(
@@ -109,6 +118,111 @@ test "indent empty container" {
     );
 }
 
+test "indent literals" {
+    var b: [18]u8 = undefined;
+    var c = try gci.WriterString.init(&b);
+    var context = try Indent.init(c.interface());
+    const writer = context.interface();
+
+    try writer.write("[null,true]");
+    try testing.expectEqualStrings(
+        \\[
+        \\  null,
+        \\  true
+        \\]
+    ,
+        &b,
+    );
+}
+
+test "indent top level string" {
+    var b: [5]u8 = undefined;
+    var c = try gci.WriterString.init(&b);
+    var context = try Indent.init(c.interface());
+    const writer = context.interface();
+
+    try writer.write(" \"a b\" ");
+    try testing.expectEqualStrings("\"a b\"", &b);
+}
+
+test "indent style tabs" {
+    var b: [23]u8 = undefined;
+    var c = try gci.WriterString.init(&b);
+    var context = try Indent.initStyle(c.interface(), .{ .indent_width = 1, .tabs = true, .array_width = 0, .key_width = 0 });
+    const writer = context.interface();
+
+    try writer.write("{\"k\":[1,2]}");
+    try testing.expectEqualStrings("{\n\t\"k\": [\n\t\t1,\n\t\t2\n\t]\n}", &b);
+}
+
+test "indent style short arrays" {
+    var b: [76]u8 = undefined;
+    var c = try gci.WriterString.init(&b);
+    var context = try Indent.initStyle(c.interface(), .{ .indent_width = 2, .tabs = false, .array_width = 10, .key_width = 0 });
+    const writer = context.interface();
+
+    // Fits, holds a container and is too long.
+    const str = "[[1,\"]\",3],[[]],[1,2,3,4,5]]";
+    for (str) |ch| {
+        const single: [1]u8 = .{ch};
+        try writer.write(&single);
+    }
+
+    try testing.expectEqualStrings(
+        \\[
+        \\  [1, "]", 3],
+        \\  [
+        \\    []
+        \\  ],
+        \\  [
+        \\    1,
+        \\    2,
+        \\    3,
+        \\    4,
+        \\    5
+        \\  ]
+        \\]
+    ,
+        &b,
+    );
+}
+
+test "indent style align keys" {
+    var b: [40]u8 = undefined;
+    var c = try gci.WriterString.init(&b);
+    var context = try Indent.initStyle(c.interface(), .{ .indent_width = 2, .tabs = false, .array_width = 0, .key_width = 5 });
+    const writer = context.interface();
+
+    try writer.write("{\"a\":1,\"abc\":2,\"abcde\":3}");
+    try testing.expectEqualStrings(
+        \\{
+        \\  "a":   1,
+        \\  "abc": 2,
+        \\  "abcde": 3
+        \\}
+    ,
+        &b,
+    );
+}
+
+test "indent style compact" {
+    var b: [33]u8 = undefined;
+    var c = try gci.WriterString.init(&b);
+    var context = try Indent.initStyle(c.interface(), lib.con_writer_indent_style_compact());
+    const writer = context.interface();
+
+    try writer.write("{\"a\":[1,2,3],\"b\":[4,5]}");
+    try testing.expectEqualStrings("{\n\t\"a\": [1, 2, 3],\n\t\"b\": [4, 5]\n}", &b);
+}
+
+test "indent style array too wide" {
+    var b: [0]u8 = undefined;
+    var c = try gci.WriterString.init(&b);
+    var style = lib.con_writer_indent_style_default();
+    style.array_width = lib.CON_WRITER_INDENT_WINDOW + 1;
+    try testing.expectError(error.Buffer, Indent.initStyle(c.interface(), style));
+}
+
 test "indent body writer fail" {
     var b: [0]u8 = undefined;
     var c = try gci.WriterString.init(&b);
@@ -1,78 +1,953 @@
 #include <assert.h>
 #include <limits.h>
 #include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "utils.h"
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Targets which do not enable AVX2 at compile time may still run on a CPU
+// which has it, functions marked with `CON_UTILS_TARGET_AVX2` are then
+// compiled for AVX2 and only called if `con_utils_has_avx2` says so.
+#if !defined(__AVX2__) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CON_UTILS_DISPATCH_AVX2
+#define CON_UTILS_TARGET_AVX2 __attribute__((target("avx2")))
+#include <cpuid.h>
+#include <immintrin.h>
+#elif defined(__AVX2__)
+#define CON_UTILS_TARGET_AVX2
+#endif
+
+#if defined(CON_UTILS_DISPATCH_AVX2)
+// Whether the CPU and OS support AVX2. Set once before `main` runs, and so
+// before any thread can call into the library, instead of on first use where
+// threads would race on it.
+static bool con_utils_has_avx2 = false;
+
+__attribute__((constructor))
+static void con_utils_has_avx2_init(void) {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & bit_OSXSAVE) || !(ecx & bit_AVX)) { return; }
+
+    // The OS must also save the upper halves of the vector registers.
+    unsigned int xcr0_low, xcr0_high;
+    __asm__ ("xgetbv" : "=a" (xcr0_low), "=d" (xcr0_high) : "c" (0));
+    (void) xcr0_high;
+
+    if ((xcr0_low & 6) == 6 && __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        con_utils_has_avx2 = (ebx & bit_AVX2) != 0;
+    }
+}
+#endif
+
 enum ConState con_utils_state_init(void) {
     return CON_STATE_EMPTY;
 }
 
-enum ConError con_utils_state_next(enum ConState *state, enum ConContainer current) {
-    assert(state != NULL);
-    enum ConState s = *state;
+// Every state has to fit in the low `CON_UTILS_STATE_BITS` bits of an entry.
+typedef char con_utils_state_fits[(CON_STATE_MAX <= (1 << CON_UTILS_STATE_BITS)) ? 1 : -1];
 
-    assert(current == CON_CONTAINER_NONE || current == CON_CONTAINER_ARRAY || current == CON_CONTAINER_DICT);
-    if (current == CON_CONTAINER_DICT && (s == CON_STATE_FIRST || s == CON_STATE_LATER)) {
-        return CON_ERROR_KEY;
-    }
+// Entries of `con_utils_state_table`, a token which is not allowed keeps the
+// state and sets an error. An error which does not fit in the remaining bits
+// of an entry makes the array size in `CON_UTILS_ERR_FITS` negative and fails
+// to compile.
+#define CON_UTILS_ERR_FITS(error) (0 * sizeof(char[(CON_ERROR_##error < (1 << (CHAR_BIT - CON_UTILS_STATE_BITS))) ? 1 : -1]))
+#define CON_UTILS_OK(next) ((unsigned char) CON_STATE_##next)
+#define CON_UTILS_ERR(state, error) ((unsigned char) (CON_STATE_##state | CON_ERROR_##error << CON_UTILS_STATE_BITS | CON_UTILS_ERR_FITS(error)))
 
-    assert(CON_STATE_UNKNOWN <= s && s <= CON_STATE_MAX);
-    switch (s) {
-        case (CON_STATE_EMPTY):
-            *state = CON_STATE_COMPLETE;
-            return CON_ERROR_OK;
-        case (CON_STATE_FIRST):
-        case (CON_STATE_LATER):
-            *state = CON_STATE_LATER;
-            return CON_ERROR_OK;
-        case (CON_STATE_COMPLETE):
-            return CON_ERROR_COMPLETE;
-        case (CON_STATE_VALUE):
-            *state = CON_STATE_LATER;
-            return CON_ERROR_OK;
-        case (CON_STATE_MAX):
-        case (CON_STATE_UNKNOWN):
-            break;
-    }
+// Tokens per row: value, open, close, key.
+unsigned char const con_utils_state_table[CON_STATE_MAX][3][CON_UTILS_TOKEN_MAX] = {
+    [CON_STATE_UNKNOWN] = {
+        [CON_CONTAINER_NONE]  = { CON_UTILS_ERR(UNKNOWN, STATE_UNKNOWN), CON_UTILS_ERR(UNKNOWN, STATE_UNKNOWN), CON_UTILS_OK(LATER), CON_UTILS_ERR(UNKNOWN, VALUE) },
+        [CON_CONTAINER_DICT]  = { CON_UTILS_ERR(UNKNOWN, STATE_UNKNOWN), CON_UTILS_ERR(UNKNOWN, STATE_UNKNOWN), CON_UTILS_OK(LATER), CON_UTILS_OK(VALUE) },
+        [CON_CONTAINER_ARRAY] = { CON_UTILS_ERR(UNKNOWN, STATE_UNKNOWN), CON_UTILS_ERR(UNKNOWN, STATE_UNKNOWN), CON_UTILS_OK(LATER), CON_UTILS_ERR(UNKNOWN, VALUE) },
+    },
+    [CON_STATE_EMPTY] = {
+        [CON_CONTAINER_NONE]  = { CON_UTILS_OK(COMPLETE), CON_UTILS_OK(FIRST), CON_UTILS_OK(LATER), CON_UTILS_ERR(EMPTY, VALUE) },
+        [CON_CONTAINER_DICT]  = { CON_UTILS_OK(COMPLETE), CON_UTILS_OK(FIRST), CON_UTILS_OK(LATER), CON_UTILS_OK(VALUE) },
+        [CON_CONTAINER_ARRAY] = { CON_UTILS_OK(COMPLETE), CON_UTILS_OK(FIRST), CON_UTILS_OK(LATER), CON_UTILS_ERR(EMPTY, VALUE) },
+    },
+    [CON_STATE_FIRST] = {
+        [CON_CONTAINER_NONE]  = { CON_UTILS_OK(LATER), CON_UTILS_OK(FIRST), CON_UTILS_OK(LATER), CON_UTILS_ERR(FIRST, VALUE) },
+        [CON_CONTAINER_DICT]  = { CON_UTILS_ERR(FIRST, KEY), CON_UTILS_ERR(FIRST, KEY), CON_UTILS_OK(LATER), CON_UTILS_OK(VALUE) },
+        [CON_CONTAINER_ARRAY] = { CON_UTILS_OK(LATER), CON_UTILS_OK(FIRST), CON_UTILS_OK(LATER), CON_UTILS_ERR(FIRST, VALUE) },
+    },
+    [CON_STATE_LATER] = {
+        [CON_CONTAINER_NONE]  = { CON_UTILS_OK(LATER), CON_UTILS_OK(FIRST), CON_UTILS_OK(LATER), CON_UTILS_ERR(LATER, VALUE) },
+        [CON_CONTAINER_DICT]  = { CON_UTILS_ERR(LATER, KEY), CON_UTILS_ERR(LATER, KEY), CON_UTILS_OK(LATER), CON_UTILS_OK(VALUE) },
+        [CON_CONTAINER_ARRAY] = { CON_UTILS_OK(LATER), CON_UTILS_OK(FIRST), CON_UTILS_OK(LATER), CON_UTILS_ERR(LATER, VALUE) },
+    },
+    [CON_STATE_COMPLETE] = {
+        [CON_CONTAINER_NONE]  = { CON_UTILS_ERR(COMPLETE, COMPLETE), CON_UTILS_ERR(COMPLETE, COMPLETE), CON_UTILS_OK(LATER), CON_UTILS_ERR(COMPLETE, VALUE) },
+        [CON_CONTAINER_DICT]  = { CON_UTILS_ERR(COMPLETE, COMPLETE), CON_UTILS_ERR(COMPLETE, COMPLETE), CON_UTILS_OK(LATER), CON_UTILS_OK(VALUE) },
+        [CON_CONTAINER_ARRAY] = { CON_UTILS_ERR(COMPLETE, COMPLETE), CON_UTILS_ERR(COMPLETE, COMPLETE), CON_UTILS_OK(LATER), CON_UTILS_ERR(COMPLETE, VALUE) },
+    },
+    [CON_STATE_VALUE] = {
+        [CON_CONTAINER_NONE]  = { CON_UTILS_OK(LATER), CON_UTILS_OK(FIRST), CON_UTILS_OK(LATER), CON_UTILS_ERR(VALUE, VALUE) },
+        [CON_CONTAINER_DICT]  = { CON_UTILS_OK(LATER), CON_UTILS_OK(FIRST), CON_UTILS_OK(LATER), CON_UTILS_ERR(VALUE, VALUE) },
+        [CON_CONTAINER_ARRAY] = { CON_UTILS_OK(LATER), CON_UTILS_OK(FIRST), CON_UTILS_OK(LATER), CON_UTILS_ERR(VALUE, VALUE) },
+    },
+};
+
+#undef CON_UTILS_ERR_FITS
+#undef CON_UTILS_OK
+#undef CON_UTILS_ERR
 
-    assert(0);
-    return CON_ERROR_STATE_UNKNOWN;
+void con_utils_depth_init(struct ConDepth *stack, enum ConContainer *buffer, size_t buffer_size) {
+    assert(stack != NULL);
+    assert(buffer != NULL || buffer_size == 0);
+
+    stack->bits = (unsigned char*) buffer;
+    stack->bits_size = buffer_size * sizeof(enum ConContainer);
+    stack->size = buffer_size;
+    stack->allocated = false;
+    stack->allocator = (struct ConInterfaceAllocator) { .context = NULL, .resize = NULL };
 }
 
-enum ConError con_utils_state_open(enum ConState *state, enum ConContainer current) {
-    enum ConError err = con_utils_state_next(state, current);
-    if (err) { return err; }
+enum ConError con_utils_depth_allocator(struct ConDepth *stack, struct ConInterfaceAllocator allocator) {
+    assert(stack != NULL);
+    if (stack->allocated) { return CON_ERROR_BUFFER; }
 
-    assert(CON_STATE_UNKNOWN <= *state && *state <= CON_STATE_MAX);
-    *state = CON_STATE_FIRST;
+    stack->allocator = allocator;
+    stack->size = stack->bits_size * CHAR_BIT;
     return CON_ERROR_OK;
 }
 
-enum ConError con_utils_state_close(enum ConState *state, enum ConContainer current) {
-    assert(current == CON_CONTAINER_NONE || current == CON_CONTAINER_ARRAY || current == CON_CONTAINER_DICT);
-    assert(CON_STATE_UNKNOWN <= *state && *state <= CON_STATE_MAX);
-    *state = CON_STATE_LATER;
-    return CON_ERROR_OK;
+void con_utils_depth_deinit(struct ConDepth *stack) {
+    assert(stack != NULL);
+    if (!stack->allocated) { return; }
+
+    assert(stack->allocator.resize != NULL);
+    stack->allocator.resize(stack->allocator.context, stack->bits, stack->bits_size, 0);
+    stack->bits = NULL;
+    stack->bits_size = 0;
+    stack->size = 0;
+    stack->allocated = false;
 }
 
-enum ConError con_utils_state_key(enum ConState *state, enum ConContainer current) {
-    assert(current == CON_CONTAINER_NONE || current == CON_CONTAINER_ARRAY || current == CON_CONTAINER_DICT);
-    if (current != CON_CONTAINER_DICT) { return CON_ERROR_VALUE; }
+enum ConError con_utils_depth_reserve(struct ConDepth *stack, size_t size) {
+    assert(stack != NULL);
+    if (size <= stack->size) { return CON_ERROR_OK; }
+    if (stack->allocator.resize == NULL) { return CON_ERROR_TOO_DEEP; }
 
-    assert(CON_STATE_UNKNOWN <= *state && *state <= CON_STATE_MAX);
-    if (*state == CON_STATE_VALUE) { return CON_ERROR_VALUE; }
-    *state = CON_STATE_VALUE;
+    size_t needed = size / CHAR_BIT + (size % CHAR_BIT != 0);
+    size_t new_size = stack->bits_size < 8 ? 8 : stack->bits_size;
+    while (new_size < needed) {
+        if (new_size > SIZE_MAX / 2) { return CON_ERROR_TOO_DEEP; }
+        new_size *= 2;
+    }
+
+    void const *context = stack->allocator.context;
+    unsigned char *bits;
+    if (stack->allocated) {
+        bits = stack->allocator.resize(context, stack->bits, stack->bits_size, new_size);
+        if (bits == NULL) { return CON_ERROR_TOO_DEEP; }
+    } else {
+        // The initial buffer belongs to the caller, the levels in it are
+        // copied over once and it is not used afterwards.
+        bits = stack->allocator.resize(context, NULL, 0, new_size);
+        if (bits == NULL) { return CON_ERROR_TOO_DEEP; }
+        if (stack->bits_size > 0) { memcpy(bits, stack->bits, stack->bits_size); }
+    }
+
+    stack->bits = bits;
+    stack->bits_size = new_size;
+    stack->size = new_size * CHAR_BIT;
+    stack->allocated = true;
     return CON_ERROR_OK;
 }
 
-enum ConContainer con_utils_container_current(enum ConContainer *containers, size_t size, size_t depth) {
-    assert(0 <= depth && depth <= size);
-    if (depth == 0) { return CON_CONTAINER_NONE; }
+// Whitespace in the "C" locale is ' ' and '\t' to '\r'. Any locale considers
+// these to be whitespace so the vectorized paths never skip a character which
+// `isspace` would not skip.
+size_t con_utils_whitespace_skip(char const *data, size_t data_size) {
+    assert(data != NULL || data_size == 0);
+    size_t index = 0;
+
+#if defined(__AVX2__)
+    __m256i const space_32 = _mm256_set1_epi8(' ');
+    __m256i const tab_32 = _mm256_set1_epi8('\t');
+    __m256i const range_32 = _mm256_set1_epi8('\r' - '\t');
+    for (; index + 32 <= data_size; index += 32) {
+        __m256i block = _mm256_loadu_si256((__m256i const*) (data + index));
+        __m256i is_space = _mm256_cmpeq_epi8(block, space_32);
+        __m256i offset = _mm256_sub_epi8(block, tab_32);
+        __m256i is_control = _mm256_cmpeq_epi8(_mm256_min_epu8(offset, range_32), offset);
+
+        unsigned int mask = (unsigned int) _mm256_movemask_epi8(_mm256_or_si256(is_space, is_control));
+        if (mask != 0xffffffffu) {
+            return index + (size_t) __builtin_ctz(~mask);
+        }
+    }
+#endif
+
+#if defined(__SSE2__)
+    __m128i const space_16 = _mm_set1_epi8(' ');
+    __m128i const tab_16 = _mm_set1_epi8('\t');
+    __m128i const range_16 = _mm_set1_epi8('\r' - '\t');
+    for (; index + 16 <= data_size; index += 16) {
+        __m128i block = _mm_loadu_si128((__m128i const*) (data + index));
+        __m128i is_space = _mm_cmpeq_epi8(block, space_16);
+        __m128i offset = _mm_sub_epi8(block, tab_16);
+        __m128i is_control = _mm_cmpeq_epi8(_mm_min_epu8(offset, range_16), offset);
+
+        unsigned int mask = (unsigned int) _mm_movemask_epi8(_mm_or_si128(is_space, is_control));
+        if (mask != 0xffffu) {
+            return index + (size_t) __builtin_ctz(~mask);
+        }
+    }
+#endif
 
-    assert(containers != NULL);
-    enum ConContainer current = containers[depth - 1];
-    assert(current == CON_CONTAINER_ARRAY || current == CON_CONTAINER_DICT);
-    return current;
+    for (; index < data_size; index++) {
+        if (!isspace((unsigned char) data[index])) { break; }
+    }
+
+    return index;
+}
+
+size_t con_utils_string_span(char const *data, size_t data_size) {
+    assert(data != NULL || data_size == 0);
+    size_t index = 0;
+
+#if defined(__AVX2__)
+    __m256i const quote_32 = _mm256_set1_epi8('"');
+    __m256i const backslash_32 = _mm256_set1_epi8('\\');
+    for (; index + 32 <= data_size; index += 32) {
+        __m256i block = _mm256_loadu_si256((__m256i const*) (data + index));
+        __m256i is_quote = _mm256_cmpeq_epi8(block, quote_32);
+        __m256i is_backslash = _mm256_cmpeq_epi8(block, backslash_32);
+
+        unsigned int mask = (unsigned int) _mm256_movemask_epi8(_mm256_or_si256(is_quote, is_backslash));
+        if (mask != 0) {
+            return index + (size_t) __builtin_ctz(mask);
+        }
+    }
+#endif
+
+#if defined(__SSE2__)
+    __m128i const quote_16 = _mm_set1_epi8('"');
+    __m128i const backslash_16 = _mm_set1_epi8('\\');
+    for (; index + 16 <= data_size; index += 16) {
+        __m128i block = _mm_loadu_si128((__m128i const*) (data + index));
+        __m128i is_quote = _mm_cmpeq_epi8(block, quote_16);
+        __m128i is_backslash = _mm_cmpeq_epi8(block, backslash_16);
+
+        unsigned int mask = (unsigned int) _mm_movemask_epi8(_mm_or_si128(is_quote, is_backslash));
+        if (mask != 0) {
+            return index + (size_t) __builtin_ctz(mask);
+        }
+    }
+#endif
+
+    for (; index < data_size; index++) {
+        if (data[index] == '"' || data[index] == '\\') { break; }
+    }
+
+    return index;
+}
+
+// Setting bit 0x20 maps `[` to `{` and `]` to `}` and no other character to
+// either, so two comparisons find all four brackets.
+size_t con_utils_structure_span(char const *data, size_t data_size) {
+    assert(data != NULL || data_size == 0);
+    size_t index = 0;
+
+#if defined(__AVX2__)
+    __m256i const quote_32 = _mm256_set1_epi8('"');
+    __m256i const lower_32 = _mm256_set1_epi8(0x20);
+    __m256i const open_32 = _mm256_set1_epi8('{');
+    __m256i const close_32 = _mm256_set1_epi8('}');
+    for (; index + 32 <= data_size; index += 32) {
+        __m256i block = _mm256_loadu_si256((__m256i const*) (data + index));
+        __m256i lower = _mm256_or_si256(block, lower_32);
+        __m256i is_quote = _mm256_cmpeq_epi8(block, quote_32);
+        __m256i is_open = _mm256_cmpeq_epi8(lower, open_32);
+        __m256i is_close = _mm256_cmpeq_epi8(lower, close_32);
+
+        __m256i is_special = _mm256_or_si256(_mm256_or_si256(is_quote, is_open), is_close);
+        unsigned int mask = (unsigned int) _mm256_movemask_epi8(is_special);
+        if (mask != 0) {
+            return index + (size_t) __builtin_ctz(mask);
+        }
+    }
+#endif
+
+#if defined(__SSE2__)
+    __m128i const quote_16 = _mm_set1_epi8('"');
+    __m128i const lower_16 = _mm_set1_epi8(0x20);
+    __m128i const open_16 = _mm_set1_epi8('{');
+    __m128i const close_16 = _mm_set1_epi8('}');
+    for (; index + 16 <= data_size; index += 16) {
+        __m128i block = _mm_loadu_si128((__m128i const*) (data + index));
+        __m128i lower = _mm_or_si128(block, lower_16);
+        __m128i is_quote = _mm_cmpeq_epi8(block, quote_16);
+        __m128i is_open = _mm_cmpeq_epi8(lower, open_16);
+        __m128i is_close = _mm_cmpeq_epi8(lower, close_16);
+
+        __m128i is_special = _mm_or_si128(_mm_or_si128(is_quote, is_open), is_close);
+        unsigned int mask = (unsigned int) _mm_movemask_epi8(is_special);
+        if (mask != 0) {
+            return index + (size_t) __builtin_ctz(mask);
+        }
+    }
+#endif
+
+    for (; index < data_size; index++) {
+        char c = data[index];
+        if (c == '"' || c == '[' || c == ']' || c == '{' || c == '}') { break; }
+    }
+
+    return index;
+}
+
+size_t con_utils_escape_span(char const *data, size_t data_size) {
+    assert(data != NULL || data_size == 0);
+    size_t index = 0;
+
+#if defined(__AVX2__)
+    __m256i const quote_32 = _mm256_set1_epi8('"');
+    __m256i const backslash_32 = _mm256_set1_epi8('\\');
+    __m256i const control_32 = _mm256_set1_epi8(0x1F);
+    for (; index + 32 <= data_size; index += 32) {
+        __m256i block = _mm256_loadu_si256((__m256i const*) (data + index));
+        __m256i is_quote = _mm256_cmpeq_epi8(block, quote_32);
+        __m256i is_backslash = _mm256_cmpeq_epi8(block, backslash_32);
+        __m256i is_control = _mm256_cmpeq_epi8(_mm256_min_epu8(block, control_32), block);
+
+        __m256i is_special = _mm256_or_si256(_mm256_or_si256(is_quote, is_backslash), is_control);
+        unsigned int mask = (unsigned int) _mm256_movemask_epi8(is_special);
+        if (mask != 0) {
+            return index + (size_t) __builtin_ctz(mask);
+        }
+    }
+#endif
+
+#if defined(__SSE2__)
+    __m128i const quote_16 = _mm_set1_epi8('"');
+    __m128i const backslash_16 = _mm_set1_epi8('\\');
+    __m128i const control_16 = _mm_set1_epi8(0x1F);
+    for (; index + 16 <= data_size; index += 16) {
+        __m128i block = _mm_loadu_si128((__m128i const*) (data + index));
+        __m128i is_quote = _mm_cmpeq_epi8(block, quote_16);
+        __m128i is_backslash = _mm_cmpeq_epi8(block, backslash_16);
+        __m128i is_control = _mm_cmpeq_epi8(_mm_min_epu8(block, control_16), block);
+
+        __m128i is_special = _mm_or_si128(_mm_or_si128(is_quote, is_backslash), is_control);
+        unsigned int mask = (unsigned int) _mm_movemask_epi8(is_special);
+        if (mask != 0) {
+            return index + (size_t) __builtin_ctz(mask);
+        }
+    }
+#endif
+
+    for (; index < data_size; index++) {
+        unsigned char c = (unsigned char) data[index];
+        if (c == '"' || c == '\\' || c < 0x20) { break; }
+    }
+
+    return index;
+}
+
+// Characters `con_serialize_check_string` has to look at, i.e. `"`, `\` and
+// the control characters it rejects. Everything else is skipped in bulk.
+static inline bool con_utils_check_string_special(char c) {
+    switch (c) {
+        case ('"'):
+        case ('\\'):
+        case ('\b'):
+        case ('\f'):
+        case ('\n'):
+        case ('\r'):
+        case ('\t'):
+            return true;
+        default:
+            return false;
+    }
+}
+
+#if defined(CON_UTILS_TARGET_AVX2) || defined(CON_UTILS_DISPATCH_AVX2)
+CON_UTILS_TARGET_AVX2
+static size_t con_utils_check_string_blocks_avx2(char const *data, size_t data_size) {
+    __m256i const quote = _mm256_set1_epi8('"');
+    __m256i const backslash = _mm256_set1_epi8('\\');
+    __m256i const backspace = _mm256_set1_epi8('\b');
+    __m256i const range = _mm256_set1_epi8('\r' - '\b');
+    __m256i const vertical_tab = _mm256_set1_epi8('\v');
+
+    size_t index = 0;
+    for (; index + 32 <= data_size; index += 32) {
+        __m256i block = _mm256_loadu_si256((__m256i const*) (data + index));
+        __m256i is_quote = _mm256_cmpeq_epi8(block, quote);
+        __m256i is_backslash = _mm256_cmpeq_epi8(block, backslash);
+
+        // \b to \r except \v
+        __m256i offset = _mm256_sub_epi8(block, backspace);
+        __m256i is_control = _mm256_cmpeq_epi8(_mm256_min_epu8(offset, range), offset);
+        is_control = _mm256_andnot_si256(_mm256_cmpeq_epi8(block, vertical_tab), is_control);
+
+        __m256i is_special = _mm256_or_si256(_mm256_or_si256(is_quote, is_backslash), is_control);
+        unsigned int mask = (unsigned int) _mm256_movemask_epi8(is_special);
+        if (mask != 0) {
+            return index + (size_t) __builtin_ctz(mask);
+        }
+    }
+
+    return index;
+}
+
+CON_UTILS_TARGET_AVX2
+static size_t con_utils_digit_blocks_avx2(char const *data, size_t data_size) {
+    __m256i const zero = _mm256_set1_epi8('0');
+    __m256i const nine = _mm256_set1_epi8(9);
+
+    size_t index = 0;
+    for (; index + 32 <= data_size; index += 32) {
+        __m256i block = _mm256_loadu_si256((__m256i const*) (data + index));
+        __m256i offset = _mm256_sub_epi8(block, zero);
+        __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(offset, nine), offset);
+
+        unsigned int mask = ~(unsigned int) _mm256_movemask_epi8(is_digit);
+        if (mask != 0) {
+            return index + (size_t) __builtin_ctz(mask);
+        }
+    }
+
+    return index;
+}
+#endif
+
+#if defined(__SSE2__)
+static size_t con_utils_check_string_blocks_sse2(char const *data, size_t data_size) {
+    __m128i const quote = _mm_set1_epi8('"');
+    __m128i const backslash = _mm_set1_epi8('\\');
+    __m128i const backspace = _mm_set1_epi8('\b');
+    __m128i const range = _mm_set1_epi8('\r' - '\b');
+    __m128i const vertical_tab = _mm_set1_epi8('\v');
+
+    size_t index = 0;
+    for (; index + 16 <= data_size; index += 16) {
+        __m128i block = _mm_loadu_si128((__m128i const*) (data + index));
+        __m128i is_quote = _mm_cmpeq_epi8(block, quote);
+        __m128i is_backslash = _mm_cmpeq_epi8(block, backslash);
+
+        // \b to \r except \v
+        __m128i offset = _mm_sub_epi8(block, backspace);
+        __m128i is_control = _mm_cmpeq_epi8(_mm_min_epu8(offset, range), offset);
+        is_control = _mm_andnot_si128(_mm_cmpeq_epi8(block, vertical_tab), is_control);
+
+        __m128i is_special = _mm_or_si128(_mm_or_si128(is_quote, is_backslash), is_control);
+        unsigned int mask = (unsigned int) _mm_movemask_epi8(is_special);
+        if (mask != 0) {
+            return index + (size_t) __builtin_ctz(mask);
+        }
+    }
+
+    return index;
+}
+
+static size_t con_utils_digit_blocks_sse2(char const *data, size_t data_size) {
+    __m128i const zero = _mm_set1_epi8('0');
+    __m128i const nine = _mm_set1_epi8(9);
+
+    size_t index = 0;
+    for (; index + 16 <= data_size; index += 16) {
+        __m128i block = _mm_loadu_si128((__m128i const*) (data + index));
+        __m128i offset = _mm_sub_epi8(block, zero);
+        __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(offset, nine), offset);
+
+        unsigned int mask = ~(unsigned int) _mm_movemask_epi8(is_digit) & 0xFFFF;
+        if (mask != 0) {
+            return index + (size_t) __builtin_ctz(mask);
+        }
+    }
+
+    return index;
+}
+#endif
+
+size_t con_utils_check_string_span(char const *data, size_t data_size) {
+    assert(data != NULL || data_size == 0);
+    size_t index = 0;
+
+#if defined(__AVX2__)
+    index = con_utils_check_string_blocks_avx2(data, data_size);
+#elif defined(CON_UTILS_DISPATCH_AVX2)
+    if (data_size >= 32 && con_utils_has_avx2) {
+        index = con_utils_check_string_blocks_avx2(data, data_size);
+    }
+#endif
+
+#if defined(__SSE2__)
+    if (index == data_size || con_utils_check_string_special(data[index])) { return index; }
+    index += con_utils_check_string_blocks_sse2(data + index, data_size - index);
+#endif
+
+    for (; index < data_size; index++) {
+        if (con_utils_check_string_special(data[index])) { break; }
+    }
+
+    return index;
+}
+
+size_t con_utils_digit_span(char const *data, size_t data_size) {
+    assert(data != NULL || data_size == 0);
+    size_t index = 0;
+
+#if defined(__AVX2__)
+    index = con_utils_digit_blocks_avx2(data, data_size);
+#elif defined(CON_UTILS_DISPATCH_AVX2)
+    if (data_size >= 32 && con_utils_has_avx2) {
+        index = con_utils_digit_blocks_avx2(data, data_size);
+    }
+#endif
+
+#if defined(__SSE2__)
+    if (index == data_size || !isdigit((unsigned char) data[index])) { return index; }
+    index += con_utils_digit_blocks_sse2(data + index, data_size - index);
+#endif
+
+    for (; index < data_size; index++) {
+        if (!isdigit((unsigned char) data[index])) { break; }
+    }
+
+    return index;
+}
+
+// Two decimal digits for every value below 100, lets integers be formatted two
+// digits per division.
+static char const con_utils_digit_pairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static uint64_t const con_utils_pow10[] = {
+    UINT64_C(1),
+    UINT64_C(10),
+    UINT64_C(100),
+    UINT64_C(1000),
+    UINT64_C(10000),
+    UINT64_C(100000),
+    UINT64_C(1000000),
+    UINT64_C(10000000),
+    UINT64_C(100000000),
+    UINT64_C(1000000000),
+    UINT64_C(10000000000),
+    UINT64_C(100000000000),
+    UINT64_C(1000000000000),
+    UINT64_C(10000000000000),
+    UINT64_C(100000000000000),
+    UINT64_C(1000000000000000),
+    UINT64_C(10000000000000000),
+    UINT64_C(100000000000000000),
+    UINT64_C(1000000000000000000),
+    UINT64_C(10000000000000000000),
+};
+
+size_t con_utils_format_uint64(char *buffer, uint64_t value) {
+    assert(buffer != NULL);
+
+    char digits[20];
+    size_t index = sizeof(digits);
+
+    while (value >= 100) {
+        size_t pair = 2 * (size_t) (value % 100);
+        value /= 100;
+
+        index -= 2;
+        digits[index] = con_utils_digit_pairs[pair];
+        digits[index + 1] = con_utils_digit_pairs[pair + 1];
+    }
+
+    if (value >= 10) {
+        size_t pair = 2 * (size_t) value;
+        index -= 2;
+        digits[index] = con_utils_digit_pairs[pair];
+        digits[index + 1] = con_utils_digit_pairs[pair + 1];
+    } else {
+        index -= 1;
+        digits[index] = (char) ('0' + value);
+    }
+
+    size_t length = sizeof(digits) - index;
+    memcpy(buffer, digits + index, length);
+    return length;
+}
+
+size_t con_utils_format_int64(char *buffer, int64_t value) {
+    assert(buffer != NULL);
+
+    if (value < 0) {
+        buffer[0] = '-';
+        return 1 + con_utils_format_uint64(buffer + 1, 0 - (uint64_t) value);
+    }
+    return con_utils_format_uint64(buffer, (uint64_t) value);
+}
+
+// Floating point number `f * 2^e` with a 64 bit significand, as used by the
+// Grisu algorithm.
+struct ConUtilsFloat {
+    uint64_t f;
+    int e;
+};
+
+// Normalized approximations of `10^(-348 + 8 * i)`, a power of ten brings any
+// double into the range where Grisu can generate digits.
+static uint64_t const con_utils_cached_powers_f[] = {
+        UINT64_C(0xfa8fd5a0081c0288), UINT64_C(0xbaaee17fa23ebf76), UINT64_C(0x8b16fb203055ac76),
+        UINT64_C(0xcf42894a5dce35ea), UINT64_C(0x9a6bb0aa55653b2d), UINT64_C(0xe61acf033d1a45df),
+        UINT64_C(0xab70fe17c79ac6ca), UINT64_C(0xff77b1fcbebcdc4f), UINT64_C(0xbe5691ef416bd60c),
+        UINT64_C(0x8dd01fad907ffc3c), UINT64_C(0xd3515c2831559a83), UINT64_C(0x9d71ac8fada6c9b5),
+        UINT64_C(0xea9c227723ee8bcb), UINT64_C(0xaecc49914078536d), UINT64_C(0x823c12795db6ce57),
+        UINT64_C(0xc21094364dfb5637), UINT64_C(0x9096ea6f3848984f), UINT64_C(0xd77485cb25823ac7),
+        UINT64_C(0xa086cfcd97bf97f4), UINT64_C(0xef340a98172aace5), UINT64_C(0xb23867fb2a35b28e),
+        UINT64_C(0x84c8d4dfd2c63f3b), UINT64_C(0xc5dd44271ad3cdba), UINT64_C(0x936b9fcebb25c996),
+        UINT64_C(0xdbac6c247d62a584), UINT64_C(0xa3ab66580d5fdaf6), UINT64_C(0xf3e2f893dec3f126),
+        UINT64_C(0xb5b5ada8aaff80b8), UINT64_C(0x87625f056c7c4a8b), UINT64_C(0xc9bcff6034c13053),
+        UINT64_C(0x964e858c91ba2655), UINT64_C(0xdff9772470297ebd), UINT64_C(0xa6dfbd9fb8e5b88f),
+        UINT64_C(0xf8a95fcf88747d94), UINT64_C(0xb94470938fa89bcf), UINT64_C(0x8a08f0f8bf0f156b),
+        UINT64_C(0xcdb02555653131b6), UINT64_C(0x993fe2c6d07b7fac), UINT64_C(0xe45c10c42a2b3b06),
+        UINT64_C(0xaa242499697392d3), UINT64_C(0xfd87b5f28300ca0e), UINT64_C(0xbce5086492111aeb),
+        UINT64_C(0x8cbccc096f5088cc), UINT64_C(0xd1b71758e219652c), UINT64_C(0x9c40000000000000),
+        UINT64_C(0xe8d4a51000000000), UINT64_C(0xad78ebc5ac620000), UINT64_C(0x813f3978f8940984),
+        UINT64_C(0xc097ce7bc90715b3), UINT64_C(0x8f7e32ce7bea5c70), UINT64_C(0xd5d238a4abe98068),
+        UINT64_C(0x9f4f2726179a2245), UINT64_C(0xed63a231d4c4fb27), UINT64_C(0xb0de65388cc8ada8),
+        UINT64_C(0x83c7088e1aab65db), UINT64_C(0xc45d1df942711d9a), UINT64_C(0x924d692ca61be758),
+        UINT64_C(0xda01ee641a708dea), UINT64_C(0xa26da3999aef774a), UINT64_C(0xf209787bb47d6b85),
+        UINT64_C(0xb454e4a179dd1877), UINT64_C(0x865b86925b9bc5c2), UINT64_C(0xc83553c5c8965d3d),
+        UINT64_C(0x952ab45cfa97a0b3), UINT64_C(0xde469fbd99a05fe3), UINT64_C(0xa59bc234db398c25),
+        UINT64_C(0xf6c69a72a3989f5c), UINT64_C(0xb7dcbf5354e9bece), UINT64_C(0x88fcf317f22241e2),
+        UINT64_C(0xcc20ce9bd35c78a5), UINT64_C(0x98165af37b2153df), UINT64_C(0xe2a0b5dc971f303a),
+        UINT64_C(0xa8d9d1535ce3b396), UINT64_C(0xfb9b7cd9a4a7443c), UINT64_C(0xbb764c4ca7a44410),
+        UINT64_C(0x8bab8eefb6409c1a), UINT64_C(0xd01fef10a657842c), UINT64_C(0x9b10a4e5e9913129),
+        UINT64_C(0xe7109bfba19c0c9d), UINT64_C(0xac2820d9623bf429), UINT64_C(0x80444b5e7aa7cf85),
+        UINT64_C(0xbf21e44003acdd2d), UINT64_C(0x8e679c2f5e44ff8f), UINT64_C(0xd433179d9c8cb841),
+        UINT64_C(0x9e19db92b4e31ba9), UINT64_C(0xeb96bf6ebadf77d9), UINT64_C(0xaf87023b9bf0ee6b),
+};
+
+static int const con_utils_cached_powers_e[] = {
+        -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+        -954, -927, -901, -874, -847, -821, -794, -768, -741, -715,
+        -688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+        -422, -396, -369, -343, -316, -289, -263, -236, -210, -183,
+        -157, -130, -103, -77, -50, -24, 3, 30, 56, 83,
+        109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+        375, 402, 428, 455, 481, 508, 534, 561, 588, 614,
+        641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+        907, 933, 960, 986, 1013, 1039, 1066,
+};
+
+static inline struct ConUtilsFloat con_utils_float_normalize(struct ConUtilsFloat x) {
+    assert(x.f != 0);
+#if defined(__GNUC__)
+    int shift = __builtin_clzll(x.f);
+    x.f <<= shift;
+    x.e -= shift;
+#else
+    while ((x.f & (UINT64_C(1) << 63)) == 0) {
+        x.f <<= 1;
+        x.e -= 1;
+    }
+#endif
+    return x;
+}
+
+static inline struct ConUtilsFloat con_utils_float_multiply(struct ConUtilsFloat a, struct ConUtilsFloat b) {
+    uint64_t const mask = UINT64_C(0xFFFFFFFF);
+    uint64_t a_high = a.f >> 32;
+    uint64_t a_low = a.f & mask;
+    uint64_t b_high = b.f >> 32;
+    uint64_t b_low = b.f & mask;
+
+    uint64_t high_high = a_high * b_high;
+    uint64_t low_high = a_low * b_high;
+    uint64_t high_low = a_high * b_low;
+    uint64_t low_low = a_low * b_low;
+
+    uint64_t middle = (low_low >> 32) + (high_low & mask) + (low_high & mask);
+    middle += UINT64_C(1) << 31;  // round
+
+    struct ConUtilsFloat result = {
+        .f = high_high + (high_low >> 32) + (low_high >> 32) + (middle >> 32),
+        .e = a.e + b.e + 64,
+    };
+    return result;
+}
+
+// Moves the last digit towards `w` while the result stays within the safe
+// interval, as in Grisu3. Returns false if the digits are not guaranteed to be
+// the closest shortest result, `unit` is the uncertainty of all quantities.
+static inline bool con_utils_grisu_round(
+    char *digits,
+    int length,
+    uint64_t distance_too_high_w,
+    uint64_t unsafe_interval,
+    uint64_t rest,
+    uint64_t ten_kappa,
+    uint64_t unit
+) {
+    uint64_t small_distance = distance_too_high_w - unit;
+    uint64_t big_distance = distance_too_high_w + unit;
+
+    while (
+        rest < small_distance
+        && unsafe_interval - rest >= ten_kappa
+        && (rest + ten_kappa < small_distance || small_distance - rest >= rest + ten_kappa - small_distance)
+    ) {
+        digits[length - 1] -= 1;
+        rest += ten_kappa;
+    }
+
+    // If one more step would also be closer to the upper end of the
+    // uncertainty the closest digits cannot be decided.
+    if (
+        rest < big_distance
+        && unsafe_interval - rest >= ten_kappa
+        && (rest + ten_kappa < big_distance || big_distance - rest > rest + ten_kappa - big_distance)
+    ) {
+        return false;
+    }
+
+    return 2 * unit <= rest && rest <= unsafe_interval - 4 * unit;
+}
+
+// Generates the digits of a positive finite double such that
+// `digits * 10^exponent` is the shortest result within its rounding interval.
+// This is Grisu3, it returns false for the fraction of a percent of doubles for
+// which the shortest digits cannot be proven with 64 bit arithmetic.
+static bool con_utils_grisu(uint64_t bits, char *digits, int *length, int *exponent) {
+    uint64_t const hidden_bit = UINT64_C(1) << 52;
+    uint64_t const significand_mask = hidden_bit - 1;
+    int biased_exponent = (int) (bits >> 52);
+
+    struct ConUtilsFloat v;
+    if (biased_exponent != 0) {
+        v.f = (bits & significand_mask) + hidden_bit;
+        v.e = biased_exponent - 1075;
+    } else {
+        v.f = bits & significand_mask;
+        v.e = -1074;
+    }
+
+    // Boundaries halfway to the neighbouring doubles, the lower one is closer
+    // if `v` is a power of two above the smallest normal double.
+    struct ConUtilsFloat plus = { .f = (v.f << 1) + 1, .e = v.e - 1 };
+    plus = con_utils_float_normalize(plus);
+
+    struct ConUtilsFloat minus;
+    if (v.f == hidden_bit && biased_exponent > 1) {
+        minus.f = (v.f << 2) - 1;
+        minus.e = v.e - 2;
+    } else {
+        minus.f = (v.f << 1) - 1;
+        minus.e = v.e - 1;
+    }
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+
+    double k_approximate = (-61 - plus.e) * 0.30102999566398114 + 347;
+    int k = (int) k_approximate;
+    if (k_approximate - k > 0.0) { k += 1; }
+    size_t index = (size_t) ((k >> 3) + 1);
+    assert(index < sizeof(con_utils_cached_powers_f) / sizeof(con_utils_cached_powers_f[0]));
+    *exponent = 348 - (int) (index << 3);
+
+    struct ConUtilsFloat power = {
+        .f = con_utils_cached_powers_f[index],
+        .e = con_utils_cached_powers_e[index],
+    };
+    struct ConUtilsFloat w = con_utils_float_multiply(con_utils_float_normalize(v), power);
+    struct ConUtilsFloat w_plus = con_utils_float_multiply(plus, power);
+    struct ConUtilsFloat w_minus = con_utils_float_multiply(minus, power);
+
+    // The products are off by less than one unit, digits are generated for
+    // the widened, unsafe interval and checked against the narrowed one.
+    uint64_t unit = 1;
+    uint64_t too_high = w_plus.f + unit;
+    uint64_t unsafe_interval = too_high - (w_minus.f - unit);
+    uint64_t distance = too_high - w.f;
+
+    int shift = -w_plus.e;
+    uint64_t one = UINT64_C(1) << shift;
+    uint32_t integral = (uint32_t) (too_high >> shift);
+    uint64_t fractional = too_high & (one - 1);
+
+    int kappa = 1;
+    while (kappa < 10 && integral >= con_utils_pow10[kappa]) {
+        kappa += 1;
+    }
+
+    *length = 0;
+    while (kappa > 0) {
+        uint64_t divisor = con_utils_pow10[kappa - 1];
+        uint32_t digit = (uint32_t) (integral / divisor);
+        integral = (uint32_t) (integral % divisor);
+        if (digit != 0 || *length != 0) {
+            digits[(*length)++] = (char) ('0' + digit);
+        }
+        kappa -= 1;
+
+        uint64_t rest = ((uint64_t) integral << shift) + fractional;
+        if (rest < unsafe_interval) {
+            *exponent += kappa;
+            return con_utils_grisu_round(digits, *length, distance, unsafe_interval, rest, divisor << shift, unit);
+        }
+    }
+
+    while (true) {
+        fractional *= 10;
+        unit *= 10;
+        unsafe_interval *= 10;
+        char digit = (char) (fractional >> shift);
+        if (digit != 0 || *length != 0) {
+            digits[(*length)++] = (char) ('0' + digit);
+        }
+        fractional &= one - 1;
+        kappa -= 1;
+
+        if (fractional < unsafe_interval) {
+            *exponent += kappa;
+            return con_utils_grisu_round(digits, *length, distance * unit, unsafe_interval, fractional, one, unit);
+        }
+    }
+}
+
+// Generates the digits of a positive finite double with the C library, used
+// where Grisu3 gives up. Takes the first of 15, 16 and 17 significant digits
+// which reads back as `value`, 15 digits always do if the shortest result is
+// that short.
+static void con_utils_grisu_fallback(double value, char *digits, int *length, int *exponent) {
+    char buffer[32];
+    for (int precision = 15; precision <= 17; precision++) {
+        snprintf(buffer, sizeof(buffer), "%.*e", precision - 1, value);
+        if (strtod(buffer, NULL) == value) { break; }
+    }
+
+    // Laid out as `d.ddde[+-]dd`, the decimal point depends on the locale.
+    char const *e = strchr(buffer, 'e');
+    assert(e != NULL);
+
+    *length = 0;
+    for (char const *c = buffer; c < e; c++) {
+        if (isdigit((unsigned char) *c)) { digits[(*length)++] = *c; }
+    }
+    *exponent = atoi(e + 1) - (*length - 1);
+
+    while (*length > 1 && digits[*length - 1] == '0') {
+        *length -= 1;
+        *exponent += 1;
+    }
+}
+
+size_t con_utils_format_double(char *buffer, double value) {
+    assert(buffer != NULL);
+    assert(isfinite(value));
+
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    size_t length = 0;
+    if (bits >> 63) {
+        buffer[length++] = '-';
+        bits &= ~(UINT64_C(1) << 63);
+    }
+    if (bits == 0) {
+        buffer[length++] = '0';
+        return length;
+    }
+
+    char digits[18];
+    int digits_length;
+    int exponent;
+    if (!con_utils_grisu(bits, digits, &digits_length, &exponent)) {
+        double magnitude;
+        memcpy(&magnitude, &bits, sizeof(magnitude));
+        con_utils_grisu_fallback(magnitude, digits, &digits_length, &exponent);
+    }
+
+    // Position of the decimal point relative to the first digit, laid out
+    // like JavaScript does: plain notation for reasonably sized numbers and
+    // scientific notation otherwise.
+    int point = digits_length + exponent;
+    size_t count = (size_t) digits_length;
+
+    if (exponent >= 0 && point <= 21) {
+        memcpy(buffer + length, digits, count);
+        memset(buffer + length + count, '0', (size_t) exponent);
+        return length + count + (size_t) exponent;
+    } else if (0 < point && point <= 21) {
+        memcpy(buffer + length, digits, (size_t) point);
+        buffer[length + (size_t) point] = '.';
+        memcpy(buffer + length + (size_t) point + 1, digits + point, count - (size_t) point);
+        return length + count + 1;
+    } else if (-6 < point && point <= 0) {
+        buffer[length++] = '0';
+        buffer[length++] = '.';
+        memset(buffer + length, '0', (size_t) -point);
+        length += (size_t) -point;
+        memcpy(buffer + length, digits, count);
+        return length + count;
+    }
+
+    buffer[length++] = digits[0];
+    if (count > 1) {
+        buffer[length++] = '.';
+        memcpy(buffer + length, digits + 1, count - 1);
+        length += count - 1;
+    }
+    buffer[length++] = 'e';
+    return length + con_utils_format_int64(buffer + length, point - 1);
+}
+
+// Value of each hex digit plus one, zero marks characters which are not hex
+// digits. Indexed by character so it does not assume `a` to `f` are contiguous.
+static unsigned char const con_utils_hex[UCHAR_MAX + 1] = {
+    ['0'] = 1,  ['1'] = 2,  ['2'] = 3,  ['3'] = 4,  ['4'] = 5,
+    ['5'] = 6,  ['6'] = 7,  ['7'] = 8,  ['8'] = 9,  ['9'] = 10,
+    ['a'] = 11, ['b'] = 12, ['c'] = 13, ['d'] = 14, ['e'] = 15, ['f'] = 16,
+    ['A'] = 11, ['B'] = 12, ['C'] = 13, ['D'] = 14, ['E'] = 15, ['F'] = 16,
+};
+
+unsigned int con_utils_hex_digit(char c) {
+    return con_utils_hex[(unsigned char) c];
+}
+
+size_t con_utils_utf8_encode(char *buffer, unsigned int code_point) {
+    assert(buffer != NULL);
+    assert(code_point <= 0x10FFFF);
+
+    if (code_point < 0x80) {
+        buffer[0] = (char) code_point;
+        return 1;
+    } else if (code_point < 0x800) {
+        buffer[0] = (char) (0xC0 | (code_point >> 6));
+        buffer[1] = (char) (0x80 | (code_point & 0x3F));
+        return 2;
+    } else if (code_point < 0x10000) {
+        buffer[0] = (char) (0xE0 | (code_point >> 12));
+        buffer[1] = (char) (0x80 | ((code_point >> 6) & 0x3F));
+        buffer[2] = (char) (0x80 | (code_point & 0x3F));
+        return 3;
+    }
+
+    buffer[0] = (char) (0xF0 | (code_point >> 18));
+    buffer[1] = (char) (0x80 | ((code_point >> 12) & 0x3F));
+    buffer[2] = (char) (0x80 | ((code_point >> 6) & 0x3F));
+    buffer[3] = (char) (0x80 | (code_point & 0x3F));
+    return 4;
 }
 
 bool con_utils_state_number_terminal(enum StateNumber state) {
@@ -198,14 +1073,14 @@ void con_utils_state_char_next(struct ConStateChar *state, char c) {
                     enum ConError err = con_utils_state_next(&state->state, CON_CONTAINER_ARRAY);
                     assert(err == CON_ERROR_OK);
                     state->in_string = true;
-                } else if (isdigit((unsigned char) c) || c == '-') {
+                } else if (isdigit((unsigned char) c) || c == '-' || c == 't' || c == 'f' || c == 'n') {
                     enum ConError err = con_utils_state_next(&state->state, CON_CONTAINER_ARRAY);
                     assert(err == CON_ERROR_OK);
-                    if (state->state == CON_STATE_COMPLETE) {
-                        state->state = CON_STATE_LATER;
-                    }
                 }
-                assert(state->state != CON_STATE_COMPLETE);
+
+                if (state->state == CON_STATE_COMPLETE) {
+                    state->state = CON_STATE_LATER;
+                }
                 break;
             case (CON_STATE_COMPLETE):
             case (CON_STATE_VALUE):
@@ -1,16 +1,159 @@
 #ifndef CON_UTILS_H
 #define CON_UTILS_H
+#include <assert.h>
+#include <limits.h>
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include "con_common.h"
 
 enum ConState con_utils_state_init(void);
-enum ConError con_utils_state_next(enum ConState *state, enum ConContainer current);
-enum ConError con_utils_state_open(enum ConState *state, enum ConContainer current);
-enum ConError con_utils_state_close(enum ConState *state, enum ConContainer current);
-enum ConError con_utils_state_key(enum ConState *state, enum ConContainer current);
 
-enum ConContainer con_utils_container_current(enum ConContainer *containers, size_t size, size_t depth);
+// Kinds of tokens which change the state of a context.
+enum ConUtilsToken {
+    CON_UTILS_TOKEN_VALUE   = 0,
+    CON_UTILS_TOKEN_OPEN    = 1,
+    CON_UTILS_TOKEN_CLOSE   = 2,
+    CON_UTILS_TOKEN_KEY     = 3,
+    CON_UTILS_TOKEN_MAX,
+};
+
+// Transitions of the state of a context by state, innermost container and
+// kind of token. An entry holds the next state in its low
+// `CON_UTILS_STATE_BITS` bits and the error, if the token is not allowed, in
+// the bits above.
+#define CON_UTILS_STATE_BITS 3
+extern unsigned char const con_utils_state_table[CON_STATE_MAX][3][CON_UTILS_TOKEN_MAX];
+
+// The functions below run for every token, they are defined here so that they
+// are inlined into the serializer and deserializer.
+
+// Updates `state` for a token of kind `token` in `current` with a single
+// lookup, `state` is unchanged if an error is returned.
+static inline enum ConError con_utils_state_token(enum ConState *state, enum ConContainer current, enum ConUtilsToken token) {
+    assert(state != NULL);
+    assert(CON_STATE_UNKNOWN <= *state && *state < CON_STATE_MAX);
+    assert(current == CON_CONTAINER_NONE || current == CON_CONTAINER_ARRAY || current == CON_CONTAINER_DICT);
+    assert(token < CON_UTILS_TOKEN_MAX);
+
+    unsigned char entry = con_utils_state_table[*state][current][token];
+    *state = (enum ConState) (entry & ((1u << CON_UTILS_STATE_BITS) - 1));
+    return (enum ConError) (entry >> CON_UTILS_STATE_BITS);
+}
+
+static inline enum ConError con_utils_state_next(enum ConState *state, enum ConContainer current) {
+    return con_utils_state_token(state, current, CON_UTILS_TOKEN_VALUE);
+}
+
+static inline enum ConError con_utils_state_open(enum ConState *state, enum ConContainer current) {
+    return con_utils_state_token(state, current, CON_UTILS_TOKEN_OPEN);
+}
+
+static inline enum ConError con_utils_state_close(enum ConState *state, enum ConContainer current) {
+    return con_utils_state_token(state, current, CON_UTILS_TOKEN_CLOSE);
+}
+
+static inline enum ConError con_utils_state_key(enum ConState *state, enum ConContainer current) {
+    return con_utils_state_token(state, current, CON_UTILS_TOKEN_KEY);
+}
+
+// Initializes `stack` on the memory of `buffer` without an allocator, it then
+// holds at most `buffer_size` levels like an array of `enum ConContainer` would.
+void con_utils_depth_init(struct ConDepth *stack, enum ConContainer *buffer, size_t buffer_size);
+
+// Lets `stack` grow with `allocator`. From then on every bit of the initial
+// buffer is used before memory is allocated, which doubles in size each time
+// the stack grows. Returns `CON_ERROR_BUFFER` if the stack has already grown.
+enum ConError con_utils_depth_allocator(struct ConDepth *stack, struct ConInterfaceAllocator allocator);
+
+// Frees memory allocated for `stack`, it may not be used afterwards.
+void con_utils_depth_deinit(struct ConDepth *stack);
+
+// Makes sure `stack` holds at least `size` levels, growing it if it has an
+// allocator. Returns `CON_ERROR_TOO_DEEP` if it does not and can not grow.
+enum ConError con_utils_depth_reserve(struct ConDepth *stack, size_t size);
+
+// Stores `container` as level `level`, which must be below the size reserved.
+static inline void con_utils_depth_set(struct ConDepth *stack, size_t level, enum ConContainer container) {
+    assert(stack != NULL);
+    assert(level < stack->size);
+    assert(container == CON_CONTAINER_ARRAY || container == CON_CONTAINER_DICT);
+
+    unsigned char mask = (unsigned char) (1u << (level % CHAR_BIT));
+    unsigned char array = (unsigned char) -(container == CON_CONTAINER_ARRAY);
+    unsigned char *bits = &stack->bits[level / CHAR_BIT];
+    *bits = (unsigned char) ((*bits & ~mask) | (array & mask));
+}
+
+// Returns the innermost container when `depth` levels are used, or
+// `CON_CONTAINER_NONE` if `depth` is 0.
+static inline enum ConContainer con_utils_depth_current(struct ConDepth const *stack, size_t depth) {
+    assert(stack != NULL);
+    assert(depth <= stack->size);
+    if (depth == 0) { return CON_CONTAINER_NONE; }
+
+    size_t level = depth - 1;
+    unsigned int array = (stack->bits[level / CHAR_BIT] >> (level % CHAR_BIT)) & 1u;
+    return (enum ConContainer) (CON_CONTAINER_DICT + array);
+}
+
+// Returns the amount of leading whitespace characters in `data`, i.e. the index
+// of the first character which is not whitespace or `data_size` if all are.
+// Uses SSE2 or AVX2 if the target supports it.
+size_t con_utils_whitespace_skip(char const *data, size_t data_size);
+
+// Returns the amount of leading characters in `data` which may be copied
+// as is from the body of a string, i.e. the index of the first `"` or `\`
+// or `data_size` if there is none. Uses SSE2 or AVX2 if the target supports it.
+size_t con_utils_string_span(char const *data, size_t data_size);
+
+// Returns the amount of leading characters in `data` which cannot open or
+// close a value when skipping a container, i.e. the index of the first `"`,
+// `[`, `]`, `{` or `}` or `data_size` if there is none. Uses SSE2 or AVX2 if the
+// target supports it.
+size_t con_utils_structure_span(char const *data, size_t data_size);
+
+// Returns the amount of leading characters in `data` which may be written as
+// is inside a JSON string, i.e. the index of the first `"`, `\` or control
+// character below 0x20 or `data_size` if there is none. Uses SSE2 or AVX2 if
+// the target supports it.
+size_t con_utils_escape_span(char const *data, size_t data_size);
+
+// Returns the amount of leading characters in `data` which
+// `con_serialize_check_string` accepts without looking further, i.e. the index
+// of the first `"`, `\`, `\b`, `\f`, `\n`, `\r` or `\t` or `data_size` if
+// there is none. Uses SSE2, and AVX2 if the CPU supports it at run time.
+size_t con_utils_check_string_span(char const *data, size_t data_size);
+
+// Returns the amount of leading digits `0` to `9` in `data`. Uses SSE2, and
+// AVX2 if the CPU supports it at run time.
+size_t con_utils_digit_span(char const *data, size_t data_size);
+
+// Amount of bytes large enough for any number written by the
+// `con_utils_format_*` functions.
+#define CON_UTILS_FORMAT_SIZE 32
+
+// Writes `value` in decimal to `buffer`, which must hold at least
+// `CON_UTILS_FORMAT_SIZE` bytes, and returns the amount of bytes written. The
+// result is not null terminated.
+size_t con_utils_format_uint64(char *buffer, uint64_t value);
+size_t con_utils_format_int64(char *buffer, int64_t value);
+
+// Writes the shortest decimal representation of `value` that reads back as the
+// same double to `buffer`. Uses Grisu3 and the C library for the fraction of a
+// percent of doubles Grisu3 rejects.
+// `buffer` must hold at least `CON_UTILS_FORMAT_SIZE` bytes and `value` must be
+// finite. Returns the amount of bytes written, the result is not null
+// terminated and always a valid JSON number.
+size_t con_utils_format_double(char *buffer, double value);
+
+// Returns the value of the hex digit `c` plus one, or zero if `c` is not a hex
+// digit.
+unsigned int con_utils_hex_digit(char c);
+
+// Writes `code_point`, which must be at most 0x10FFFF, as 1 to 4 bytes of UTF-8
+// to `buffer` and returns the amount of bytes written.
+size_t con_utils_utf8_encode(char *buffer, unsigned int code_point);
 
 enum StateNumber {
     NUMBER_ERROR,
@@ -0,0 +1,110 @@
+#ifndef CON_VALUE_H
+#define CON_VALUE_H
+#include <stddef.h>
+#include <stdint.h>
+#include <con_common.h>
+#include "con_serialize.h"
+#include "con_deserialize.h"
+
+enum ConValueType {
+    CON_VALUE_TYPE_NULL     = 0,
+    CON_VALUE_TYPE_BOOL     = 1,
+    CON_VALUE_TYPE_NUMBER   = 2,
+    CON_VALUE_TYPE_STRING   = 3,
+    CON_VALUE_TYPE_ARRAY    = 4,
+    CON_VALUE_TYPE_DICT     = 5,
+};
+
+// A node of a document, 16 bytes on 64 bit targets. The elements of an array
+// are `size` consecutive values at `as.items`, the entries of a dict are
+// `size` pairs of a string key followed by its value. Strings are decoded
+// UTF-8 and numbers are kept as written in the input.
+struct ConValue {
+    uint32_t type;      // enum ConValueType
+    uint32_t size;      // bytes of a string or number, elements of an array
+                        // or entries of a dict
+    union {
+        bool boolean;
+        char const *data;
+        struct ConValue *items;
+    } as;
+};
+
+// Bump allocator for documents in a caller provided buffer. Documents are
+// freed all at once by resetting the arena.
+struct ConValueArena {
+    char *data;
+    size_t size;
+    size_t used;
+};
+
+// Params:
+//  arena:  Valid pointer to single item.
+//  data:   May be null if `size` is 0, must otherwise be a valid pointer to as
+//          many bytes (or more) as specified by `size`. If call succeeds this
+//          pointer is owned by `arena`.
+//  size:   Must be equal to or smaller than actual length of passed in
+//          parameter `data`.
+//
+// Return:
+//  CON_ERROR_OK:   Call succeeded.
+//  CON_ERROR_NULL: `arena` or `data` is null.
+enum ConError con_value_arena_init(struct ConValueArena *arena, char *data, size_t size);
+
+// Frees every document in `arena`, values read from it must not be used
+// anymore.
+//
+// Return:
+//  CON_ERROR_OK:   Call succeeded.
+//  CON_ERROR_NULL: `arena` is null.
+enum ConError con_value_arena_reset(struct ConValueArena *arena);
+
+// Reads the next element of `context` into a document allocated in `arena`
+// and sets `value` to its root. Containers are collected at the free end of
+// the arena while they are read, and copied to contiguous spans once closed,
+// no other memory is used. Strings and numbers refer to the input if the
+// context reads from memory and they contain no escape sequences, the input
+// must then outlive the document, they are otherwise copied to the arena.
+// Nothing is allocated from `arena` if the call fails.
+//
+// Params:
+//  context:    Valid pointer to single item.
+//  arena:      Valid pointer to single item.
+//  value:      Valid pointer to single item, set to the root of the document.
+//
+// Return:
+//  Same as `con_deserialize_skip` and additionally:
+//  CON_ERROR_NULL:     `context`, `arena` or `value` is null.
+//  CON_ERROR_BUFFER:   Document does not fit in `arena`.
+//  CON_ERROR_OVERFLOW: A string, number or container is larger than
+//                      `UINT32_MAX`.
+enum ConError con_value_deserialize(
+    struct ConDeserialize *context,
+    struct ConValueArena *arena,
+    struct ConValue const **value
+);
+
+// Writes the document at `value` to `context`. Strings and keys are escaped
+// while written, numbers are written as they are.
+//
+// Return:
+//  Same as the functions of `con_serialize.h` and additionally:
+//  CON_ERROR_NULL:     `context` or `value` is null.
+//  CON_ERROR_TYPE:     Unknown value type or a dict key which is not a string.
+enum ConError con_value_serialize(struct ConSerialize *context, struct ConValue const *value);
+
+// Sets `item` to the value of the first `key` in the dict `value`, or to null
+// if the key is not there.
+//
+// Return:
+//  CON_ERROR_OK:       Call succeeded.
+//  CON_ERROR_NULL:     `value`, `key` or `item` is null.
+//  CON_ERROR_NOT_DICT: `value` is not a dict.
+enum ConError con_value_dict_get(
+    struct ConValue const *value,
+    char const *key,
+    size_t key_size,
+    struct ConValue const **item
+);
+
+#endif
@@ -0,0 +1,168 @@
+const testing = @import("std").testing;
+const lib = @import("../../internal.zig").lib;
+
+test "value arena init" {
+    var buffer: [16]u8 = undefined;
+    var arena: lib.ConValueArena = undefined;
+
+    const err = lib.con_value_arena_init(&arena, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), err);
+    try testing.expectEqual(0, arena.used);
+    try testing.expectEqual(16, arena.size);
+}
+
+test "value arena init null" {
+    var buffer: [16]u8 = undefined;
+    var arena: lib.ConValueArena = undefined;
+
+    const err1 = lib.con_value_arena_init(null, &buffer, buffer.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err1);
+
+    const err2 = lib.con_value_arena_init(&arena, null, 1);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err2);
+
+    const err3 = lib.con_value_arena_reset(null);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err3);
+}
+
+test "value deserialize" {
+    const data = "[1, {\"a\": \"b\"}, false]";
+    var depth: [2]lib.ConContainer = undefined;
+
+    var context: lib.ConDeserialize = undefined;
+    const init_err = lib.con_deserialize_init_memory(&context, data, data.len, &depth, depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    var buffer: [256]u8 = undefined;
+    var arena: lib.ConValueArena = undefined;
+    _ = lib.con_value_arena_init(&arena, &buffer, buffer.len);
+
+    var value: [*c]const lib.ConValue = undefined;
+    const err = lib.con_value_deserialize(&context, &arena, &value);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), err);
+
+    try testing.expectEqual(@as(u32, lib.CON_VALUE_TYPE_ARRAY), value.*.type);
+    try testing.expectEqual(3, value.*.size);
+
+    const items = value.*.as.items;
+    try testing.expectEqual(@as(u32, lib.CON_VALUE_TYPE_NUMBER), items[0].type);
+    try testing.expectEqual(1, items[0].size);
+    try testing.expectEqual('1', items[0].as.data[0]);
+
+    try testing.expectEqual(@as(u32, lib.CON_VALUE_TYPE_DICT), items[1].type);
+    try testing.expectEqual(1, items[1].size);
+    try testing.expectEqual(@as(u32, lib.CON_VALUE_TYPE_STRING), items[1].as.items[0].type);
+    try testing.expectEqual(@as(u32, lib.CON_VALUE_TYPE_STRING), items[1].as.items[1].type);
+
+    try testing.expectEqual(@as(u32, lib.CON_VALUE_TYPE_BOOL), items[2].type);
+    try testing.expectEqual(false, items[2].as.boolean);
+
+    var item: [*c]const lib.ConValue = undefined;
+    const get_err = lib.con_value_dict_get(&items[1], "a", 1, &item);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), get_err);
+    try testing.expectEqual(@intFromPtr(&items[1].as.items[1]), @intFromPtr(item));
+
+    const not_dict_err = lib.con_value_dict_get(value, "a", 1, &item);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NOT_DICT), not_dict_err);
+}
+
+test "value deserialize null" {
+    var depth: [1]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    _ = lib.con_deserialize_init_memory(&context, "1", 1, &depth, depth.len);
+
+    var buffer: [64]u8 = undefined;
+    var arena: lib.ConValueArena = undefined;
+    _ = lib.con_value_arena_init(&arena, &buffer, buffer.len);
+
+    var value: [*c]const lib.ConValue = undefined;
+
+    const err1 = lib.con_value_deserialize(null, &arena, &value);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err1);
+
+    const err2 = lib.con_value_deserialize(&context, null, &value);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err2);
+
+    const err3 = lib.con_value_deserialize(&context, &arena, null);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err3);
+}
+
+test "value deserialize errors" {
+    const Case = struct { data: []const u8, arena: usize, err: c_uint };
+    const cases = [_]Case{
+        .{ .data = "[1, 2", .arena = 256, .err = lib.CON_ERROR_READER },
+        .{ .data = "[1,]", .arena = 256, .err = lib.CON_ERROR_COMMA_TRAILING },
+        .{ .data = "{\"a\" 1}", .arena = 256, .err = lib.CON_ERROR_INVALID_JSON },
+        .{ .data = "[[[]]]", .arena = 256, .err = lib.CON_ERROR_TOO_DEEP },
+        .{ .data = "[1, 2, 3, 4, 5, 6]", .arena = 64, .err = lib.CON_ERROR_BUFFER },
+        .{ .data = "1", .arena = 0, .err = lib.CON_ERROR_BUFFER },
+    };
+
+    for (cases) |case| {
+        var depth: [2]lib.ConContainer = undefined;
+        var context: lib.ConDeserialize = undefined;
+        _ = lib.con_deserialize_init_memory(&context, case.data.ptr, case.data.len, &depth, depth.len);
+
+        var buffer: [256]u8 = undefined;
+        var arena: lib.ConValueArena = undefined;
+        _ = lib.con_value_arena_init(&arena, &buffer, case.arena);
+        arena.used = 0;
+
+        var value: [*c]const lib.ConValue = undefined;
+        const err = lib.con_value_deserialize(&context, &arena, &value);
+        try testing.expectEqual(case.err, err);
+        try testing.expectEqual(0, arena.used);
+    }
+}
+
+test "value serialize" {
+    const data = "{\"k\": [null, true, 1e2, \"\\t\"]}";
+    const expected = "{\"k\":[null,true,1e2,\"\\t\"]}";
+
+    var depth: [2]lib.ConContainer = undefined;
+    var context: lib.ConDeserialize = undefined;
+    _ = lib.con_deserialize_init_memory(&context, data, data.len, &depth, depth.len);
+
+    var buffer: [256]u8 = undefined;
+    var arena: lib.ConValueArena = undefined;
+    _ = lib.con_value_arena_init(&arena, &buffer, buffer.len);
+
+    var value: [*c]const lib.ConValue = undefined;
+    const err = lib.con_value_deserialize(&context, &arena, &value);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), err);
+
+    var out: [expected.len]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    _ = lib.gci_writer_string_init(&writer, &out, out.len);
+
+    var serialize_depth: [2]lib.ConContainer = undefined;
+    var serialize: lib.ConSerialize = undefined;
+    const init_err = lib.con_serialize_init(&serialize, lib.gci_writer_string_interface(&writer), &serialize_depth, serialize_depth.len);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), init_err);
+
+    const serialize_err = lib.con_value_serialize(&serialize, value);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_OK), serialize_err);
+    try testing.expectEqualStrings(expected, &out);
+}
+
+test "value serialize invalid" {
+    var out: [16]u8 = undefined;
+    var writer: lib.GciWriterString = undefined;
+    _ = lib.gci_writer_string_init(&writer, &out, out.len);
+
+    var depth: [1]lib.ConContainer = undefined;
+    var serialize: lib.ConSerialize = undefined;
+    _ = lib.con_serialize_init(&serialize, lib.gci_writer_string_interface(&writer), &depth, depth.len);
+
+    var items = [_]lib.ConValue{
+        .{ .type = lib.CON_VALUE_TYPE_NULL, .size = 0, .as = .{ .data = null } },
+        .{ .type = lib.CON_VALUE_TYPE_NULL, .size = 0, .as = .{ .data = null } },
+    };
+    const dict = lib.ConValue{ .type = lib.CON_VALUE_TYPE_DICT, .size = 1, .as = .{ .items = &items } };
+
+    const err1 = lib.con_value_serialize(&serialize, &dict);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_TYPE), err1);
+
+    const err2 = lib.con_value_serialize(&serialize, null);
+    try testing.expectEqual(@as(c_uint, lib.CON_ERROR_NULL), err2);
+}
@@ -0,0 +1,350 @@
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+#include "con_value.h"
+
+// Values in the arena are aligned like a member of this struct.
+struct ConValueAlign {
+    char c;
+    struct ConValue value;
+};
+
+#define CON_VALUE_ALIGN offsetof(struct ConValueAlign, value)
+
+// State while a document is read. Values of unfinished containers are kept on
+// a stack growing down from the end of the arena while everything else is
+// allocated from its start.
+struct ConValueBuilder {
+    struct ConValueArena *arena;
+    size_t top;     // offset of the end of the stack
+    size_t length;  // values on the stack
+    bool full;
+};
+
+static inline size_t con_value_free(struct ConValueBuilder const *builder);
+static inline struct ConValue *con_value_stack(struct ConValueBuilder const *builder, size_t position);
+static inline enum ConError con_value_push(struct ConValueBuilder *builder, struct ConValue value);
+static inline struct ConValue *con_value_alloc(struct ConValueBuilder *builder, size_t count);
+static size_t con_value_write(void const *void_context, char const *data, size_t data_size);
+static enum ConError con_value_text(struct ConValueBuilder *builder, struct ConDeserialize *context, enum ConDeserializeType type, struct ConValue *value);
+static enum ConError con_value_close(struct ConValueBuilder *builder, struct ConValue **open);
+static enum ConError con_value_build(struct ConDeserialize *context, struct ConValueArena *arena, struct ConValue const **value);
+
+enum ConError con_value_arena_init(struct ConValueArena *arena, char *data, size_t size) {
+    if (arena == NULL) { return CON_ERROR_NULL; }
+    if (data == NULL && size > 0) { return CON_ERROR_NULL; }
+
+    arena->data = data;
+    arena->size = size;
+    arena->used = 0;
+
+    return CON_ERROR_OK;
+}
+
+enum ConError con_value_arena_reset(struct ConValueArena *arena) {
+    if (arena == NULL) { return CON_ERROR_NULL; }
+
+    arena->used = 0;
+    return CON_ERROR_OK;
+}
+
+enum ConError con_value_deserialize(
+    struct ConDeserialize *context,
+    struct ConValueArena *arena,
+    struct ConValue const **value
+) {
+    if (context == NULL) { return CON_ERROR_NULL; }
+    if (arena == NULL) { return CON_ERROR_NULL; }
+    if (value == NULL) { return CON_ERROR_NULL; }
+
+    size_t used = arena->used;
+    enum ConError err = con_value_build(context, arena, value);
+    if (err) {
+        arena->used = used;
+    }
+
+    return err;
+}
+
+enum ConError con_value_serialize(struct ConSerialize *context, struct ConValue const *value) {
+    if (context == NULL) { return CON_ERROR_NULL; }
+    if (value == NULL) { return CON_ERROR_NULL; }
+
+    switch (value->type) {
+        case CON_VALUE_TYPE_NULL: {
+            return con_serialize_null(context);
+        }
+        case CON_VALUE_TYPE_BOOL: {
+            return con_serialize_bool(context, value->as.boolean);
+        }
+        case CON_VALUE_TYPE_NUMBER: {
+            return con_serialize_number(context, value->as.data, value->size);
+        }
+        case CON_VALUE_TYPE_STRING: {
+            return con_serialize_string_escape(context, value->as.data, value->size);
+        }
+        case CON_VALUE_TYPE_ARRAY: {
+            enum ConError open_err = con_serialize_array_open(context);
+            if (open_err) { return open_err; }
+
+            for (size_t i = 0; i < value->size; i++) {
+                enum ConError err = con_value_serialize(context, &value->as.items[i]);
+                if (err) { return err; }
+            }
+
+            return con_serialize_array_close(context);
+        }
+        case CON_VALUE_TYPE_DICT: {
+            enum ConError open_err = con_serialize_dict_open(context);
+            if (open_err) { return open_err; }
+
+            for (size_t i = 0; i < value->size; i++) {
+                struct ConValue const *key = &value->as.items[2 * i];
+                if (key->type != CON_VALUE_TYPE_STRING) { return CON_ERROR_TYPE; }
+
+                enum ConError key_err = con_serialize_dict_key_escape(context, key->as.data, key->size);
+                if (key_err) { return key_err; }
+
+                enum ConError err = con_value_serialize(context, &value->as.items[2 * i + 1]);
+                if (err) { return err; }
+            }
+
+            return con_serialize_dict_close(context);
+        }
+        default: {
+            return CON_ERROR_TYPE;
+        }
+    }
+}
+
+enum ConError con_value_dict_get(
+    struct ConValue const *value,
+    char const *key,
+    size_t key_size,
+    struct ConValue const **item
+) {
+    if (value == NULL) { return CON_ERROR_NULL; }
+    if (key == NULL) { return CON_ERROR_NULL; }
+    if (item == NULL) { return CON_ERROR_NULL; }
+    if (value->type != CON_VALUE_TYPE_DICT) { return CON_ERROR_NOT_DICT; }
+
+    for (size_t i = 0; i < value->size; i++) {
+        struct ConValue const *current = &value->as.items[2 * i];
+        if (current->size == key_size && memcmp(current->as.data, key, key_size) == 0) {
+            *item = current + 1;
+            return CON_ERROR_OK;
+        }
+    }
+
+    *item = NULL;
+    return CON_ERROR_OK;
+}
+
+static inline size_t con_value_free(struct ConValueBuilder const *builder) {
+    assert(builder != NULL);
+
+    size_t stack = builder->length * sizeof(struct ConValue);
+    if (builder->top < builder->arena->used + stack) { return 0; }
+    return builder->top - stack - builder->arena->used;
+}
+
+static inline struct ConValue *con_value_stack(struct ConValueBuilder const *builder, size_t position) {
+    assert(builder != NULL);
+    assert(position < builder->length);
+
+    struct ConValue *top = (struct ConValue*) (builder->arena->data + builder->top);
+    return top - 1 - position;
+}
+
+static inline enum ConError con_value_push(struct ConValueBuilder *builder, struct ConValue value) {
+    assert(builder != NULL);
+    if (con_value_free(builder) < sizeof(struct ConValue)) { return CON_ERROR_BUFFER; }
+
+    builder->length += 1;
+    *con_value_stack(builder, builder->length - 1) = value;
+    return CON_ERROR_OK;
+}
+
+static inline struct ConValue *con_value_alloc(struct ConValueBuilder *builder, size_t count) {
+    assert(builder != NULL);
+
+    struct ConValueArena *arena = builder->arena;
+    size_t misaligned = (size_t) (((uintptr_t) arena->data + arena->used) % CON_VALUE_ALIGN);
+    size_t padding = (CON_VALUE_ALIGN - misaligned) % CON_VALUE_ALIGN;
+    size_t available = con_value_free(builder);
+    if (available < padding || (available - padding) / sizeof(struct ConValue) < count) { return NULL; }
+
+    struct ConValue *values = (struct ConValue*) (arena->data + arena->used + padding);
+    arena->used += padding + count * sizeof(struct ConValue);
+    return values;
+}
+
+// Appends decoded strings and copied numbers to the arena.
+static size_t con_value_write(void const *void_context, char const *data, size_t data_size) {
+    struct ConValueBuilder *builder = (struct ConValueBuilder*) void_context;
+    assert(builder != NULL);
+
+    if (data_size == 0) { return 0; }
+    if (con_value_free(builder) < data_size) {
+        builder->full = true;
+        return 0;
+    }
+
+    struct ConValueArena *arena = builder->arena;
+    memcpy(arena->data + arena->used, data, data_size);
+    arena->used += data_size;
+    return data_size;
+}
+
+static enum ConError con_value_text(struct ConValueBuilder *builder, struct ConDeserialize *context, enum ConDeserializeType type, struct ConValue *value) {
+    assert(builder != NULL);
+    assert(context != NULL);
+    assert(value != NULL);
+
+    struct ConValueArena *arena = builder->arena;
+    struct GciInterfaceWriter writer = { .context = builder, .write = con_value_write };
+    size_t start = arena->used;
+
+    char const *data;
+    size_t data_size;
+    enum ConError err;
+    if (type == CON_DESERIALIZE_TYPE_NUMBER) {
+        err = con_deserialize_number_view(context, &data, &data_size, writer);
+    } else if (type == CON_DESERIALIZE_TYPE_STRING) {
+        err = con_deserialize_string_view(context, &data, &data_size, writer);
+    } else {
+        assert(type == CON_DESERIALIZE_TYPE_DICT_KEY);
+        err = con_deserialize_dict_key_view(context, &data, &data_size, writer);
+    }
+
+    if (err == CON_ERROR_WRITER && builder->full) { return CON_ERROR_BUFFER; }
+    if (err) { return err; }
+
+    if (data == NULL) {
+        data = arena->data + start;
+        data_size = arena->used - start;
+    }
+    if (data_size > UINT32_MAX) { return CON_ERROR_OVERFLOW; }
+
+    *value = (struct ConValue) {
+        .type = type == CON_DESERIALIZE_TYPE_NUMBER ? CON_VALUE_TYPE_NUMBER : CON_VALUE_TYPE_STRING,
+        .size = (uint32_t) data_size,
+        .as.data = data,
+    };
+    return CON_ERROR_OK;
+}
+
+// Moves the contents of the innermost open container from the stack to a
+// span in the arena, the container then continues as an element of its
+// parent.
+static enum ConError con_value_close(struct ConValueBuilder *builder, struct ConValue **open) {
+    assert(builder != NULL);
+    assert(open != NULL && *open != NULL);
+
+    struct ConValue *container = *open;
+    size_t position = (size_t) (con_value_stack(builder, 0) - container);
+    size_t count = builder->length - position - 1;
+
+    size_t size = container->type == CON_VALUE_TYPE_DICT ? count / 2 : count;
+    if (size > UINT32_MAX) { return CON_ERROR_OVERFLOW; }
+
+    struct ConValue *items = NULL;
+    if (count > 0) {
+        items = con_value_alloc(builder, count);
+        if (items == NULL) { return CON_ERROR_BUFFER; }
+
+        for (size_t i = 0; i < count; i++) {
+            items[i] = *con_value_stack(builder, position + 1 + i);
+        }
+    }
+
+    builder->length = position + 1;
+    *open = container->as.items;
+
+    container->size = (uint32_t) size;
+    container->as.items = items;
+    return CON_ERROR_OK;
+}
+
+static enum ConError con_value_build(struct ConDeserialize *context, struct ConValueArena *arena, struct ConValue const **value) {
+    assert(context != NULL);
+    assert(arena != NULL);
+    assert(value != NULL);
+
+    size_t misaligned = (size_t) (((uintptr_t) arena->data + arena->size) % CON_VALUE_ALIGN);
+    struct ConValueBuilder builder = {
+        .arena = arena,
+        .top = arena->size >= misaligned ? arena->size - misaligned : 0,
+        .length = 0,
+        .full = false,
+    };
+
+    // Open containers are linked through `as.items` until they are closed.
+    struct ConValue *open = NULL;
+    do {
+        enum ConDeserializeType type;
+        enum ConError next_err = con_deserialize_next(context, &type);
+        if (next_err) { return next_err; }
+
+        struct ConValue item = { .type = CON_VALUE_TYPE_NULL, .size = 0, .as.items = NULL };
+        switch (type) {
+            case CON_DESERIALIZE_TYPE_ARRAY_OPEN:
+            case CON_DESERIALIZE_TYPE_DICT_OPEN: {
+                bool array = type == CON_DESERIALIZE_TYPE_ARRAY_OPEN;
+                enum ConError open_err = array ? con_deserialize_array_open(context) : con_deserialize_dict_open(context);
+                if (open_err) { return open_err; }
+
+                item.type = array ? CON_VALUE_TYPE_ARRAY : CON_VALUE_TYPE_DICT;
+                item.as.items = open;
+
+                enum ConError push_err = con_value_push(&builder, item);
+                if (push_err) { return push_err; }
+
+                open = con_value_stack(&builder, builder.length - 1);
+                continue;
+            }
+            case CON_DESERIALIZE_TYPE_ARRAY_CLOSE:
+            case CON_DESERIALIZE_TYPE_DICT_CLOSE: {
+                bool array = type == CON_DESERIALIZE_TYPE_ARRAY_CLOSE;
+                enum ConError close_err = array ? con_deserialize_array_close(context) : con_deserialize_dict_close(context);
+                if (close_err) { return close_err; }
+
+                enum ConError err = con_value_close(&builder, &open);
+                if (err) { return err; }
+                continue;
+            }
+            case CON_DESERIALIZE_TYPE_DICT_KEY:
+            case CON_DESERIALIZE_TYPE_STRING:
+            case CON_DESERIALIZE_TYPE_NUMBER: {
+                enum ConError err = con_value_text(&builder, context, type, &item);
+                if (err) { return err; }
+                break;
+            }
+            case CON_DESERIALIZE_TYPE_BOOL: {
+                item.type = CON_VALUE_TYPE_BOOL;
+                enum ConError err = con_deserialize_bool(context, &item.as.boolean);
+                if (err) { return err; }
+                break;
+            }
+            case CON_DESERIALIZE_TYPE_NULL: {
+                enum ConError err = con_deserialize_null(context);
+                if (err) { return err; }
+                break;
+            }
+            default: {
+                return CON_ERROR_INVALID_JSON;
+            }
+        }
+
+        enum ConError push_err = con_value_push(&builder, item);
+        if (push_err) { return push_err; }
+    } while (open != NULL);
+
+    assert(builder.length == 1);
+    struct ConValue *root = con_value_alloc(&builder, 1);
+    if (root == NULL) { return CON_ERROR_BUFFER; }
+
+    *root = *con_value_stack(&builder, 0);
+    *value = root;
+    return CON_ERROR_OK;
+}
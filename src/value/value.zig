@@ -0,0 +1,255 @@
+const std = @import("std");
+const gci = @import("gci");
+const zcon = @import("../con.zig");
+const internal = @import("../internal.zig");
+const lib = internal.lib;
+const Serialize = @import("../serialize/serialize.zig").Serialize;
+const Deserialize = @import("../deserialize/deserialize.zig").Deserialize;
+
+pub const Arena = struct {
+    inner: lib.ConValueArena,
+
+    pub fn init(buffer: []u8) !Arena {
+        var arena = Arena{ .inner = undefined };
+        const err = lib.con_value_arena_init(&arena.inner, buffer.ptr, buffer.len);
+
+        try internal.enumToError(err);
+        return arena;
+    }
+
+    pub fn reset(self: *Arena) void {
+        const err = lib.con_value_arena_reset(&self.inner);
+        std.debug.assert(err == lib.CON_ERROR_OK);
+    }
+
+    pub fn used(self: *const Arena) usize {
+        return self.inner.used;
+    }
+};
+
+pub const Value = struct {
+    inner: *const lib.ConValue,
+
+    pub const Type = enum(u32) {
+        null = lib.CON_VALUE_TYPE_NULL,
+        bool = lib.CON_VALUE_TYPE_BOOL,
+        number = lib.CON_VALUE_TYPE_NUMBER,
+        string = lib.CON_VALUE_TYPE_STRING,
+        array = lib.CON_VALUE_TYPE_ARRAY,
+        dict = lib.CON_VALUE_TYPE_DICT,
+    };
+
+    // Reads the next element of `context` into `arena`, see
+    // `con_value_deserialize`.
+    pub fn deserialize(context: *Deserialize, arena: *Arena) !Value {
+        var root: [*c]const lib.ConValue = undefined;
+        const err = lib.con_value_deserialize(&context.inner, &arena.inner, &root);
+
+        try internal.enumToError(err);
+        return .{ .inner = root };
+    }
+
+    pub fn serialize(self: Value, context: *Serialize) !void {
+        const err = lib.con_value_serialize(&context.inner, self.inner);
+        return internal.enumToError(err);
+    }
+
+    pub fn getType(self: Value) Type {
+        return @enumFromInt(self.inner.type);
+    }
+
+    pub fn boolean(self: Value) bool {
+        std.debug.assert(self.getType() == .bool);
+        return self.inner.as.boolean;
+    }
+
+    // Bytes of a string or number.
+    pub fn text(self: Value) []const u8 {
+        std.debug.assert(self.getType() == .string or self.getType() == .number);
+        if (self.inner.size == 0) {
+            return "";
+        }
+        return self.inner.as.data[0..self.inner.size];
+    }
+
+    pub fn int(self: Value) !i64 {
+        std.debug.assert(self.getType() == .number);
+        return std.fmt.parseInt(i64, self.text(), 10);
+    }
+
+    pub fn float(self: Value) !f64 {
+        std.debug.assert(self.getType() == .number);
+        return std.fmt.parseFloat(f64, self.text());
+    }
+
+    // Elements of an array or entries of a dict.
+    pub fn len(self: Value) usize {
+        std.debug.assert(self.getType() == .array or self.getType() == .dict);
+        return self.inner.size;
+    }
+
+    pub fn at(self: Value, position: usize) Value {
+        std.debug.assert(self.getType() == .array);
+        std.debug.assert(position < self.inner.size);
+        return .{ .inner = &self.inner.as.items[position] };
+    }
+
+    pub fn key(self: Value, position: usize) []const u8 {
+        std.debug.assert(self.getType() == .dict);
+        std.debug.assert(position < self.inner.size);
+        return (Value{ .inner = &self.inner.as.items[2 * position] }).text();
+    }
+
+    pub fn value(self: Value, position: usize) Value {
+        std.debug.assert(self.getType() == .dict);
+        std.debug.assert(position < self.inner.size);
+        return .{ .inner = &self.inner.as.items[2 * position + 1] };
+    }
+
+    pub fn get(self: Value, name: []const u8) !?Value {
+        var item: [*c]const lib.ConValue = undefined;
+        const err = lib.con_value_dict_get(self.inner, name.ptr, name.len, &item);
+        try internal.enumToError(err);
+
+        if (item == null) {
+            return null;
+        }
+        return .{ .inner = item };
+    }
+};
+
+const testing = std.testing;
+
+test "value size" {
+    if (@sizeOf(usize) == 8) {
+        try testing.expectEqual(16, @sizeOf(lib.ConValue));
+    }
+}
+
+test "value deserialize" {
+    const data = "{\"id\": 12, \"name\": \"a\\nb\", \"tags\": [true, null, -1.5], \"empty\": {}}";
+
+    var depth: [2]zcon.Container = undefined;
+    var context = try Deserialize.initMemory(data, &depth);
+
+    var buffer: [512]u8 = undefined;
+    var arena = try Arena.init(&buffer);
+    const root = try Value.deserialize(&context, &arena);
+
+    try testing.expectEqual(.dict, root.getType());
+    try testing.expectEqual(4, root.len());
+    try testing.expectEqualStrings("id", root.key(0));
+    try testing.expectEqual(12, try root.value(0).int());
+
+    const name = (try root.get("name")).?;
+    try testing.expectEqualStrings("a\nb", name.text());
+
+    const tags = (try root.get("tags")).?;
+    try testing.expectEqual(3, tags.len());
+    try testing.expectEqual(true, tags.at(0).boolean());
+    try testing.expectEqual(.null, tags.at(1).getType());
+    try testing.expectEqual(-1.5, try tags.at(2).float());
+
+    const empty = (try root.get("empty")).?;
+    try testing.expectEqual(0, empty.len());
+
+    try testing.expectEqual(null, try root.get("missing"));
+    try testing.expectError(error.NotDict, tags.get("id"));
+}
+
+test "value views input" {
+    const data = "[\"plain\", \"esc\\u0061ped\", 10]";
+
+    var depth: [1]zcon.Container = undefined;
+    var context = try Deserialize.initMemory(data, &depth);
+
+    var buffer: [256]u8 = undefined;
+    var arena = try Arena.init(&buffer);
+    const root = try Value.deserialize(&context, &arena);
+
+    const plain = root.at(0).text();
+    try testing.expectEqual(@intFromPtr(data) + 2, @intFromPtr(plain.ptr));
+
+    const escaped = root.at(1).text();
+    try testing.expectEqualStrings("escaped", escaped);
+    try testing.expect(@intFromPtr(escaped.ptr) >= @intFromPtr(&buffer));
+    try testing.expect(@intFromPtr(escaped.ptr) < @intFromPtr(&buffer) + buffer.len);
+
+    try testing.expectEqualStrings("10", root.at(2).text());
+}
+
+test "value buffered reader" {
+    const data = "{\"a\": [\"long string value\", 123456789], \"b\": false}";
+    var reader = try gci.ReaderString.init(data);
+
+    var depth: [2]zcon.Container = undefined;
+    var read_buffer: [4]u8 = undefined;
+    var context = try Deserialize.initBuffer(reader.interface(), &depth, &read_buffer);
+
+    var buffer: [512]u8 = undefined;
+    var arena = try Arena.init(&buffer);
+    const root = try Value.deserialize(&context, &arena);
+
+    const a = (try root.get("a")).?;
+    try testing.expectEqualStrings("long string value", a.at(0).text());
+    try testing.expectEqual(123456789, try a.at(1).int());
+    try testing.expectEqual(false, (try root.get("b")).?.boolean());
+}
+
+test "value arena full" {
+    const data = "[[1, 2, 3], [4, 5, 6], \"string\"]";
+
+    var depth: [2]zcon.Container = undefined;
+    var context = try Deserialize.initMemory(data, &depth);
+
+    var buffer: [64]u8 = undefined;
+    var arena = try Arena.init(&buffer);
+
+    const err = Value.deserialize(&context, &arena);
+    try testing.expectError(error.Buffer, err);
+    try testing.expectEqual(0, arena.used());
+}
+
+test "value arena reset" {
+    const data = "[1, 2] [3]";
+
+    var depth: [1]zcon.Container = undefined;
+    var context = try Deserialize.initMemory(data, &depth);
+
+    var buffer: [128]u8 = undefined;
+    var arena = try Arena.init(&buffer);
+
+    _ = try context.record();
+    const first = try Value.deserialize(&context, &arena);
+    try testing.expectEqual(2, first.len());
+    try testing.expect(arena.used() > 0);
+
+    arena.reset();
+    try testing.expectEqual(0, arena.used());
+
+    _ = try context.record();
+    const second = try Value.deserialize(&context, &arena);
+    try testing.expectEqual(1, second.len());
+    try testing.expectEqual(3, try second.at(0).int());
+}
+
+test "value serialize" {
+    const data = "{\"a\": [1, 2.5e3, \"q\\\"\\u00e9\"], \"b\\n\": {\"c\": null, \"d\": true}, \"e\": []}";
+    const expected = "{\"a\":[1,2.5e3,\"q\\\"\xc3\xa9\"],\"b\\n\":{\"c\":null,\"d\":true},\"e\":[]}";
+
+    var depth: [3]zcon.Container = undefined;
+    var context = try Deserialize.initMemory(data, &depth);
+
+    var buffer: [512]u8 = undefined;
+    var arena = try Arena.init(&buffer);
+    const root = try Value.deserialize(&context, &arena);
+
+    var out: [expected.len]u8 = undefined;
+    var writer = try gci.WriterString.init(&out);
+    var serialize_depth: [3]zcon.Container = undefined;
+    var serialize = try Serialize.init(writer.interface(), &serialize_depth);
+    defer serialize.deinit();
+
+    try root.serialize(&serialize);
+    try testing.expectEqualStrings(expected, &out);
+}